@@ -0,0 +1,59 @@
+"""
+	Flattens the curve fixtures (gbp.json, usd.json) into the quote file read by
+	the FlexYCF curve benchmark (see lloyds_curve/CurveBenchmark.h), one line per
+	instrument with the columns Curve, Currency, Index, Instrument Type,
+	Description and Quote.
+
+	The currency of a curve and the type of its swaps come from the convention of
+	its index in static.json: the swaps of an overnight index are OIS.
+	Futures prices are quoted in percent, FlexYCF takes them as fractions, and
+	the ticker of a future is turned into the IMM expiry FlexYCF reads (EDZ0 -> DEC20).
+
+	usage: python benchmark_quotes.py [output file]
+"""
+import csv
+import json
+import os
+import re
+import sys
+
+directory = os.path.dirname(os.path.abspath(__file__))
+
+fixtures = ('gbp.json', 'usd.json')
+curve_indices = {'sonia': 'SONIA', 'ois': 'FEDFUND', '3m': 'LIBOR'}
+
+contract_months = {'F': 'JAN', 'G': 'FEB', 'H': 'MAR', 'J': 'APR', 'K': 'MAY', 'M': 'JUN', 'N': 'JUL', 'Q': 'AUG', 'U': 'SEP', 'V': 'OCT', 'X': 'NOV', 'Z': 'DEC'}
+ticker_regex = r'(\w{2})(\w)(\d{1,2})$'
+first_decade = 2020
+
+def load(name):
+	with open(os.path.join(directory, name)) as f:
+		return json.load(f)
+
+def imm_expiry(ticker):
+	m = re.match(ticker_regex, ticker)
+	if m is None or m.group(2) not in contract_months:
+		raise ValueError('invalid futures ticker {}'.format(ticker))
+	year = int(m.group(3))
+	if year < 10:
+		year += first_decade % 100
+	return '{}{:02d}'.format(contract_months[m.group(2)], year % 100)
+
+def quotes():
+	conventions = {convention['Index']: convention for convention in load('static.json')}
+	for fixture in fixtures:
+		for curve, instruments in load(fixture).items():
+			convention = conventions[curve_indices[curve]]
+			swap_type = 'OIS' if convention['Type'] == 'O' else 'Swaps'
+			for future in instruments.get('Future', []):
+				yield curve, convention['Currency'], convention['Index'], 'Futures', imm_expiry(future['Ticker']), future['Price'] / 100.
+			for swap in instruments.get('Swap', []):
+				yield curve, convention['Currency'], convention['Index'], swap_type, swap['Tenor'], swap['Rate']
+
+if __name__ == '__main__':
+	pathname = sys.argv[1] if len(sys.argv) > 1 else os.path.join(directory, 'benchmark_quotes.csv')
+	with open(pathname, 'w', newline='') as f:
+		writer = csv.writer(f)
+		writer.writerow(('Curve', 'Currency', 'Index', 'Instrument Type', 'Description', 'Quote'))
+		for quote in quotes():
+			writer.writerow(quote[:-1] + ('{:.8g}'.format(quote[-1]),))
@@ -0,0 +1,122 @@
+/*****************************************************************************
+
+	AdjointTape
+
+	Implementation of the AdjointTape
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "AdjointTape.h"
+#include "BuildProfile.h"
+
+#include <boost/thread/tss.hpp>
+
+using namespace std;
+
+namespace FlexYCF
+{
+	namespace
+	{
+		//	The tapes are released by their scopes, not by the threads
+		void doNotDelete(AdjointTape*)
+		{
+		}
+
+		boost::thread_specific_ptr<AdjointTape> s_currentTape(&doNotDelete);
+	}
+
+	BuildSwitch AdjointTape::s_enabled = BUILD_SWITCH_INIT(false);
+
+	AdjointTape::AdjointTape()
+	{
+	}
+
+	void AdjointTape::setEnabled(const bool enabled)
+	{
+		s_enabled.set(enabled);
+	}
+
+	AdjointTape* AdjointTape::current()
+	{
+		return s_currentTape.get();
+	}
+
+	void AdjointTape::record(Node& node,
+							 BaseModel const& baseModel,
+							 const double adjoint,
+							 GradientIterator gradientBegin,
+							 GradientIterator gradientEnd)
+	{
+		//	A node usually receives its adjoints in the same model and relative
+		//	to the same gradient, in which case they are summed in one entry
+		const EntryPositions::iterator lastEntry(m_lastEntries.find(&node));
+		if(lastEntry != m_lastEntries.end())
+		{
+			Entry& entry(m_entries[lastEntry->second]);
+			if(entry.baseModel == &baseModel && entry.gradientBegin == gradientBegin && entry.gradientEnd == gradientEnd)
+			{
+				entry.adjoint += adjoint;
+				return;
+			}
+		}
+
+		const Entry entry = { &node, &baseModel, adjoint, gradientBegin, gradientEnd };
+		m_lastEntries[&node] = m_entries.size();
+		m_entries.push_back(entry);
+	}
+
+	void AdjointTape::sweep()
+	{
+		//	Propagating the adjoints of a level records those of the components
+		//	of its nodes on the next level. As the gradient is linear in the
+		//	adjoints, a node reached on several levels is propagated once per level
+		Entries level;
+		while(!m_entries.empty())
+		{
+			level.clear();
+			level.swap(m_entries);
+			m_lastEntries.clear();
+
+			for(Entries::const_iterator entry(level.begin()); entry != level.end(); ++entry)
+			{
+				if(entry->adjoint != 0.0)
+				{
+					BuildProfile::record(BuildProfile::AdjointPropagation);
+					entry->node->propagateAdjoint(*entry->baseModel, entry->adjoint, entry->gradientBegin, entry->gradientEnd);
+				}
+			}
+		}
+	}
+
+	AdjointTape::Scope::Scope():
+		m_tape(AdjointTape::isEnabled() ? new AdjointTape : 0),
+		m_previousTape(AdjointTape::current())
+	{
+		if(m_tape)
+		{
+			s_currentTape.reset(m_tape);
+		}
+	}
+
+	AdjointTape::Scope::~Scope()
+	{
+		if(m_tape)
+		{
+			s_currentTape.reset(m_previousTape);
+			delete m_tape;
+		}
+	}
+
+	void AdjointTape::Scope::sweep()
+	{
+		if(m_tape)
+		{
+			m_tape->sweep();
+		}
+	}
+}
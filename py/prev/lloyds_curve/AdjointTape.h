@@ -0,0 +1,146 @@
+/*****************************************************************************
+
+    AdjointTape
+
+	Records the adjoints pushed to the cached instrument components during
+	the gradient computation of an instrument and propagates them in one
+	reverse sweep.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_ADJOINTTAPE_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_ADJOINTTAPE_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+#include "BuildSwitch.h"
+#include "Gradient.h"
+
+#include <boost/functional/hash.hpp>
+#if ( _MSC_VER >= 1500 )					// we will be on Boost_1_38 with VS 2008
+	#include "Boost\unordered_map.hpp"
+#else
+	#include "Boost_1_38_Hack\unordered_map.hpp"
+#endif
+
+
+namespace FlexYCF
+{
+	class BaseModel;
+
+	/// AdjointTape implements the reverse mode of the gradient computation
+	/// of the calibration instruments.
+	///
+	/// The multiplier an instrument passes to accumulateGradient is the
+	/// adjoint of its value, which each instrument and component multiplies
+	/// by its local derivatives before passing it down to its components.
+	/// While a tape is bound to the calling thread, the cached instrument
+	/// components do not compute their gradient relative to all the unknowns:
+	/// they record their adjoint on the tape instead. The sweep then sums the
+	/// adjoints each component received from all its parents and propagates
+	/// them once per component, level by level, down to the model curves,
+	/// which accumulate into the gradient the few unknowns they depend on.
+	///
+	/// The cost of a gradient is then proportional to the number of distinct
+	/// components of the instrument, instead of the number of components
+	/// times the number of unknowns.
+	///
+	/// The adjoint mode is off by default. A tape holds the adjoints of one
+	/// output, so the jacobian takes one sweep per residual, and a component
+	/// shared by several instruments is propagated once per instrument. Off,
+	/// the cached components compute their sparse gradient once per update
+	/// and the instruments sharing them accumulate it in O(#non-zeros), which
+	/// is cheaper for the calibration jacobian, where the instruments share
+	/// most of their components (the discount factors and forward rates of
+	/// common dates). The adjoint mode pays off for the instruments with
+	/// many components of their own, e.g. long OIS legs.
+	///
+	/// Note: the gradients relative to the variables of one curve type do not
+	/// use the tape. They are only computed by the breakout initialization,
+	/// once per curve type, and the cached components do not cache them either.
+	class AdjointTape: private DevCore::NonCopyable
+	{
+	public:
+		/// Interface of the components that propagate their adjoint on a sweep
+		class Node
+		{
+		public:
+			/// Accumulates the gradient of the node, multiplied by its adjoint
+			virtual void propagateAdjoint(BaseModel const& baseModel,
+										  double adjoint,
+										  GradientIterator gradientBegin,
+										  GradientIterator gradientEnd) = 0;
+
+		protected:
+			~Node()
+			{
+			}
+		};
+
+		/// Switches the adjoint mode on or off, off by default (see BuildSwitch).
+		/// The gradients being computed finish in their mode
+		static void setEnabled(const bool enabled);
+
+		static bool isEnabled()
+		{
+			return s_enabled.isOn();
+		}
+
+		/// Returns the tape bound to the calling thread, 0 if none
+		static AdjointTape* current();
+
+		/// Adds the specified adjoint to the one of the node, in the
+		/// specified model and relative to the specified gradient
+		void record(Node& node,
+					BaseModel const& baseModel,
+					const double adjoint,
+					GradientIterator gradientBegin,
+					GradientIterator gradientEnd);
+
+		//	Nested class to bind a new tape to the calling thread at a given
+		//	scope level, ensuring the previous tape is bound back when the
+		//	instance of this class goes out of scope.
+		//	Note: this is robust in presence of exceptions.
+		struct Scope: private DevCore::NonCopyable
+		{
+		public:
+			Scope();
+			~Scope();
+
+			/// Propagates the adjoints recorded on the tape of the scope,
+			/// leaving it empty. Does nothing if the adjoint mode is off.
+			void sweep();
+
+		private:
+			AdjointTape* const	m_tape;			// 0 if the adjoint mode is off
+			AdjointTape* const	m_previousTape;
+		};
+
+	private:
+		struct Entry
+		{
+			Node*				node;
+			BaseModel const*	baseModel;
+			double				adjoint;
+			GradientIterator	gradientBegin;
+			GradientIterator	gradientEnd;
+		};
+		typedef std::vector<Entry> Entries;
+		typedef boost::unordered_map<const Node*, size_t> EntryPositions;
+
+		AdjointTape();
+
+		void sweep();
+
+		static BuildSwitch						s_enabled;
+
+		Entries							m_entries;		// of the level being recorded
+		EntryPositions					m_lastEntries;	// position of the last entry of each node of the level
+	};  //  AdjointTape
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_ADJOINTTAPE_H_INCLUDED
@@ -12,7 +12,10 @@
 #pragma once
 
 //  This header includes all the instrument components arguments headers
-//  and typedefine the concrete instrument components and their caches from them
+//  and typedefine the concrete instrument components and their caches from them.
+//  The caches of the components whose arguments define a 'Hash' functor use the
+//  CacheStorageHash storage policy, the others the CacheStorageMap one. Replacing
+//  CacheStorageHash by CacheStorageMap below falls back to the map storage.
 
 #include "InstrumentComponentCache.h"
 #include "GenericInstrumentComponent.h"
@@ -36,29 +39,47 @@
 namespace FlexYCF
 {
     //  Discount Factor
-    typedef InstrumentComponentCache<DiscountFactorArguments>           DiscountFactorCache;
+    typedef InstrumentComponentCache< DiscountFactorArguments,
+                                      DiscountFactor,
+                                      std::tr1::shared_ptr,
+                                      CacheStorageHash >                DiscountFactorCache;
     DECLARE_SMART_PTRS( DiscountFactorCache )
     
     //  Tenor Discount Factor
-    typedef InstrumentComponentCache<TenorDiscountFactorArguments>      TenorDiscountFactorCache;
+    typedef InstrumentComponentCache< TenorDiscountFactorArguments,
+                                      TenorDiscountFactor,
+                                      std::tr1::shared_ptr,
+                                      CacheStorageHash >                TenorDiscountFactorCache;
     DECLARE_SMART_PTRS( TenorDiscountFactorCache )
   
     //  Forward Rate
-    typedef InstrumentComponentCache<ForwardRateArguments, ForwardRate> ForwardRateCache;
+    typedef InstrumentComponentCache< ForwardRateArguments,
+                                      ForwardRate,
+                                      std::tr1::shared_ptr,
+                                      CacheStorageHash >                ForwardRateCache;
     DECLARE_SMART_PTRS( ForwardRateCache )
     
     //  Discounted Forward Rate
-    typedef InstrumentComponentCache< DiscountedForwardRateArguments, DiscountedForwardRate > DiscountedForwardRateCache;
+    typedef InstrumentComponentCache< DiscountedForwardRateArguments,
+                                      DiscountedForwardRate,
+                                      std::tr1::shared_ptr,
+                                      CacheStorageHash >                DiscountedForwardRateCache;
     DECLARE_SMART_PTRS( DiscountedForwardRateCache )
     
     // Fixed Leg
-    typedef InstrumentComponentCache<FixedLegArguments, FixedLeg>       FixedLegCache;
+    typedef InstrumentComponentCache< FixedLegArguments,
+                                      FixedLeg,
+                                      std::tr1::shared_ptr,
+                                      CacheStorageHash >                FixedLegCache;
     DECLARE_SMART_PTRS( FixedLegCache )
 
     //  Floating Leg
     //typedef GenericInstrumentComponent<FloatingLegArguments>    FloatingLeg;
     DECLARE_SMART_PTRS( FloatingLeg )
-    typedef InstrumentComponentCache<FloatingLegArguments, FloatingLeg> FloatingLegCache;
+    typedef InstrumentComponentCache< FloatingLegArguments,
+                                      FloatingLeg,
+                                      std::tr1::shared_ptr,
+                                      CacheStorageHash >                FloatingLegCache;
     DECLARE_SMART_PTRS( FloatingLegCache )
 
     //  Fixed Cash Flow
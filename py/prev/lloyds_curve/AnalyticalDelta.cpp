@@ -46,7 +46,27 @@ using namespace IDeA;
 
 namespace FlexYCF
 {
-
+	namespace
+	{
+		//	Returns the (row) vector of the gradients of the rep flows, those relative to
+		//	the unknowns of the dependent model first, times the inverse of the jacobian:
+		//	this is one solve against the transpose of its cached factorization
+		LTQC::VectorDouble repFlowsTimesInverseJacobian(const JacobianFactorization& jacobianFactorization,
+														const Gradient& modRepFlows,
+														const Gradient& modRepFlowsChildModel = Gradient())
+		{
+			LTQC::VectorDouble repFlows(modRepFlows.size() + modRepFlowsChildModel.size(), 0.0);
+			for(size_t i(0); i < modRepFlows.size(); ++i)
+			{
+				repFlows[i] = modRepFlows[i];
+			}
+			for(size_t i(0); i < modRepFlowsChildModel.size(); ++i)
+			{
+				repFlows[modRepFlows.size() + i] = modRepFlowsChildModel[i];
+			}
+			return jacobianFactorization.solveTransposed(repFlows);
+		}
+	}
 
 	
 	//	Calculates delta using funding and index replicating flows according the following formula:
@@ -95,12 +115,13 @@ namespace FlexYCF
 			model.accumulateTenorDiscountFactorGradient(iter->getTime(), iter->getTenor(), iter->getValue(), modRepFlows.begin(), modRepFlows.end());
 		}
 
-		//	2. Get the last jacobian of the model and invert it
+		//	2. Get the factorization of the last jacobian of the model
+		//	and solve the row vector from 1. against it
 		//	Important Note: we assume the jacobian is made of lines
 		//	that represent the gradient of the *PV* of the instrument
 		//	relative to the model unknowns
-		LTQC::Matrix invJac(model.getJacobian());
-		invJac.inverse();
+		const JacobianFactorization& jacobianFactorization(model.getJacobianFactorization());
+		const LTQC::VectorDouble repFlowsSensitivities(repFlowsTimesInverseJacobian(jacobianFactorization, modRepFlows));
 
 		// Get all input instruments:
 		CachedDerivInstruments fullInstruments(model.getFullPrecomputedInstruments());
@@ -126,10 +147,7 @@ namespace FlexYCF
 
 			if(fullInstruments[k]->wasPlaced())
 			{
-				for(size_t i(0); i < invJac.getNumRows(); ++i)
-				{
-					deltaValue += (modRepFlows[i] * invJac(i,j));
-				}
+				deltaValue = repFlowsSensitivities[j];
 
 				// Multiply by rate derivative and scale to get delta value:
 				deltaValue *= - oneBasisPoint() * fullInstruments[k]->getRateDerivative();
@@ -143,7 +161,7 @@ namespace FlexYCF
 		}
 
 		//	Post-checking:
-		if(invJac.getNumCols() != j)
+		if(jacobianFactorization.size() != j)
 		{
 			LTQC_THROW( LTQC::ModelQCException, "The number of partial instruments is not equal to the number of columns of the inverse Jacobian of the solved problem" );
 		}
@@ -164,10 +182,9 @@ namespace FlexYCF
 				LT_THROW_ERROR("Attempting to calculate algorithmic risk on a model that does not support Jacobian");
         }
 
-		LTQC::Matrix invJac(childModel.getFullJacobian());
-		invJac.inverse();
+		const JacobianFactorization& jacobianFactorization(childModel.getFullJacobianFactorization());
 		
-		Gradient modRepFlows( invJac.getNumRows() - childModel.getLeastSquaresResiduals()->size(), 0.0);
+		Gradient modRepFlows( jacobianFactorization.size() - childModel.getLeastSquaresResiduals()->size(), 0.0);
 		Gradient modRepFlowsChildModel(childModel.getLeastSquaresResiduals()->size(), 0.0);
 		
 		for(IDeA::ReplicatingFlows<IDeA::Funding>::const_iterator iter(fundingRepFlows.begin()); iter != fundingRepFlows.end(); ++iter)
@@ -199,6 +216,7 @@ namespace FlexYCF
 		deltaVector.resize(fullInstruments.size());
 		
 		
+		const LTQC::VectorDouble repFlowsSensitivities(repFlowsTimesInverseJacobian(jacobianFactorization, modRepFlows, modRepFlowsChildModel));
 		size_t j = childModel.jacobianOffset(modelAssetDomain);;					// running index on partial instruments
 		double deltaValue(0.0), hedgeRatio(0.0);
 
@@ -209,17 +227,7 @@ namespace FlexYCF
 
 			if(fullInstruments[k]->wasPlaced())
 			{
-				for(size_t i(0); i < invJac.getNumRows(); ++i)
-				{
-					if( i < modRepFlows.size() )
-					{
-						deltaValue += (modRepFlows[i] * invJac(i,j));
-					}
-					else
-					{
-						deltaValue += (modRepFlowsChildModel[i - modRepFlows.size()] * invJac(i,j));
-					}
-				}
+				deltaValue = repFlowsSensitivities[j];
 
 				// Multiply by rate derivative and scale to get delta value:
 				deltaValue = -  fx * deltaValue * oneBasisPoint() * fullInstruments[k]->getRateDerivative();
@@ -249,10 +257,9 @@ namespace FlexYCF
 				LT_THROW_ERROR("Attempting to calculate algorithmic risk on a model that does not support Jacobian");
         }
 
-		LTQC::Matrix invJac(childModel.getFullJacobian());
-		invJac.inverse();
+		const JacobianFactorization& jacobianFactorization(childModel.getFullJacobianFactorization());
 		
-		Gradient modRepFlows( invJac.getNumRows() - childModel.getLeastSquaresResiduals()->size(), 0.0);
+		Gradient modRepFlows( jacobianFactorization.size() - childModel.getLeastSquaresResiduals()->size(), 0.0);
 		Gradient modRepFlowsChildModel(childModel.getLeastSquaresResiduals()->size(), 0.0);
 		
 		for(IDeA::ReplicatingFlows<IDeA::Funding>::const_iterator iter(fundingRepFlows.begin()); iter != fundingRepFlows.end(); ++iter)
@@ -284,6 +291,7 @@ namespace FlexYCF
 		deltaVector.resize(fullInstruments.size());
 		
 		
+		const LTQC::VectorDouble repFlowsSensitivities(repFlowsTimesInverseJacobian(jacobianFactorization, modRepFlows, modRepFlowsChildModel));
 		size_t j = childModel.jacobianOffset(modelAssetDomain);;					// running index on partial instruments
 		double deltaValue(0.0), hedgeRatio(0.0);
 
@@ -294,17 +302,7 @@ namespace FlexYCF
 
 			if(fullInstruments[k]->wasPlaced())
 			{
-				for(size_t i(0); i < invJac.getNumRows(); ++i)
-				{
-					if( i < modRepFlows.size() )
-					{
-						deltaValue += (modRepFlows[i] * invJac(i,j));
-					}
-					else
-					{
-						deltaValue +=  (modRepFlowsChildModel[i - modRepFlows.size()] * invJac(i,j));
-					}
-				}
+				deltaValue = repFlowsSensitivities[j];
 
 				// Multiply by rate derivative and scale to get delta value:
 				deltaValue = - fx * deltaValue * oneBasisPoint() * fullInstruments[k]->getRateDerivative();
@@ -334,10 +332,9 @@ namespace FlexYCF
 				LT_THROW_ERROR("Attempting to calculate algorithmic risk on a model that does not support Jacobian");
         }
 
-		LTQC::Matrix invJac(childChildModel.getFullJacobian());
-		invJac.inverse();
+		const JacobianFactorization& jacobianFactorization(childChildModel.getFullJacobianFactorization());
 		
-		Gradient modRepFlowsChildModel(invJac.getNumRows()  - childChildModel.getLeastSquaresResiduals()->size(), 0.0);
+		Gradient modRepFlowsChildModel(jacobianFactorization.size() - childChildModel.getLeastSquaresResiduals()->size(), 0.0);
 		Gradient modRepFlowsChildChildModel(childChildModel.getLeastSquaresResiduals()->size(), 0.0);
 
 	
@@ -369,6 +366,7 @@ namespace FlexYCF
 		deltaVector.resize(fullInstruments.size());
 		
 		
+		const LTQC::VectorDouble repFlowsSensitivities(repFlowsTimesInverseJacobian(jacobianFactorization, modRepFlowsChildModel, modRepFlowsChildChildModel));
 		size_t j = childChildModel.jacobianOffset(modelAssetDomain);					// running index on partial instruments
 		double deltaValue(0.0), hedgeRatio(0.0);
 
@@ -379,17 +377,7 @@ namespace FlexYCF
 
 			if(fullInstruments[k]->wasPlaced())
 			{
-				for(size_t i(0); i < invJac.getNumRows(); ++i)
-				{
-					if( i < modRepFlowsChildModel.size() )
-					{
-						deltaValue += (modRepFlowsChildModel[i] * invJac(i,j));
-					} 
-					else if( i >= modRepFlowsChildModel.size() )
-					{
-						deltaValue += (modRepFlowsChildChildModel[i - modRepFlowsChildModel.size()] * invJac(i,j));
-					}
-				}
+				deltaValue = repFlowsSensitivities[j];
 
 				// Multiply by rate derivative and scale to get delta value:
 				deltaValue = - fx * deltaValue * oneBasisPoint() * fullInstruments[k]->getRateDerivative();
@@ -423,12 +411,13 @@ namespace FlexYCF
 			model.accumulateDiscountFactorGradient(iter->getTime(), iter->getValue(), modRepFlows.begin(), modRepFlows.end());
 		}
 
-        //	2. Get the last jacobian of the model and invert it
+        //	2. Get the factorization of the last jacobian of the model
+		//	and solve the row vector from 1. against it
 		//	Important Note: we assume the jacobian is made of lines
 		//	that represent the gradient of the *PV* of the instrument
 		//	relative to the model unknowns
-		LTQC::Matrix invJac(model.getJacobian());
-		invJac.inverse();
+		const JacobianFactorization& jacobianFactorization(model.getJacobianFactorization());
+		const LTQC::VectorDouble repFlowsSensitivities(repFlowsTimesInverseJacobian(jacobianFactorization, modRepFlows));
 
         // Get all input instruments:
 		CachedDerivInstruments fullInstruments(model.getFullPrecomputedInstruments());
@@ -454,10 +443,7 @@ namespace FlexYCF
 
 			if(fullInstruments[k]->wasPlaced())
 			{
-				for(size_t i(0); i < invJac.getNumRows(); ++i)
-				{
-					deltaValue += (modRepFlows[i] * invJac(i,j));
-				}
+				deltaValue = repFlowsSensitivities[j];
 
 				// Multiply by rate derivative and scale to get delta value:
 				deltaValue *= - oneBasisPoint() * fullInstruments[k]->getRateDerivative();
@@ -471,7 +457,7 @@ namespace FlexYCF
 		}
 
 		//	Post-checking:
-		if(invJac.getNumCols() != j)
+		if(jacobianFactorization.size() != j)
 		{
 			LTQC_THROW( LTQC::ModelQCException, "The number of partial instruments is not equal to the number of columns of the inverse Jacobian of the solved problem" );
 		}
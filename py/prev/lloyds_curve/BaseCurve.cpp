@@ -151,6 +151,30 @@ namespace FlexYCF
         return m_rightExtrapolationMethod->evaluate(x);
     }
 
+    // As the abscissas are sorted, the left-extrapolated, interpolated and
+    // right-extrapolated ones are three consecutive ranges
+    void BaseCurve::evaluateSorted(std::vector<double>::const_iterator xBegin,
+                                   std::vector<double>::const_iterator xEnd,
+                                   std::vector<double>::iterator yBegin) const
+    {
+        const std::vector<double>::const_iterator interpolationBegin(std::upper_bound(xBegin, xEnd, m_knotPoints->xMin()));
+        const std::vector<double>::const_iterator interpolationEnd(std::lower_bound(interpolationBegin, xEnd, m_knotPoints->xMax()));
+
+        for(; xBegin != interpolationBegin; ++xBegin, ++yBegin)
+        {   //  Left extrapolation
+            *yBegin = m_leftExtrapolationMethod->evaluate(*xBegin);
+        }
+
+        //  Interpolation
+        m_interpolationCurve->interpolateSorted(interpolationBegin, interpolationEnd, yBegin);
+        yBegin += std::distance(interpolationBegin, interpolationEnd);
+
+        for(xBegin = interpolationEnd; xBegin != xEnd; ++xBegin, ++yBegin)
+        {   //  Right extrapolation
+            *yBegin = m_rightExtrapolationMethod->evaluate(*xBegin);
+        }
+    }
+
     /// Computes the gradient of the curve function at 
     /// x relative to its unknowns
     void BaseCurve::accumulateGradient(const double x, 
@@ -265,10 +289,7 @@ namespace FlexYCF
 	}
 
 	void BaseCurve::assignCurveInternalData(knot_points_container::const_iterator it) {
-		for (size_t i = 0; i < m_knotPoints->size(); ++i) {
-			(*m_knotPoints)[i].x = (*it)[i].first;
-			(*m_knotPoints)[i].y = (*it)[i].second;
-		}
+		m_knotPoints->setXsAndYs(*it);
 	}
 
     void BaseCurve::getUnfixedKnotPoints(std::list<double>& points) const
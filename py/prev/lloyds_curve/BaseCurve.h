@@ -57,6 +57,11 @@ namespace FlexYCF
         /// Evaluates the value of the curve function at x
         virtual double evaluate(const double x) const;
 
+        /// Evaluates the value of the curve function at the sorted abscissas
+        virtual void evaluateSorted(std::vector<double>::const_iterator xBegin,
+                                    std::vector<double>::const_iterator xEnd,
+                                    std::vector<double>::iterator yBegin) const;
+
         virtual void accumulateGradient(const double x, 
                                         double multiplier,
                                         GradientIterator gradientBegin,
@@ -18,6 +18,7 @@
 #include "CurveFormulation.h"
 #include "FlexYCFCloneLookup.h"
 #include "SpineDataCache.h"
+#include "BuildProfile.h"
 
 // #include "UtilsEnums.h"
 #include "FactoryEnvelopeH.h"
@@ -113,6 +114,9 @@ namespace FlexYCF
         m_valueDate(original.m_valueDate), 
         m_knotPointPlacement(original.m_knotPointPlacement),
         m_jacobian(original.m_jacobian),
+        m_sparseJacobian(original.m_sparseJacobian),
+        m_jacobianFactorization(original.m_jacobianFactorization),
+        m_fullJacobianFactorization(original.m_fullJacobianFactorization),
         m_dependentMarketData(original.m_dependentMarketData),
 		m_dependencies(original.m_dependencies),
         m_isJacobianSupported(original.m_isJacobianSupported),
@@ -137,7 +141,96 @@ namespace FlexYCF
 		USE(index)
 		return getTenorDiscountFactor(flowTime,tenor);
 	}
-  
+
+	namespace
+	{
+		//	Evaluates the model at the flow times sorted in ascending order,
+		//	so that its curves can be merge-scanned against their knots,
+		//	and writes the values back in the order of the flow times
+		template<class SortedEvaluation>
+		void evaluateAtFlowTimes(const vector<double>& flowTimes,
+								 vector<double>& values,
+								 const SortedEvaluation& sortedEvaluation)
+		{
+			values.resize(flowTimes.size());
+			if(is_sorted(flowTimes.begin(), flowTimes.end()))
+			{
+				sortedEvaluation(flowTimes.begin(), flowTimes.end(), values.begin());
+				return;
+			}
+
+			vector<double> sortedFlowTimes(flowTimes);
+			sort(sortedFlowTimes.begin(), sortedFlowTimes.end());
+			vector<double> sortedValues(sortedFlowTimes.size());
+			sortedEvaluation(sortedFlowTimes.begin(), sortedFlowTimes.end(), sortedValues.begin());
+
+			for(size_t k(0); k < flowTimes.size(); ++k)
+			{
+				values[k] = sortedValues[lower_bound(sortedFlowTimes.begin(), sortedFlowTimes.end(), flowTimes[k]) - sortedFlowTimes.begin()];
+			}
+		}
+	}
+
+	void BaseModel::getDiscountFactors(const vector<double>& flowTimes, vector<double>& discountFactors) const
+	{
+		evaluateAtFlowTimes(flowTimes, discountFactors,
+			[this](vector<double>::const_iterator begin, vector<double>::const_iterator end, vector<double>::iterator out)
+			{
+				getSortedDiscountFactors(begin, end, out);
+			});
+	}
+
+	void BaseModel::getTenorDiscountFactors(const vector<double>& flowTimes, const double tenor, vector<double>& discountFactors) const
+	{
+		evaluateAtFlowTimes(flowTimes, discountFactors,
+			[this, tenor](vector<double>::const_iterator begin, vector<double>::const_iterator end, vector<double>::iterator out)
+			{
+				getSortedTenorDiscountFactors(begin, end, tenor, out);
+			});
+	}
+
+	void BaseModel::getTenorDiscountFactors(const vector<double>& flowTimes, const double tenor, const LTQC::Currency& ccy, const LT::Str& index, vector<double>& discountFactors) const
+	{
+		evaluateAtFlowTimes(flowTimes, discountFactors,
+			[this, tenor, &ccy, &index](vector<double>::const_iterator begin, vector<double>::const_iterator end, vector<double>::iterator out)
+			{
+				getSortedTenorDiscountFactors(begin, end, tenor, ccy, index, out);
+			});
+	}
+
+	void BaseModel::getSortedDiscountFactors(vector<double>::const_iterator flowTimesBegin,
+											 vector<double>::const_iterator flowTimesEnd,
+											 vector<double>::iterator discountFactorsBegin) const
+	{
+		for(; flowTimesBegin != flowTimesEnd; ++flowTimesBegin, ++discountFactorsBegin)
+		{
+			*discountFactorsBegin = getDiscountFactor(*flowTimesBegin);
+		}
+	}
+
+	void BaseModel::getSortedTenorDiscountFactors(vector<double>::const_iterator flowTimesBegin,
+												  vector<double>::const_iterator flowTimesEnd,
+												  const double tenor,
+												  vector<double>::iterator discountFactorsBegin) const
+	{
+		for(; flowTimesBegin != flowTimesEnd; ++flowTimesBegin, ++discountFactorsBegin)
+		{
+			*discountFactorsBegin = getTenorDiscountFactor(*flowTimesBegin, tenor);
+		}
+	}
+
+	void BaseModel::getSortedTenorDiscountFactors(vector<double>::const_iterator flowTimesBegin,
+												  vector<double>::const_iterator flowTimesEnd,
+												  const double tenor,
+												  const LTQC::Currency& ccy,
+												  const LT::Str& index,
+												  vector<double>::iterator discountFactorsBegin) const
+	{
+		USE(ccy)
+		USE(index)
+		getSortedTenorDiscountFactors(flowTimesBegin, flowTimesEnd, tenor, discountFactorsBegin);
+	}
+
 	bool BaseModel::hasDependentIRMarketData(const LT::Str& currency, const LT::Str& index) const
     {
         bool exists = false;
@@ -227,6 +320,22 @@ namespace FlexYCF
         return fxRate;
     }
 
+	void BaseModel::setJacobian(const SparseJacobian& jacobian, const size_t numberOfUnknowns)
+	{
+		//	The dense jacobian is still returned by getJacobian, the
+		//	factorization is computed from the rows (see getJacobianFactorization)
+		LTQC::Matrix denseJacobian(jacobian.size(), numberOfUnknowns, 0.0);
+		for(size_t i(0); i < jacobian.size(); ++i)
+		{
+			for(SparseGradient::const_iterator iter(jacobian[i].begin()); iter != jacobian[i].end(); ++iter)
+			{
+				denseJacobian(i, iter->first) = iter->second;
+			}
+		}
+		setJacobian(denseJacobian);
+		m_sparseJacobian = jacobian;
+	}
+
     void BaseModel::prepareForSolve()
     {
         // here we iterate through the list of dependent market data and create the dependent models
@@ -294,6 +403,8 @@ namespace FlexYCF
 
     bool BaseModel::placeKnotPoints(CalibrationInstruments& instruments)
     {
+		const BuildProfile::ScopedTimer placementTimer(BuildProfile::KnotPlacement);
+
 		m_fullInstruments = instruments;
 		
 		//	Make sure the full instruments are marked as not placed: 
@@ -450,6 +561,10 @@ namespace FlexYCF
 	void BaseModel::restoreModelSpineData(SpineDataCachePtr& sdp) {
 		sdp->model_->assignSpineInternalData(sdp);
 		sdp->model_->update();
+		if(!sdp->jacobian_.empty())
+		{
+			sdp->model_->setJacobian(sdp->jacobian_);
+		}
 		for (auto p = sdp->childern_.begin(); p != sdp->childern_.end(); ++p)
 			BaseModel::restoreModelSpineData(*p);
 	}
@@ -25,6 +25,7 @@
 #include "CurveType.h"
 #include "StructureHolder.h"
 #include "ICloneLookup.h"
+#include "JacobianFactorization.h"
 
 //	LTQuantCore
 #include "Matrix.h"
@@ -75,7 +76,53 @@ namespace FlexYCF
                                                const double tenor) const = 0;
 
 		virtual double getTenorDiscountFactor(double flowTime, double tenor, const LTQC::Currency& ccy, const LT::Str& index) const;
-		
+
+		/// Computes the discount factors at the specified flow times,
+		/// in any order, with one call to the model instead of one per flow
+		void getDiscountFactors(const std::vector<double>& flowTimes,
+								std::vector<double>& discountFactors) const;
+
+		/// Computes the Tenor discount factors at the specified
+		/// flow times, in any order
+		void getTenorDiscountFactors(const std::vector<double>& flowTimes,
+									 const double tenor,
+									 std::vector<double>& discountFactors) const;
+
+		/// Computes the Tenor discount factors of the specified currency
+		/// and index at the specified flow times, in any order
+		void getTenorDiscountFactors(const std::vector<double>& flowTimes,
+									 const double tenor,
+									 const LTQC::Currency& ccy,
+									 const LT::Str& index,
+									 std::vector<double>& discountFactors) const;
+
+		/// Computes the discount factors at the flow times from flowTimesBegin
+		/// to flowTimesEnd, sorted in ascending order, to discountFactorsBegin
+		/// Note: the default implementation calls getDiscountFactor for each
+		/// flow time. Models override it to evaluate their curves in one pass.
+		virtual void getSortedDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+											  std::vector<double>::const_iterator flowTimesEnd,
+											  std::vector<double>::iterator discountFactorsBegin) const;
+
+		/// Computes the Tenor discount factors at the flow times, sorted in
+		/// ascending order, from flowTimesBegin to flowTimesEnd
+		virtual void getSortedTenorDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+												   std::vector<double>::const_iterator flowTimesEnd,
+												   const double tenor,
+												   std::vector<double>::iterator discountFactorsBegin) const;
+
+		/// Computes the Tenor discount factors of the specified currency and
+		/// index at the flow times, sorted in ascending order, from
+		/// flowTimesBegin to flowTimesEnd
+		/// Note: as getTenorDiscountFactor, the default implementation
+		/// ignores the currency and the index
+		virtual void getSortedTenorDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+												   std::vector<double>::const_iterator flowTimesEnd,
+												   const double tenor,
+												   const LTQC::Currency& ccy,
+												   const LT::Str& index,
+												   std::vector<double>::iterator discountFactorsBegin) const;
+
 		virtual double getSpreadDiscountFactor(const double flowTime) const 
 		{
 			USE(flowTime)
@@ -272,22 +319,45 @@ namespace FlexYCF
 			return m_jacobian;
 		}
 
+		//	Returns the LU factorization of the jacobian of the calibrated model,
+		//	computed once per jacobian: prefer solving against it to inverting
+		inline const JacobianFactorization& getJacobianFactorization() const
+		{
+            if( !m_jacobianFactorization )
+            {
+                m_jacobianFactorization = JacobianFactorizationConstPtr(m_sparseJacobian.empty() ? new JacobianFactorization(m_jacobian)
+                                                                                                  : new JacobianFactorization(m_sparseJacobian, m_jacobian.getNumCols()));
+            }
+            return *m_jacobianFactorization;
+		}
+
+		inline const JacobianFactorization& getFullJacobianFactorization() const
+		{
+            if( !m_fullJacobianFactorization )
+            {
+                m_fullJacobianFactorization = JacobianFactorizationConstPtr(new JacobianFactorization(getFullJacobian()));
+            }
+            return *m_fullJacobianFactorization;
+		}
+
+		//	Deprecated: solve against getJacobianFactorization() instead.
+		//	Returns the inverse of the jacobian, computed from its factorization
+		//	on the first call per jacobian
         inline const LTQC::Matrix& getInverseJacobian() const
 		{
             if( m_inverseJacobian.empty() )
             {
-                m_inverseJacobian = m_jacobian;
-                m_inverseJacobian.inverse();
+                m_inverseJacobian = getJacobianFactorization().getInverse();
             }
             return m_inverseJacobian;
 		}
-		 
+
+		//	Deprecated: solve against getFullJacobianFactorization() instead
 		inline const LTQC::Matrix& getInverseFullJacobian() const
 		{
             if( m_inverseFullJacobian.empty() )
             {
-                m_inverseFullJacobian = getFullJacobian();
-                m_inverseFullJacobian.inverse();
+                m_inverseFullJacobian = getFullJacobianFactorization().getInverse();
             }
             return m_inverseFullJacobian;
 		}
@@ -296,10 +366,18 @@ namespace FlexYCF
 		inline void setJacobian(const LTQC::Matrix& jacobian)
 		{
 			m_jacobian = jacobian;
-            m_inverseJacobian.clear();
+			m_sparseJacobian.clear();
+			m_inverseJacobian.clear();
 			m_inverseFullJacobian.clear();
+			m_jacobianFactorization.reset();
+			m_fullJacobianFactorization.reset();
 		}
 
+		//	Set the jacobian of the calibrated model from its sparse rows,
+		//	each relative to the specified number of unknowns. The rows
+		//	are kept to factorize the jacobian over their envelope
+		void setJacobian(const SparseJacobian& jacobian, const size_t numberOfUnknowns);
+
 		//	Returns the structure curve
 		inline const StructureSurface& getStructure() const
 		{
@@ -414,6 +492,32 @@ namespace FlexYCF
 		void  setPrimaryAssetDomainIndex(IDeA::AssetDomainConstPtr ad)   const { m_primaryAssetDomainIndex = ad; }
 
 		virtual void setCalibrated() {}
+
+		//	Switches the model in or out of calibration: some models cache
+		//	values while the solver runs only. See CalibrationScope
+		virtual void setCalibrating(const bool /* calibrating */) {}
+
+		//	Nested class to switch the model to calibration at a given scope
+		//	level, switching it back when the instance of this class goes out
+		//	of scope.
+		//	Note: this is robust in presence of exceptions.
+		class CalibrationScope: private DevCore::NonCopyable
+		{
+		public:
+			explicit CalibrationScope(BaseModel& model):
+				m_model(model)
+			{
+				m_model.setCalibrating(true);
+			}
+
+			~CalibrationScope()
+			{
+				m_model.setCalibrating(false);
+			}
+
+		private:
+			BaseModel& m_model;
+		};
 		
     protected:
 		BaseModel();
@@ -450,10 +554,13 @@ namespace FlexYCF
         BaseKnotPointPlacementPtr	m_knotPointPlacement;
         LeastSquaresResidualsPtr	m_leastSquaresResiduals;
 		LTQC::Matrix				m_jacobian;
+		SparseJacobian				m_sparseJacobian;	// rows of m_jacobian, if set from them
         
         // computed only if requested
-        mutable LTQC::Matrix		m_inverseJacobian;
+		mutable JacobianFactorizationConstPtr	m_jacobianFactorization;
+		mutable LTQC::Matrix		m_inverseJacobian;
 		mutable LTQC::Matrix		m_inverseFullJacobian;
+		mutable JacobianFactorizationConstPtr	m_fullJacobianFactorization;
 
         //	Note: m_fullInstruments contains ALL instruments,
 		//	even those NOT used in calibration
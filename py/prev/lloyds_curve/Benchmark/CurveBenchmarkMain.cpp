@@ -0,0 +1,81 @@
+/*****************************************************************************
+
+	CurveBenchmarkMain
+
+	Entry point of the FlexYCF curve benchmark, built as its own executable
+	linked with the FlexYCF library.
+
+	usage: CurveBenchmark <quote file> <build date yyyy-mm-dd> <result file> [number of runs]
+
+	The curves of the quote file (see py/benchmark_quotes.py) are created,
+	built and refreshed on the build date, without any IDeA service or
+	prebuilt curve, and the timings are saved in the CSV result file
+	(see PerformanceTracker::saveCsv).
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "CurveBenchmark.h"
+#include "CsvUtils.h"
+#include "PerformanceTracker.h"
+
+//	LTQuantLib
+#include "Pricers/PriceSupplier.h"
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+
+namespace
+{
+	//	The serial number of 1 January 1970, LT::date counting the days from 30 December 1899
+	const long s_epochSerialNumber(25569);
+
+	bool parseDate(const char* const text, LT::date& date)
+	{
+		int year, month, day;
+		char trailing;
+		if(sscanf(text, "%d-%d-%d%c", &year, &month, &day, &trailing) != 3
+			|| year < 1900 || month < 1 || month > 12 || day < 1 || day > 31)
+		{
+			return false;
+		}
+		date = LT::date(s_epochSerialNumber + FlexYCF::getDaysSinceEpoch(year, month, day));
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	LT::date buildDate;
+	const long numberOfRuns(argc > 4 ? atol(argv[4]) : 10);
+	if(argc < 4 || argc > 5 || !parseDate(argv[2], buildDate) || numberOfRuns <= 0)
+	{
+		cerr << "usage: " << argv[0] << " <quote file> <build date yyyy-mm-dd> <result file> [number of runs]" << endl;
+		return 2;
+	}
+
+	try
+	{
+		const LTQuant::PriceSupplierPtr priceSupplier(new LTQuant::PriceSupplier(buildDate));
+
+		FlexYCF::CurveBenchmark curveBenchmark(static_cast<size_t>(numberOfRuns));
+		curveBenchmark.loadCurves(argv[1], priceSupplier);
+
+		FlexYCF::PerformanceTracker performanceTracker;
+		curveBenchmark.run(performanceTracker);
+		performanceTracker.saveCsv(argv[3]);
+	}
+	catch(const exception& e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+	return 0;
+}
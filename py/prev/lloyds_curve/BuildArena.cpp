@@ -0,0 +1,194 @@
+/*****************************************************************************
+
+	BuildArena
+
+	Implementation of the BuildArena
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "BuildArena.h"
+
+#include <boost/thread/tss.hpp>
+#include <boost/thread/once.hpp>
+
+using namespace std;
+
+namespace FlexYCF
+{
+	namespace
+	{
+		//	The arenas are released by their scopes, not by the threads
+		void doNotDelete(BuildArena*)
+		{
+		}
+
+		boost::thread_specific_ptr<BuildArena> s_currentArena(&doNotDelete);
+
+		//	Prefixes each allocation with the arena it comes from, 0 for the heap.
+		//	Its size is a multiple of the strictest fundamental alignment, so the
+		//	objects allocated after it are aligned
+		union Header
+		{
+			BuildArena*	arena;
+			double		alignment;
+			long double	longAlignment;
+		};
+
+		//	Whether the allocations are prefixed with a header, fixed by the first
+		//	allocation or switching on of the arenas, as deallocate relies on it
+		boost::once_flag	s_layoutFlag = BOOST_ONCE_INIT;
+		bool				s_hasHeaders(false);
+
+		void fixLayout()
+		{
+			s_hasHeaders = BuildArena::isEnabled();
+		}
+	}
+
+	BuildSwitch BuildArena::s_enabled = BUILD_SWITCH_INIT(false);
+
+	BuildArena::BuildArena(const size_t blockSize):
+		m_blockSize(blockSize),
+		m_next(0),
+		m_end(0),
+		m_reservedBytes(0),
+		m_references(1)
+	{
+	}
+
+	BuildArena::~BuildArena()
+	{
+		for(vector<char*>::const_iterator iter(m_blocks.begin()); iter != m_blocks.end(); ++iter)
+		{
+			delete [] *iter;
+		}
+	}
+
+	void BuildArena::setEnabled(const bool enabled)
+	{
+		s_enabled.set(enabled);
+		if(enabled)
+		{
+			boost::call_once(s_layoutFlag, &fixLayout);
+			if(!s_hasHeaders)
+			{
+				s_enabled.set(false);
+				LT_THROW_ERROR("The build arenas must be enabled before the first instrument is created");
+			}
+		}
+	}
+
+	BuildArena* BuildArena::current()
+	{
+		return s_currentArena.get();
+	}
+
+	void* BuildArena::allocate(const size_t size)
+	{
+		boost::call_once(s_layoutFlag, &fixLayout);
+		if(!s_hasHeaders)
+		{
+			return ::operator new(size);
+		}
+
+		BuildArena* const arena(current());
+		Header* header;
+
+		if(arena)
+		{
+			header = static_cast<Header*>(arena->allocateFromBlocks(sizeof(Header) + size));
+			++arena->m_references;
+		}
+		else
+		{
+			header = static_cast<Header*>(::operator new(sizeof(Header) + size));
+		}
+
+		header->arena = arena;
+		return header + 1;
+	}
+
+	void BuildArena::deallocate(void* const pointer)
+	{
+		if(!s_hasHeaders)
+		{
+			::operator delete(pointer);
+		}
+		else if(pointer)
+		{
+			Header* const header(static_cast<Header*>(pointer) - 1);
+			if(header->arena)
+			{
+				header->arena->release();
+			}
+			else
+			{
+				::operator delete(header);
+			}
+		}
+	}
+
+	void* BuildArena::allocateFromBlocks(const size_t size)
+	{
+		const size_t alignedSize((size + sizeof(Header) - 1) / sizeof(Header) * sizeof(Header));
+
+		if(alignedSize > static_cast<size_t>(m_end - m_next))
+		{
+			//	Large allocations get a block of their own, so that
+			//	the rest of the current block is not wasted
+			if(4 * alignedSize > m_blockSize)
+			{
+				m_blocks.push_back(new char[alignedSize]);
+				m_reservedBytes += alignedSize;
+				return m_blocks.back();
+			}
+
+			m_blocks.push_back(new char[m_blockSize]);
+			m_reservedBytes += m_blockSize;
+			m_next = m_blocks.back();
+			m_end = m_next + m_blockSize;
+		}
+
+		void* const memory(m_next);
+		m_next += alignedSize;
+		return memory;
+	}
+
+	void BuildArena::release()
+	{
+		if(--m_references == 0)
+		{
+			delete this;
+		}
+	}
+
+	BuildArena::Scope::Scope():
+		m_arena(BuildArena::isEnabled() && !BuildArena::current() ? new BuildArena : 0)
+	{
+		if(m_arena)
+		{
+			s_currentArena.reset(m_arena);
+		}
+	}
+
+	BuildArena::Scope::~Scope()
+	{
+		if(m_arena)
+		{
+			s_currentArena.reset(0);
+
+			//	Only the owner's reference is left if the objects died with the scope
+			const long liveAllocations(static_cast<long>(m_arena->m_references) - 1);
+			if(liveAllocations > 0)
+			{
+				LT_LOG << liveAllocations << " objects outlive their build arena of " << m_arena->getReservedBytes() << " bytes" << endl;
+			}
+			m_arena->release();
+		}
+	}
+}
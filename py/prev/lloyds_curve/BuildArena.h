@@ -0,0 +1,114 @@
+/*****************************************************************************
+
+    BuildArena
+
+	Monotonic arena the instruments and instrument components of a curve
+	refresh are allocated from.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_BUILDARENA_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_BUILDARENA_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+#include "BuildSwitch.h"
+
+#include <boost/detail/atomic_count.hpp>
+
+
+namespace FlexYCF
+{
+	/// BuildArena is a monotonic allocator: memory is carved out of large
+	/// blocks by moving a pointer, deallocating an object does not free
+	/// its memory and all the blocks are freed at once when the arena is
+	/// released and the last object allocated from it is deallocated.
+	///
+	/// The calibration instruments and the instrument components define
+	/// their operator new and delete in terms of allocate and deallocate
+	/// below, so that all the ones created while an arena is bound to the
+	/// calling thread (see BuildArena::Scope) are allocated from it, and
+	/// all the others from the heap.
+	///
+	/// As a single live object keeps all the blocks of its arena, an arena
+	/// must only be bound where all the objects created die with the scope:
+	/// the refreshes from the solver bind one around the instruments they
+	/// reload, whose components are all dropped by finishCalibInstruments.
+	/// The first build does not, its instruments outlive it.
+	///
+	/// The allocations made while the arenas are switched off carry no header.
+	/// As deallocate must know whether they do, the arenas can only be switched
+	/// on before the first allocation, and the allocations keep their headers
+	/// if they are switched off afterwards.
+	///
+	/// Note: an arena must only be bound to one thread at a time, but the
+	/// objects allocated from it can be deallocated from any thread.
+	class BuildArena: private DevCore::NonCopyable
+	{
+	public:
+		/// Switches the arenas on or off, off by default (see BuildSwitch).
+		/// Throws if they are switched on after the first allocation
+		static void setEnabled(const bool enabled);
+
+		static bool isEnabled()
+		{
+			return s_enabled.isOn();
+		}
+
+		/// Returns the arena bound to the calling thread, 0 if none
+		static BuildArena* current();
+
+		/// Allocates the specified number of bytes from the arena bound
+		/// to the calling thread, or from the heap if there is none
+		static void* allocate(const size_t size);
+
+		/// Deallocates memory returned by allocate
+		static void deallocate(void* const pointer);
+
+		/// Returns the number of bytes reserved by the arena
+		size_t getReservedBytes() const
+		{
+			return m_reservedBytes;
+		}
+
+		//	Nested class to bind a new arena to the calling thread at a given
+		//	scope level, unless one is already bound, ensuring the arena is
+		//	unbound and released when the instance of this class goes out of
+		//	scope. The memory of the arena is then freed as soon as the objects
+		//	allocated from it are all deallocated, which is logged otherwise.
+		//	Note: this is robust in presence of exceptions.
+		struct Scope: private DevCore::NonCopyable
+		{
+		public:
+			Scope();
+			~Scope();
+
+		private:
+			BuildArena* const m_arena;	// 0 if the scope did not create one
+		};
+
+	private:
+		explicit BuildArena(const size_t blockSize = 64 * 1024);
+		~BuildArena();
+
+		void* allocateFromBlocks(const size_t size);
+
+		//	Releases one reference, deleting the arena on the last one
+		void release();
+
+		static BuildSwitch					s_enabled;
+
+		const size_t				m_blockSize;
+		std::vector<char*>			m_blocks;
+		char*						m_next;			// next free byte of the current block
+		char*						m_end;			// end of the current block
+		size_t						m_reservedBytes;
+		boost::detail::atomic_count	m_references;	// the owner's and one per live allocation
+	};  //  BuildArena
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_BUILDARENA_H_INCLUDED
@@ -0,0 +1,166 @@
+/*****************************************************************************
+
+	BuildProfile
+
+	Implementation of the BuildProfile
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "BuildProfile.h"
+#include "PerformanceTracker.h"
+
+#include <boost/thread/tss.hpp>
+
+using namespace std;
+
+namespace FlexYCF
+{
+	namespace
+	{
+		//	The profiles are owned by the builds, not by the threads
+		void doNotDelete(BuildProfile*)
+		{
+		}
+
+		boost::thread_specific_ptr<BuildProfile> s_currentProfile(&doNotDelete);
+
+		//	The number of builds the statistics of a tracker are over
+		const size_t s_maxValuesPerKey(1000);
+
+		void addValue(PerformanceTracker& performanceTracker, const string& key, const double value)
+		{
+			if(!performanceTracker.exists(key))
+			{
+				performanceTracker.insert(key);
+			}
+			//	Only the values of the last builds are kept, so that the tracker
+			//	of a long-lived curve does not grow with each refresh
+			vector<double>& values(performanceTracker[key]);
+			if(values.size() >= s_maxValuesPerKey)
+			{
+				values.erase(values.begin(), values.end() - (s_maxValuesPerKey - 1));
+			}
+			values.push_back(value);
+		}
+	}
+
+	BuildSwitch BuildProfile::s_enabled = BUILD_SWITCH_INIT(false);
+
+	BuildProfile::BuildProfile(const void* const owner):
+		m_owner(owner)
+	{
+		fill(m_milliseconds, m_milliseconds + NumberOfPhases, 0.0);
+		fill(m_calls, m_calls + NumberOfPhases, 0);
+		fill(m_events, m_events + NumberOfEvents, 0);
+	}
+
+	void BuildProfile::setEnabled(const bool enabled)
+	{
+		s_enabled.set(enabled);
+	}
+
+	BuildProfile* BuildProfile::current()
+	{
+		return s_currentProfile.get();
+	}
+
+	void BuildProfile::recordEvent(const Event event)
+	{
+		BuildProfile* const profile(current());
+		if(profile)
+		{
+			profile->count(event);
+		}
+	}
+
+	void BuildProfile::addTime(const Phase phase, const double milliseconds)
+	{
+		m_milliseconds[phase] += milliseconds;
+		++m_calls[phase];
+	}
+
+	void BuildProfile::addTo(PerformanceTracker& performanceTracker) const
+	{
+		for(size_t k(0); k < NumberOfPhases; ++k)
+		{
+			const string name(getName(static_cast<Phase>(k)));
+			addValue(performanceTracker, name + ".ms", m_milliseconds[k]);
+			addValue(performanceTracker, name + ".calls", static_cast<double>(m_calls[k]));
+		}
+		for(size_t k(0); k < NumberOfEvents; ++k)
+		{
+			addValue(performanceTracker, getName(static_cast<Event>(k)), static_cast<double>(m_events[k]));
+		}
+	}
+
+	ostream& BuildProfile::print(ostream& out) const
+	{
+		for(size_t k(0); k < NumberOfPhases; ++k)
+		{
+			out << getName(static_cast<Phase>(k)) << "\t" << m_milliseconds[k] << " ms\t" << m_calls[k] << " calls" << endl;
+		}
+		for(size_t k(0); k < NumberOfEvents; ++k)
+		{
+			out << getName(static_cast<Event>(k)) << "\t" << m_events[k] << endl;
+		}
+		return out;
+	}
+
+	const char* BuildProfile::getName(const Phase phase)
+	{
+		const char* name(0);
+		switch(phase)
+		{
+		case InstrumentLoading:		name = "InstrumentLoading"; break;
+		case KnotPlacement:			name = "KnotPlacement"; break;
+		case Solving:				name = "Solving"; break;
+		case ResidualEvaluation:	name = "ResidualEvaluation"; break;
+		case GradientComputation:	name = "GradientComputation"; break;
+		case ConvexityCalibration:	name = "ConvexityCalibration"; break;
+		default:					break;
+		}
+
+		if(!name)
+		{
+			LT_THROW_ERROR("Invalid build profile phase");
+		}
+		return name;
+	}
+
+	const char* BuildProfile::getName(const Event event)
+	{
+		const char* name(0);
+		switch(event)
+		{
+		case ComponentCacheHit:				name = "ComponentCacheHit"; break;
+		case ComponentCacheMiss:			name = "ComponentCacheMiss"; break;
+		case ComponentValueRecompute:		name = "ComponentValueRecompute"; break;
+		case ComponentGradientRecompute:	name = "ComponentGradientRecompute"; break;
+		case AdjointPropagation:			name = "AdjointPropagation"; break;
+		case ConvexityCalibrationReuse:		name = "ConvexityCalibrationReuse"; break;
+		default:							break;
+		}
+
+		if(!name)
+		{
+			LT_THROW_ERROR("Invalid build profile event");
+		}
+		return name;
+	}
+
+	BuildProfile::Scope::Scope(BuildProfile* const buildProfile):
+		m_previousProfile(BuildProfile::current())
+	{
+		s_currentProfile.reset(buildProfile);
+	}
+
+	BuildProfile::Scope::~Scope()
+	{
+		s_currentProfile.reset(m_previousProfile);
+	}
+}
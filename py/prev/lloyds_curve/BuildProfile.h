@@ -0,0 +1,163 @@
+/*****************************************************************************
+
+    BuildProfile
+
+	Per-phase timings and hot-path event counts of a curve build.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_BUILDPROFILE_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_BUILDPROFILE_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+#include "BuildSwitch.h"
+#include "Timer.h"
+
+
+namespace FlexYCF
+{
+	class PerformanceTracker;
+
+	/// BuildProfile accumulates the time spent in the phases of a curve
+	/// build and counts its hot-path events. At the end of the build the
+	/// profile is added to a PerformanceTracker, one value per build and
+	/// per key, so that the tracker provides statistics across the last
+	/// 1000 builds.
+	///
+	/// Profiling is off by default: each probe then costs the test of
+	/// a global flag. When on, the probes record to the profile bound
+	/// to the calling thread by the innermost BuildProfile::Scope, if any.
+	///
+	/// Note: the phases are timed inclusively, e.g. the residual
+	/// evaluations are also part of the solving time.
+	class BuildProfile
+	{
+	public:
+		enum Phase
+		{
+			InstrumentLoading,
+			KnotPlacement,
+			Solving,
+			ResidualEvaluation,
+			GradientComputation,
+			ConvexityCalibration,
+			NumberOfPhases
+		};
+
+		enum Event
+		{
+			ComponentCacheHit,
+			ComponentCacheMiss,
+			ComponentValueRecompute,
+			ComponentGradientRecompute,
+			AdjointPropagation,
+			ConvexityCalibrationReuse,
+			NumberOfEvents
+		};
+
+		explicit BuildProfile(const void* const owner = 0);
+
+		/// Switches the profiling on or off, off by default (see BuildSwitch).
+		/// The timers started before keep timing their scope
+		static void setEnabled(const bool enabled);
+
+		static bool isEnabled()
+		{
+			return s_enabled.isOn();
+		}
+
+		/// Returns the profile bound to the calling thread, 0 if none
+		static BuildProfile* current();
+
+		/// Counts one event in the profile bound to the calling thread
+		static inline void record(const Event event)
+		{
+			if(s_enabled.isOn())
+			{
+				recordEvent(event);
+			}
+		}
+
+		/// Returns the object the profile was created for
+		const void* getOwner() const
+		{
+			return m_owner;
+		}
+
+		void addTime(const Phase phase, const double milliseconds);
+
+		void count(const Event event)
+		{
+			++m_events[event];
+		}
+
+		/// Adds the timings and counts of this profile to the tracker
+		void addTo(PerformanceTracker& performanceTracker) const;
+
+		std::ostream& print(std::ostream& out) const;
+
+		static const char* getName(const Phase phase);
+		static const char* getName(const Event event);
+
+		//	Nested class to bind a profile to the calling thread at a given
+		//	scope level, ensuring the previous profile is bound back when the
+		//	instance of this class goes out of scope.
+		//	Note: this is robust in presence of exceptions.
+		struct Scope: private DevCore::NonCopyable
+		{
+		public:
+			explicit Scope(BuildProfile* const buildProfile);
+			~Scope();
+
+		private:
+			BuildProfile* const m_previousProfile;
+		};
+
+		//	Nested class adding the time spent in its scope to the specified
+		//	phase of the profile bound to the calling thread
+		class ScopedTimer: private DevCore::NonCopyable
+		{
+		public:
+			explicit ScopedTimer(const Phase phase):
+				m_profile(s_enabled.isOn() ? current() : 0),
+				m_phase(phase)
+			{
+				if(m_profile)
+				{
+					m_timer.start();
+				}
+			}
+
+			~ScopedTimer()
+			{
+				if(m_profile)
+				{
+					m_timer.stop();
+					m_profile->addTime(m_phase, m_timer.getMilliseconds());
+				}
+			}
+
+		private:
+			BuildProfile* const	m_profile;
+			const Phase			m_phase;
+			LTQuant::Timer		m_timer;
+		};
+
+	private:
+		static void recordEvent(const Event event);
+
+		static BuildSwitch			s_enabled;
+
+		const void*			m_owner;
+		double				m_milliseconds[NumberOfPhases];
+		size_t				m_calls[NumberOfPhases];
+		size_t				m_events[NumberOfEvents];
+	};  //  BuildProfile
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_BUILDPROFILE_H_INCLUDED
@@ -0,0 +1,53 @@
+/*****************************************************************************
+
+    BuildSwitch
+
+	Process-wide on/off setting of the curve builds, such as the profiling,
+	the checks of the solves and the caches.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_BUILDSWITCH_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_BUILDSWITCH_H_INCLUDED
+#pragma once
+
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+
+
+namespace FlexYCF
+{
+	/// BuildSwitch holds a setting shared by all the threads. It is written
+	/// and read atomically, so it can be switched while curves are built on
+	/// other threads: each build then sees either value, and the classes
+	/// reading it only do so where either value is consistent (e.g. once per
+	/// scope or per new object).
+	///
+	/// It is an aggregate, so that the switches defined at namespace scope
+	/// are initialized statically, before any code can read them:
+	///		BuildSwitch s_enabled = BUILD_SWITCH_INIT(true);
+	struct BuildSwitch
+	{
+		void set(const bool on)
+		{
+			boost::interprocess::detail::atomic_write32(&m_value, on ? 1 : 0);
+		}
+
+		bool isOn() const
+		{
+			return boost::interprocess::detail::atomic_read32(&m_value) != 0;
+		}
+
+		//	Public for the aggregate initialization only
+		mutable volatile boost::uint32_t m_value;
+	};  //  BuildSwitch
+
+}   //  FlexYCF
+
+/// Initializer of a BuildSwitch, on or off
+#define BUILD_SWITCH_INIT(on) { (on) ? 1u : 0u }
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_BUILDSWITCH_H_INCLUDED
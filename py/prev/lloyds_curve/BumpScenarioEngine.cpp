@@ -0,0 +1,191 @@
+/*****************************************************************************
+
+	BumpScenarioEngine
+
+	Implementation of the BumpScenarioEngine
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "BumpScenarioEngine.h"
+#include "FlexYCFZeroCurve.h"
+#include "GenericIRMarketData.h"
+#include "GlobalComponentCache.h"
+#include "InstrumentComponent.h"
+
+//	IDeA
+#include "Exception.h"
+
+#include <cmath>
+#include <sstream>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/detail/atomic_count.hpp>
+
+using namespace std;
+
+namespace FlexYCF
+{
+    using namespace LTQuant;
+
+	namespace
+	{
+		//	The state shared by the threads solving the scenarios
+		class ScenarioSchedule
+		{
+		public:
+			ScenarioSchedule(const BumpScenarios& scenarios,
+							 const vector<double>& flowTimes,
+							 LTQC::Matrix& bumpedRates):
+				m_scenarios(scenarios),
+				m_flowTimes(flowTimes),
+				m_bumpedRates(bumpedRates),
+				m_numberOfTakenScenarios(0)
+			{
+			}
+
+			//	Worker thread loop: solves the scenarios not taken yet on its own clone
+			void run(FlexYCFZeroCurve* const clone)
+			{
+				try
+				{
+					const GenericIRMarketDataPtr marketData(std::tr1::dynamic_pointer_cast<GenericIRMarketData>(clone->getMarketData()));
+					GlobalComponentCache globalComponentCache(GlobalComponentCache::createCache(marketData->getData(), marketData->getValueDate()));
+					const InstrumentComponent::GlobalCacheScope cacheScope(&globalComponentCache);
+
+					clone->prepareForScenarios(globalComponentCache);
+
+					for(size_t k(takeScenario()); k < m_scenarios.size(); k = takeScenario())
+					{
+						clone->solveScenario(m_scenarios[k]);
+						for(size_t j(0); j < m_flowTimes.size(); ++j)
+						{
+							const double flowTime(m_flowTimes[j]);
+							m_bumpedRates(k, j) = (flowTime > 0.0 ? -log(clone->getDiscountFactor2(flowTime)) / flowTime : 0.0);
+						}
+					}
+				}
+				catch(const std::exception& e)
+				{
+					addError(e.what());
+				}
+				catch(...)
+				{
+					addError("unknown error");
+				}
+			}
+
+			//	Returns the errors of the threads that could not solve their scenarios
+			const string getErrors() const
+			{
+				return m_errors.str();
+			}
+
+		private:
+			size_t takeScenario()
+			{
+				return static_cast<size_t>(++m_numberOfTakenScenarios) - 1;
+			}
+
+			void addError(const string& error)
+			{
+				boost::mutex::scoped_lock lock(m_mutex);
+				m_errors << error << endl;
+			}
+
+			const BumpScenarios&		m_scenarios;
+			const vector<double>&		m_flowTimes;
+			LTQC::Matrix&				m_bumpedRates;		// each row written by one thread only
+			boost::detail::atomic_count	m_numberOfTakenScenarios;
+			ostringstream				m_errors;
+			boost::mutex				m_mutex;
+		};
+	}
+
+	BumpScenarioEngine::BumpScenarioEngine(const size_t numberOfThreads):
+		m_numberOfThreads(numberOfThreads == 0 ? max(1u, boost::thread::hardware_concurrency()) : numberOfThreads)
+	{
+	}
+
+	LTQC::Matrix BumpScenarioEngine::computeBumpedRates(const FlexYCFZeroCurve& zeroCurve,
+														const BumpScenarios& scenarios,
+														const vector<double>& flowTimes) const
+	{
+		if(scenarios.empty() || flowTimes.empty())
+		{
+			return LTQC::Matrix();
+		}
+
+		LTQC::Matrix bumpedRates(scenarios.size(), flowTimes.size(), 0.0);
+		ScenarioSchedule schedule(scenarios, flowTimes, bumpedRates);
+
+		//	The curve is cloned by the calling thread, one clone per worker
+		const size_t numberOfThreads(min(m_numberOfThreads, scenarios.size()));
+		vector<FlexYCFZeroCurvePtr> clones(numberOfThreads);
+		for(size_t k(0); k < numberOfThreads; ++k)
+		{
+			clones[k] = std::tr1::static_pointer_cast<FlexYCFZeroCurve>(zeroCurve.clone());
+		}
+
+		//	The calling thread takes part in the solving
+		boost::thread_group threads;
+		try
+		{
+			for(size_t k(1); k < numberOfThreads; ++k)
+			{
+				threads.create_thread(boost::bind(&ScenarioSchedule::run, &schedule, clones[k].get()));
+			}
+		}
+		catch(...)
+		{
+			//	The threads already started use the schedule and the clones, on this stack
+			threads.join_all();
+			throw;
+		}
+		schedule.run(clones[0].get());
+		threads.join_all();
+
+		const string errors(schedule.getErrors());
+		if(!errors.empty())
+		{
+			LTQC_THROW(IDeA::ModelException, "The bumped scenarios could not be solved:" << endl << errors);
+		}
+		return bumpedRates;
+	}
+
+	BumpScenarios BumpScenarioEngine::createDeltaLadder(const size_t numberOfInstruments, const double shift)
+	{
+		BumpScenarios scenarios;
+		scenarios.reserve(2 * numberOfInstruments);
+		for(size_t i(0); i < numberOfInstruments; ++i)
+		{
+			scenarios.push_back(BumpScenario(1, QuoteBump(i, shift)));
+			scenarios.push_back(BumpScenario(1, QuoteBump(i, -shift)));
+		}
+		return scenarios;
+	}
+
+	BumpScenarios BumpScenarioEngine::createCrossGammas(const size_t numberOfInstruments, const double shift)
+	{
+		BumpScenarios scenarios;
+		for(size_t i(0); i < numberOfInstruments; ++i)
+		{
+			for(size_t j(i + 1); j < numberOfInstruments; ++j)
+			{
+				for(int signs(0); signs < 4; ++signs)
+				{
+					BumpScenario scenario;
+					scenario.push_back(QuoteBump(i, (signs & 2) ? -shift : shift));
+					scenario.push_back(QuoteBump(j, (signs & 1) ? -shift : shift));
+					scenarios.push_back(scenario);
+				}
+			}
+		}
+		return scenarios;
+	}
+}
@@ -0,0 +1,89 @@
+/*****************************************************************************
+
+    BumpScenarioEngine
+
+	Re-solves a FlexYCF curve for scenarios of bumped quotes in parallel.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_BUMPSCENARIOENGINE_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_BUMPSCENARIOENGINE_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+#include "Matrix.h"
+
+
+namespace LTQuant
+{
+    class FlexYCFZeroCurve;
+}
+
+namespace FlexYCF
+{
+	/// A shift of the market rate of one of the placed instruments of a curve
+	struct QuoteBump
+	{
+		QuoteBump(const size_t instrument_, const double shift_):
+			instrument(instrument_),
+			shift(shift_)
+		{
+		}
+
+		size_t	instrument;		// index of the instrument among the placed instruments
+		double	shift;
+	};
+
+	/// The quotes bumped together in a scenario
+	typedef std::vector<QuoteBump> BumpScenario;
+	typedef std::vector<BumpScenario> BumpScenarios;
+
+    /// BumpScenarioEngine computes bump-and-rebuild risk on a solved curve.
+	///
+	/// The curve is cloned once per worker thread, each clone reloading its
+	/// calibration instruments and binding its own GlobalComponentCache. The
+	/// workers then take the scenarios in turn: each scenario shifts the rates
+	/// of its instruments and re-solves the clone, warm-started from the knots
+	/// of the solved curve, so that the scenarios are independent of the order
+	/// they are solved in.
+	///
+	/// Note: the clones are solved on their own: the curves that depend on the
+	/// bumped curve are not re-solved and the price supplier is not notified.
+    class BumpScenarioEngine
+    {
+    public:
+		/// Creates an engine running on the specified number of threads.
+		/// Zero stands for the number of hardware threads.
+        explicit BumpScenarioEngine(const size_t numberOfThreads = 0);
+
+		/// Re-solves the curve for each scenario and returns the continuously
+		/// compounded zero rates of the bumped curves at the specified flow
+		/// times, one row per scenario and one column per flow time
+		LTQC::Matrix computeBumpedRates(const LTQuant::FlexYCFZeroCurve& zeroCurve,
+										const BumpScenarios& scenarios,
+										const std::vector<double>& flowTimes) const;
+
+		/// Returns the scenarios of a two-sided delta ladder: each of the
+		/// specified number of instruments bumped up, then down, by the shift
+		static BumpScenarios createDeltaLadder(const size_t numberOfInstruments, const double shift);
+
+		/// Returns the scenarios of the cross-gammas of the specified number of
+		/// instruments: each pair of distinct instruments bumped by (+shift, +shift),
+		/// (+shift, -shift), (-shift, +shift) and (-shift, -shift), in this order
+		static BumpScenarios createCrossGammas(const size_t numberOfInstruments, const double shift);
+
+		size_t getNumberOfThreads() const
+		{
+			return m_numberOfThreads;
+		}
+
+    private:
+		size_t m_numberOfThreads;
+    };  //  BumpScenarioEngine
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_BUMPSCENARIOENGINE_H_INCLUDED
@@ -12,6 +12,8 @@
 #pragma once
 
 #include <functional>
+#include <vector>
+#include <algorithm>
 
 namespace FlexYCF
 {
@@ -158,6 +160,165 @@ namespace FlexYCF
         KeyValueCompare m_keyValueCompare;
     };
 
+    /**
+        @brief A storage implementation for the FlexYCF cache that uses an open-addressing hash table.
+
+        This class is intended to be used with FlexYCF::Cache. The key class must contain an inner functor 
+        'Hash' consistent with KeyCompare, i.e. keys that are equivalent with respect to KeyCompare must have 
+        the same hash. The (key, value) pairs are stored contiguously in insertion order and indexed by a flat 
+        table of (hash, position) buckets probed linearly, so that no allocation is made per entry and keys 
+        are only compared when their hashes are equal. The capacity is kept when the storage is cleared.
+    */
+    template< typename Key,
+              typename Value,
+              class KeyCompare >
+    class CacheStorageHash
+    {
+    private:
+        typedef std::pair<Key, Value> KeyValuePair;
+        typedef std::vector<KeyValuePair> Container;
+        typedef typename Key::Hash KeyHash;
+
+        /**
+            @brief A bucket of the hash table: the hash of a key and the position of its pair in the container.
+        */
+        struct Bucket
+        {
+            size_t m_hash;
+            size_t m_position;
+        };
+        typedef std::vector<Bucket> Buckets;
+
+    public:
+        CacheStorageHash()
+        {
+            m_buckets.resize(minNumberOfBuckets(), emptyBucket());
+        }
+
+        /**
+            @brief Test if a key exists?
+
+            @param key The key to test for.
+            @return    Returns true if the key exists.
+        */
+        bool exists(Key const& key) const
+        {
+            return m_buckets[find(key, m_keyHash(key))].m_position != empty();
+        }
+
+        /**
+            @brief Create a new key in the storage or retrieve existing value.
+
+            This function will either insert a new key into the container (and default constructed value) or retrieve
+            the existing value for the key. The validity of the returned reference is temporary and should be considered 
+            invalid once another call to this class is made (c.f. validity of iterators).
+
+            @param key           The key to insert/retrieve.
+            @param[out] inserted Whether the key had to be inserted and the value is newly created.
+            @return              Returns a reference to the value associated with the key.
+        */
+        Value& createOrRetrieve(Key const& key, bool& inserted) 
+        {
+            const size_t hash(m_keyHash(key));
+            size_t bucket(find(key, hash));
+
+            inserted = (m_buckets[bucket].m_position == empty());
+            if(inserted)
+            {
+                // Keep the load factor below 3/4 so that the probe sequences stay short
+                if(4 * (m_container.size() + 1) > 3 * m_buckets.size())
+                {
+                    rehash(2 * m_buckets.size());
+                    bucket = find(key, hash);
+                }
+                m_buckets[bucket].m_hash     = hash;
+                m_buckets[bucket].m_position = m_container.size();
+                m_container.push_back(KeyValuePair(key, Value()));
+            }
+
+            return m_container[m_buckets[bucket].m_position].second;
+        }
+
+        /**
+            @brief Clear all stored values.
+        */
+        void clear()
+        {
+            m_container.clear();
+            std::fill(m_buckets.begin(), m_buckets.end(), emptyBucket());
+        }
+
+    private:
+        static size_t empty()
+        {
+            return static_cast<size_t>(-1);
+        }
+
+        static size_t minNumberOfBuckets()
+        {
+            return 64;
+        }
+
+        static Bucket emptyBucket()
+        {
+            Bucket bucket = { 0, empty() };
+            return bucket;
+        }
+
+        // Folds the high bits of the hash into the low ones used to index the buckets
+        static size_t firstBucket(const size_t hash, const size_t mask)
+        {
+            return (hash ^ (hash >> 7) ^ (hash >> 17)) & mask;
+        }
+
+        // Returns the bucket of the key if it exists, the empty bucket where to insert it otherwise
+        size_t find(Key const& key, const size_t hash) const
+        {
+            const size_t mask(m_buckets.size() - 1);
+            size_t bucket(firstBucket(hash, mask));
+
+            while(m_buckets[bucket].m_position != empty())
+            {
+                if(m_buckets[bucket].m_hash == hash)
+                {
+                    Key const& other(m_container[m_buckets[bucket].m_position].first);
+                    if(!m_keyCompare(key, other) && !m_keyCompare(other, key))
+                    {
+                        break;
+                    }
+                }
+                bucket = (bucket + 1) & mask;
+            }
+            return bucket;
+        }
+
+        // Re-indexes the pairs in a table with the specified (power of 2) number of buckets, using the stored hashes
+        void rehash(const size_t numberOfBuckets)
+        {
+            Buckets buckets(numberOfBuckets, emptyBucket());
+            const size_t mask(numberOfBuckets - 1);
+
+            for(typename Buckets::const_iterator iter(m_buckets.begin()); iter != m_buckets.end(); ++iter)
+            {
+                if(iter->m_position != empty())
+                {
+                    size_t bucket(firstBucket(iter->m_hash, mask));
+                    while(buckets[bucket].m_position != empty())
+                    {
+                        bucket = (bucket + 1) & mask;
+                    }
+                    buckets[bucket] = *iter;
+                }
+            }
+            m_buckets.swap(buckets);
+        }
+
+        Container m_container;
+        Buckets m_buckets;
+        KeyHash m_keyHash;
+        mutable KeyCompare m_keyCompare;
+    };
+
     /**
         @brief A cache used by FlexYCF components.
 
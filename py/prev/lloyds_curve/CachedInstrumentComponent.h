@@ -13,6 +13,8 @@
 
 #include "InstrumentComponent.h"
 #include "GenericInstrumentComponent.h"
+#include "BuildProfile.h"
+#include "AdjointTape.h"
 
 
 namespace FlexYCF
@@ -20,9 +22,12 @@ namespace FlexYCF
     /// CachedInstrumentComponent is a template class that,
     /// given an Arguments class, creates a cache for the
     /// corresponding templatized instrument component type.
+    /// While an AdjointTape is bound to the calling thread, its
+    /// gradient is not cached but propagated by the tape.
     template <class Arguments,
               class TComponent = GenericInstrumentComponent<Arguments> >
-    class CachedInstrumentComponent : public TComponent
+    class CachedInstrumentComponent : public TComponent,
+                                      private AdjointTape::Node
     {
     private:
         DECLARE_SMART_PTRS( TComponent )
@@ -62,6 +67,7 @@ namespace FlexYCF
         {
             if(!m_isValueComputed)
             {
+                BuildProfile::record(BuildProfile::ComponentValueRecompute);
                 m_value = TComponent::getValue(baseModel);
                 m_isValueComputed = true;
             }
@@ -75,21 +81,30 @@ namespace FlexYCF
                                         GradientIterator gradientBegin,
                                         GradientIterator gradientEnd)
         {
-            size_t const length = std::distance(gradientBegin, gradientEnd);
-            if(!m_isGradientComputed)
+            AdjointTape* const adjointTape(AdjointTape::current());
+            if(adjointTape)
             {
-                m_gradient.assign(length, 0.0);
-                TComponent::accumulateGradient(baseModel, 1.0, m_gradient.begin(), m_gradient.end());
-                m_isGradientComputed = true;
+                adjointTape->record(*this, baseModel, multiplier, gradientBegin, gradientEnd);
+                return;
             }
-            double* it1 = &(*gradientBegin);
-            double* it2 = &m_gradient.front();
-            for(size_t i = 0; i < length; ++i)
+
+            if(!m_isGradientComputed)
             {
-                (*it1) += multiplier * (*it2);
-                ++it1;
-                ++it2;
+                BuildProfile::record(BuildProfile::ComponentGradientRecompute);
+                //  Compute the gradient once on the dense buffer and only keep its
+                //  non-zero entries: the gradient is then accumulated in O(#non-zeros).
+                //  The buffer is cleared back from them, to be reused by the next recompute
+                const size_t dimension(std::distance(gradientBegin, gradientEnd));
+                if(m_gradientBuffer.size() != dimension)
+                {
+                    fillWithZeros(m_gradientBuffer, dimension);
+                }
+                TComponent::accumulateGradient(baseModel, 1.0, m_gradientBuffer.begin(), m_gradientBuffer.end());
+                m_gradient.assign(m_gradientBuffer.begin(), m_gradientBuffer.end());
+                m_gradient.clearFrom(m_gradientBuffer.begin());
+                m_isGradientComputed = true;
             }
+            m_gradient.accumulateTo(multiplier, gradientBegin);
         }
 
         /// Updates the cached instrument component
@@ -121,10 +136,21 @@ namespace FlexYCF
     private:
         CachedInstrumentComponent(CachedInstrumentComponent const&); // deliberately disabled as won't clone properly
 
+        //  Accumulates the gradient of the component directly, its
+        //  own components recording their adjoints on the tape
+        virtual void propagateAdjoint(BaseModel const& baseModel,
+                                      double adjoint,
+                                      GradientIterator gradientBegin,
+                                      GradientIterator gradientEnd)
+        {
+            TComponent::accumulateGradient(baseModel, adjoint, gradientBegin, gradientEnd);
+        }
+
         bool m_isValueComputed;
         double m_value;
         bool m_isGradientComputed;
-        std::vector<double> m_gradient;
+        SparseGradient m_gradient;
+        Gradient m_gradientBuffer;     // dense buffer of the recomputes, kept at zero between them
     };  //  CachedInstrumentComponent
 
 }   //  FlexYCF
@@ -20,6 +20,7 @@
 #include "CachedDerivInstrument.h"
 #include "IHasRepFlows.h"
 #include "ICloneLookup.h"
+#include "BuildArena.h"
 
 // IDeA
 #include "FundingRepFlow.h"
@@ -80,6 +81,18 @@ namespace FlexYCF
 
         virtual ~CalibrationInstrument() = 0 {};
 
+        /// Calibration instruments are allocated from the arena
+        /// of the curve build, if any (see BuildArena)
+        static void* operator new(const size_t size)
+        {
+            return BuildArena::allocate(size);
+        }
+
+        static void operator delete(void* const pointer)
+        {
+            BuildArena::deallocate(pointer);
+        }
+
 
         /// there is an implementation in this class that is responsible for capturing
         /// the cached values
@@ -12,6 +12,7 @@
 //	FlexYCF
 #include "CalibrationInstrumentFactory.h"
 #include "CalibrationInstruments.h"
+#include "BuildProfile.h"
 #include "CashInstrument.h"
 #include "ZeroRate.h"
 #include "ZeroSpread.h"
@@ -38,6 +39,7 @@
 #include "Pricers\PriceSupplier.h"
 #include "Timer.h"
 #include "FlexYcfUtils.h"
+#include "InstrumentComponent.h"
 
 //	IDeA
 #include "DataExtraction.h"
@@ -99,6 +101,11 @@ namespace FlexYCF
                                                           GlobalComponentCache& globalComponentCache,
                                                           const LTQuant::PriceSupplierPtr priceSupplier)
     {
+		//	Components created lazily by the instruments must come from the
+		//	cache of this build, whichever thread it runs on
+		const InstrumentComponent::GlobalCacheScope cacheScope(&globalComponentCache);
+		const BuildProfile::ScopedTimer loadingTimer(BuildProfile::InstrumentLoading);
+
 		const GenericDataPtr instrumentsTable(IDeA::extract<GenericDataPtr>(*data, getKey<CalibrationInstruments>()));
         for(size_t i(0); i < instrumentsTable->numTags(); ++ i)
         {
@@ -0,0 +1,73 @@
+/*****************************************************************************
+
+	ConvexityCalibrationCache
+
+	Implementation of the ConvexityCalibrationCache
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "ConvexityCalibrationCache.h"
+
+#include <map>
+#include <boost/thread/mutex.hpp>
+
+using namespace std;
+
+namespace FlexYCF
+{
+	namespace
+	{
+		typedef pair<string, ConvexityCalibrationConstPtr> KeyCalibrationPair;
+		typedef map<string, KeyCalibrationPair> ConvexityCalibrations;
+
+		ConvexityCalibrations	s_calibrations;		// by curve
+		boost::mutex			s_mutex;
+	}
+
+	BuildSwitch ConvexityCalibrationCache::s_enabled = BUILD_SWITCH_INIT(true);
+
+	ConvexityCalibrationConstPtr ConvexityCalibrationCache::get(const string& curve, const string& key)
+	{
+		if(!s_enabled.isOn())
+		{
+			return ConvexityCalibrationConstPtr();
+		}
+
+		boost::mutex::scoped_lock lock(s_mutex);
+		const ConvexityCalibrations::const_iterator calibration(s_calibrations.find(curve));
+		return calibration != s_calibrations.end() && calibration->second.first == key
+			? calibration->second.second
+			: ConvexityCalibrationConstPtr();
+	}
+
+	void ConvexityCalibrationCache::set(const string& curve, const string& key, const ConvexityCalibrationConstPtr& calibration)
+	{
+		if(s_enabled.isOn())
+		{
+			boost::mutex::scoped_lock lock(s_mutex);
+			s_calibrations[curve] = KeyCalibrationPair(key, calibration);
+		}
+	}
+
+	size_t ConvexityCalibrationCache::size()
+	{
+		boost::mutex::scoped_lock lock(s_mutex);
+		return s_calibrations.size();
+	}
+
+	void ConvexityCalibrationCache::clear()
+	{
+		boost::mutex::scoped_lock lock(s_mutex);
+		s_calibrations.clear();
+	}
+
+	void ConvexityCalibrationCache::setEnabled(const bool enabled)
+	{
+		s_enabled.set(enabled);
+	}
+}
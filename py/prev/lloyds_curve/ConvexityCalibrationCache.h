@@ -0,0 +1,78 @@
+/*****************************************************************************
+
+    ConvexityCalibrationCache
+
+	A process-wide cache of the calibrations of the futures convexity models
+	to the swaption cubes.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_CONVEXITYCALIBRATIONCACHE_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_CONVEXITYCALIBRATIONCACHE_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+#include "BuildSwitch.h"
+
+
+namespace LTQuant
+{
+    FWD_DECLARE_SMART_PTRS( LiborMarketModel )
+    FWD_DECLARE_SMART_PTRS( InstantaneousVol )
+}
+
+namespace FlexYCF
+{
+	/// The instantaneous vol calibrated to the implied vol quotes of a
+	/// futures convexity model and the LMM built from it
+	struct ConvexityCalibration
+	{
+		LTQuant::InstantaneousVolConstPtr	instantaneousVolatility;
+		LTQuant::LiborMarketModelConstPtr	lmm;
+	};
+
+	DECLARE_SMART_PTRS( ConvexityCalibration )
+
+	/// ConvexityCalibrationCache keeps the last calibration of the futures
+	/// convexity model of each curve, so that the rebuilds of the curve
+	/// during the day reuse it instead of calibrating the instantaneous vol
+	/// and building the LMM again.
+	///
+	/// A calibration is identified by a key made of all its inputs (value 
+	/// date, tenor structure, vol model, correlation structure, LMM settings
+	/// and implied vol quotes): it is replaced as 
+	/// soon as the vol data of the curve change. The cached calibrations are
+	/// not modified once cached. It is safe to use from several threads.
+	class ConvexityCalibrationCache
+	{
+	public:
+		/// Returns the calibration of the curve with the specified key, null if none
+		static ConvexityCalibrationConstPtr get(const std::string& curve, const std::string& key);
+
+		/// Sets the calibration of the curve, replacing its previous calibration
+		static void set(const std::string& curve, const std::string& key, const ConvexityCalibrationConstPtr& calibration);
+
+		/// Returns the number of curves with a cached calibration
+		static size_t size();
+
+		/// Removes the cached calibrations, e.g. when the LMM settings change
+		static void clear();
+
+		/// Switches the caching of the calibrations on or off, on by default (see BuildSwitch)
+		static void setEnabled(const bool enabled);
+
+		static bool isEnabled()
+		{
+			return s_enabled.isOn();
+		}
+
+	private:
+		static BuildSwitch s_enabled;
+	};  //  ConvexityCalibrationCache
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_CONVEXITYCALIBRATIONCACHE_H_INCLUDED
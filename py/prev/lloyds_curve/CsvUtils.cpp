@@ -0,0 +1,96 @@
+/*****************************************************************************
+
+	CsvUtils
+
+	Implementation of the CSV reading functions
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "CsvUtils.h"
+
+#include <cctype>
+#include <cstdlib>
+
+using namespace std;
+
+namespace FlexYCF
+{
+	bool equalsCaseless(const string& lhs, const string& rhs)
+	{
+		if(lhs.size() != rhs.size())
+		{
+			return false;
+		}
+		for(size_t k(0); k < lhs.size(); ++k)
+		{
+			if(tolower(static_cast<unsigned char>(lhs[k])) != tolower(static_cast<unsigned char>(rhs[k])))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	string trimCsvField(const string& field)
+	{
+		const size_t begin(field.find_first_not_of(" \t\r\n\""));
+		if(begin == string::npos)
+		{
+			return string();
+		}
+		return field.substr(begin, field.find_last_not_of(" \t\r\n\"") + 1 - begin);
+	}
+
+	vector<string> splitCsvLine(const string& line)
+	{
+		vector<string> fields;
+		size_t begin(0);
+		for(size_t end(line.find(',')); end != string::npos; begin = end + 1, end = line.find(',', begin))
+		{
+			fields.push_back(trimCsvField(line.substr(begin, end - begin)));
+		}
+		fields.push_back(trimCsvField(line.substr(begin)));
+		return fields;
+	}
+
+	size_t findCsvColumn(const vector<string>& header, const char* const names[], const size_t numberOfNames)
+	{
+		for(size_t n(0); n < numberOfNames; ++n)
+		{
+			for(size_t k(0); k < header.size(); ++k)
+			{
+				if(equalsCaseless(header[k], names[n]))
+				{
+					return k;
+				}
+			}
+		}
+		return string::npos;
+	}
+
+	bool parseCsvDouble(const vector<string>& fields, const size_t column, double& value)
+	{
+		if(column >= fields.size() || fields[column].empty())
+		{
+			return false;
+		}
+		char* end;
+		value = strtod(fields[column].c_str(), &end);
+		return *end == '\0';
+	}
+
+	long getDaysSinceEpoch(int year, const int month, const int day)
+	{
+		year -= (month <= 2 ? 1 : 0);
+		const long era((year >= 0 ? year : year - 399) / 400);
+		const long yearOfEra(year - era * 400);
+		const long dayOfYear((153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1);
+		const long dayOfEra(yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear);
+		return era * 146097 + dayOfEra - 719468;
+	}
+}
@@ -0,0 +1,46 @@
+/*****************************************************************************
+
+    CsvUtils
+
+	Contains the functions reading the fields of the CSV files
+	FlexYCF loads quotes and ticks from
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_CSVUTILS_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_CSVUTILS_H_INCLUDED
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+namespace FlexYCF
+{
+	/// Returns true if the strings are equal, ignoring the case
+	bool equalsCaseless(const std::string& lhs, const std::string& rhs);
+
+	/// Returns the field without its surrounding spaces and quotes
+	std::string trimCsvField(const std::string& field);
+
+	/// Returns the trimmed fields of a CSV line
+	std::vector<std::string> splitCsvLine(const std::string& line);
+
+	/// Returns the position of the first column of the header with one of
+	/// the specified names, ignoring the case, std::string::npos if none
+	size_t findCsvColumn(const std::vector<std::string>& header, const char* const names[], const size_t numberOfNames);
+
+	/// Reads the field of the specified column as a double.
+	/// Returns false if the field is missing, empty or not a number
+	bool parseCsvDouble(const std::vector<std::string>& fields, const size_t column, double& value);
+
+	/// Returns the number of days from 1 January 1970 to the specified
+	/// date of the proleptic Gregorian calendar
+	long getDaysSinceEpoch(int year, const int month, const int day);
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_CSVUTILS_H_INCLUDED
@@ -20,6 +20,16 @@ namespace FlexYCF
         onExtremalIteratorsSet();
     }
 
+    void CurveAlgorithm::evaluateSorted(std::vector<double>::const_iterator xBegin,
+                                        std::vector<double>::const_iterator xEnd,
+                                        std::vector<double>::iterator yBegin) const
+    {
+        for(; xBegin != xEnd; ++xBegin, ++yBegin)
+        {
+            *yBegin = evaluate(*xBegin);
+        }
+    }
+
     size_t CurveAlgorithm::size() const
     {
         return std::distance<const_iterator>(m_begin, m_end);    
@@ -29,6 +29,13 @@ namespace FlexYCF
         /// Evaluates the curve at the point x
         virtual double evaluate(const double x) const = 0;
 
+        /// Evaluates the curve at the points from xBegin to xEnd, sorted
+        /// in ascending order, and writes the values from yBegin
+        /// Note: the default implementation evaluates each point in turn
+        virtual void evaluateSorted(std::vector<double>::const_iterator xBegin,
+                                    std::vector<double>::const_iterator xEnd,
+                                    std::vector<double>::iterator yBegin) const;
+
         /// Computes the gradient relative to the unknowns
         /// and adds multiplier times the gradient to the points between the iterators supplied
         virtual void accumulateGradient(const double x,
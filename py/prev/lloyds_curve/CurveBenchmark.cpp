@@ -0,0 +1,401 @@
+/*****************************************************************************
+
+	CurveBenchmark
+
+	Implementation of the CurveBenchmark
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "CurveBenchmark.h"
+#include "CsvUtils.h"
+#include "FlexYCFZeroCurve.h"
+#include "FlexYCFCurveCreator.h"
+#include "GenericIRMarketData.h"
+#include "BaseModel.h"
+#include "Gradient.h"
+#include "LeastSquaresResiduals.h"
+#include "PerformanceTracker.h"
+#include "Timer.h"
+#include "DateUtils.h"
+
+//	IDeA
+#include "DictYieldCurve.h"
+#include "DataExtraction.h"
+
+//	LTQuantLib
+#include "Data/GenericData.h"
+#include "Pricers/PriceSupplier.h"
+#include "ModuleDate/InternalInterface/DayCounterFactory.h"
+
+#include <fstream>
+#include <algorithm>
+
+using namespace std;
+
+namespace FlexYCF
+{
+    using namespace LTQuant;
+
+	namespace
+	{
+		void addValue(PerformanceTracker& performanceTracker, const string& key, const double value)
+		{
+			if(!performanceTracker.exists(key))
+			{
+				performanceTracker.insert(key);
+			}
+			performanceTracker[key].push_back(value);
+		}
+
+		//	Adds the time, in ms, and the corresponding throughput, in operations per second
+		void addTiming(PerformanceTracker& performanceTracker, const string& key, const double milliseconds, const size_t numberOfOperations = 1)
+		{
+			addValue(performanceTracker, key, milliseconds);
+			if(milliseconds > 0.0)
+			{
+				addValue(performanceTracker, key + ".perSecond", 1000.0 * numberOfOperations / milliseconds);
+			}
+		}
+
+		double timeRefresh(FlexYCFZeroCurve& curve)
+		{
+			LTQuant::Timer timer;
+			timer.start();
+			curve.refresh();
+			timer.stop();
+			return timer.getMilliseconds();
+		}
+
+		//	Keeps the evaluations timed from being optimized away
+		volatile double s_sink;
+	}
+
+	CurveBenchmark::CurveBenchmark(const size_t numberOfRuns, const double quoteBump, const size_t numberOfDates):
+		m_numberOfRuns(numberOfRuns),
+		m_quoteBump(quoteBump),
+		m_numberOfDates(numberOfDates)
+	{
+		if(m_numberOfRuns == 0 || m_numberOfDates == 0)
+		{
+			LT_THROW_ERROR("The number of runs and of dates of the benchmark must be positive");
+		}
+	}
+
+	void CurveBenchmark::loadCurves(const string& fileName, const PriceSupplierPtr& priceSupplier)
+	{
+		ifstream in(fileName.c_str());
+		string line;
+		if(!in || !getline(in, line))
+		{
+			LT_THROW_ERROR("Cannot read the quote file '" << fileName << "'");
+		}
+
+		const vector<string> header(splitCsvLine(line));
+		static const char* const curveNames[]		= { "Curve" };
+		static const char* const currencyNames[]	= { "Currency" };
+		static const char* const indexNames[]		= { "Index" };
+		static const char* const typeNames[]		= { "Instrument Type" };
+		static const char* const descriptionNames[]	= { "Description" };
+		static const char* const quoteNames[]		= { "Quote" };
+		const size_t curveColumn(findCsvColumn(header, curveNames, 1));
+		const size_t currencyColumn(findCsvColumn(header, currencyNames, 1));
+		const size_t indexColumn(findCsvColumn(header, indexNames, 1));
+		const size_t typeColumn(findCsvColumn(header, typeNames, 1));
+		const size_t descriptionColumn(findCsvColumn(header, descriptionNames, 1));
+		const size_t quoteColumn(findCsvColumn(header, quoteNames, 1));
+		if(curveColumn == string::npos || currencyColumn == string::npos || indexColumn == string::npos
+			|| typeColumn == string::npos || descriptionColumn == string::npos || quoteColumn == string::npos)
+		{
+			LT_THROW_ERROR("The quote file '" << fileName << "' must have the columns Curve, Currency, Index, Instrument Type, Description and Quote");
+		}
+
+		static const char* const instrumentTypes[] = { "Cash", "Futures", "FRA", "Swaps", "OIS" };
+		const size_t numberOfInstrumentTypes(sizeof(instrumentTypes) / sizeof(instrumentTypes[0]));
+
+		//	The instrument tables of each curve, by instrument type, their numbers of rows, and its currency and index
+		typedef map<InstrumentType, GenericDataPtr> InstrumentTables;
+		map<string, InstrumentTables> instrumentTables;
+		map<string, map<InstrumentType, size_t> > numbersOfRows;
+		map<string, pair<string, string> > curveIndices;
+		vector<Quote> quotes;
+
+		while(getline(in, line))
+		{
+			const vector<string> fields(splitCsvLine(line));
+			if(fields.size() == 1 && fields[0].empty())
+			{
+				continue;
+			}
+
+			double value;
+			if(fields.size() <= max(max(max(curveColumn, currencyColumn), max(indexColumn, typeColumn)), max(descriptionColumn, quoteColumn))
+				|| fields[curveColumn].empty() || fields[descriptionColumn].empty() || !parseCsvDouble(fields, quoteColumn, value))
+			{
+				LT_THROW_ERROR("Invalid line '" << line << "' in the quote file '" << fileName << "'");
+			}
+			if(m_curves.find(fields[curveColumn]) != m_curves.end())
+			{
+				LT_THROW_ERROR("The curve '" << fields[curveColumn] << "' of the quote file '" << fileName << "' is already loaded");
+			}
+
+			const pair<string, string> curveIndex(fields[currencyColumn], fields[indexColumn]);
+			const pair<map<string, pair<string, string> >::iterator, bool> inserted(curveIndices.insert(make_pair(fields[curveColumn], curveIndex)));
+			if(inserted.first->second != curveIndex)
+			{
+				LT_THROW_ERROR("The curve '" << fields[curveColumn] << "' has several currencies or indices in the quote file '" << fileName << "'");
+			}
+
+			size_t type(0);
+			while(type < numberOfInstrumentTypes && !equalsCaseless(fields[typeColumn], instrumentTypes[type]))
+			{
+				++type;
+			}
+			if(type == numberOfInstrumentTypes)
+			{
+				LT_THROW_ERROR("The instrument type '" << fields[typeColumn] << "' of the curve '" << fields[curveColumn] << "' is not supported");
+			}
+
+			Quote quote;
+			quote.curveName			= fields[curveColumn];
+			quote.instrumentType	= static_cast<InstrumentType>(type);
+			quote.quote				= value;
+
+			GenericDataPtr& instrumentTable(instrumentTables[quote.curveName][quote.instrumentType]);
+			if(!instrumentTable)
+			{
+				instrumentTable = GenericDataPtr(new GenericData(instrumentTypes[type], 0));
+			}
+			quote.instrumentTable	= instrumentTable;
+			quote.row				= numbersOfRows[quote.curveName][quote.instrumentType]++;
+
+			switch(quote.instrumentType)
+			{
+			case Cash:
+				IDeA::inject<string>(*instrumentTable, IDeA_KEY(CASH, TENOR), quote.row, fields[descriptionColumn]);
+				break;
+			case Futures:
+				IDeA::inject<string>(*instrumentTable, IDeA_KEY(FUTURE, EXPIRY), quote.row, fields[descriptionColumn]);
+				break;
+			case FRA:
+				IDeA::inject<string>(*instrumentTable, IDeA_KEY(FRA, DESCRIPTION), quote.row, fields[descriptionColumn]);
+				break;
+			case Swaps:
+				IDeA::inject<string>(*instrumentTable, IDeA_KEY(SWAP, TENOR), quote.row, fields[descriptionColumn]);
+				break;
+			case OIS:
+				IDeA::inject<string>(*instrumentTable, IDeA_KEY(OIS, TENOR), quote.row, fields[descriptionColumn]);
+				break;
+			}
+			setQuote(quote, quote.quote);
+			quotes.push_back(quote);
+		}
+
+		//	The curves are only created once the whole file is read
+		const LT::date buildDate(priceSupplier->getDate());
+		FlexYCFCurveCreator curveCreator;
+		Curves curves;
+		for(map<string, InstrumentTables>::const_iterator curve(instrumentTables.begin()); curve != instrumentTables.end(); ++curve)
+		{
+			const GenericDataPtr instrumentList(new GenericData("Instrument List", 0));
+			for(InstrumentTables::const_iterator instrumentTable(curve->second.begin()); instrumentTable != curve->second.end(); ++instrumentTable)
+			{
+				switch(instrumentTable->first)
+				{
+				case Cash:
+					IDeA::inject(*instrumentList, IDeA_KEY(YC_INSTRUMENTLIST, CASH), instrumentTable->second);
+					break;
+				case Futures:
+					IDeA::inject(*instrumentList, IDeA_KEY(YC_INSTRUMENTLIST, FUTURES), instrumentTable->second);
+					break;
+				case FRA:
+					IDeA::inject(*instrumentList, IDeA_KEY(YC_INSTRUMENTLIST, FRA), instrumentTable->second);
+					break;
+				case Swaps:
+					IDeA::inject(*instrumentList, IDeA_KEY(YC_INSTRUMENTLIST, SWAPS), instrumentTable->second);
+					break;
+				case OIS:
+					IDeA::inject(*instrumentList, IDeA_KEY(YC_INSTRUMENTLIST, OIS), instrumentTable->second);
+					break;
+				}
+			}
+
+			const pair<string, string>& curveIndex(curveIndices[curve->first]);
+
+			//	The curve type is the one FlexYCFCurveCreator::create reads
+			const GenericDataPtr curveDetails(new GenericData("Curve Details", 0));
+			IDeA::inject(*curveDetails, IDeA_KEY(CURVEDETAILS, BUILDDATE), buildDate);
+			curveDetails->set<string>("Type", 0, "IR");
+
+			const GenericDataPtr curveParameters(new GenericData("Curve Parameters", 0));
+			IDeA::inject(*curveParameters, IDeA_KEY(YC_CURVEPARAMETERS, CURRENCY), curveIndex.first);
+			IDeA::inject(*curveParameters, IDeA_KEY(YC_CURVEPARAMETERS, FORECASTINDEX), curveIndex.second);
+
+			//	The model and its parameters are left to the defaults of the instrument list
+			const GenericDataPtr yieldCurve(new GenericData("Yield Curve", 0));
+			IDeA::inject(*yieldCurve, IDeA_KEY(YIELDCURVE, CURVEDETAILS), curveDetails);
+			IDeA::inject(*yieldCurve, IDeA_KEY(YIELDCURVE, YC_CURVEPARAMETERS), curveParameters);
+			IDeA::inject(*yieldCurve, IDeA_KEY(YIELDCURVE, YC_INSTRUMENTLIST), instrumentList);
+
+			const GenericIRMarketDataPtr marketData(std::tr1::dynamic_pointer_cast<GenericIRMarketData>(curveCreator.create(yieldCurve)));
+			if(!marketData)
+			{
+				LT_THROW_ERROR("Cannot create the market data of the curve '" << curve->first << "'");
+			}
+			marketData->addToPricer(priceSupplier);
+
+			for(size_t i(0); i < priceSupplier->zeroCurvesSize(); ++i)
+			{
+				const FlexYCFZeroCurvePtr zeroCurve(std::tr1::dynamic_pointer_cast<FlexYCFZeroCurve>(priceSupplier->getZeroCurve(i)));
+				if(zeroCurve && zeroCurve->getMarketData() == marketData)
+				{
+					curves[curve->first] = zeroCurve;
+				}
+			}
+			if(curves.find(curve->first) == curves.end())
+			{
+				LT_THROW_ERROR("Cannot find the curve '" << curve->first << "' in the price supplier");
+			}
+		}
+
+		m_curves.insert(curves.begin(), curves.end());
+		m_quotes.insert(m_quotes.end(), quotes.begin(), quotes.end());
+	}
+
+	void CurveBenchmark::run(PerformanceTracker& performanceTracker) const
+	{
+		static const ZeroCurveRefreshType refreshTypes[] = { FromSolver, FromJacobian, Incremental };
+		static const char* const refreshTypeNames[] = { "FromSolver", "FromJacobian", "Incremental" };
+		const size_t numberOfRefreshTypes(sizeof(refreshTypes) / sizeof(refreshTypes[0]));
+
+		for(Curves::const_iterator iter(m_curves.begin()); iter != m_curves.end(); ++iter)
+		{
+			FlexYCFZeroCurve& curve(*iter->second);
+			const ZeroCurveRefreshType refreshType(curve.getRefreshType());
+			try
+			{
+				double shift(m_quoteBump);
+				for(size_t run(0); run < m_numberOfRuns; ++run)
+				{
+					curve.setRefreshType(FullRebuild);
+					curve.setRefreshRequired();
+					addTiming(performanceTracker, iter->first + ".build", timeRefresh(curve));
+
+					if(curve.getModel()->isJacobianSupported())
+					{
+						for(size_t type(0); type < numberOfRefreshTypes; ++type)
+						{
+							curve.setRefreshType(refreshTypes[type]);
+							shiftQuotes(iter->first, shift);
+							shift = -shift;
+							addTiming(performanceTracker, iter->first + ".refresh." + refreshTypeNames[type], timeRefresh(curve));
+						}
+					}
+
+					evaluate(iter->first, curve, performanceTracker);
+				}
+			}
+			catch(...)
+			{
+				shiftQuotes(iter->first, 0.0);
+				curve.setRefreshType(refreshType);
+				throw;
+			}
+
+			shiftQuotes(iter->first, 0.0);
+			curve.setRefreshType(refreshType);
+		}
+	}
+
+	void CurveBenchmark::setQuote(const Quote& quote, const double value)
+	{
+		switch(quote.instrumentType)
+		{
+		case Cash:
+			IDeA::inject<double>(*quote.instrumentTable, IDeA_KEY(CASH, RATE), quote.row, value);
+			break;
+		case Futures:
+			IDeA::inject<double>(*quote.instrumentTable, IDeA_KEY(FUTURE, PRICE), quote.row, value);
+			break;
+		case FRA:
+			IDeA::inject<double>(*quote.instrumentTable, IDeA_KEY(FRA, RATE), quote.row, value);
+			break;
+		case Swaps:
+			IDeA::inject<double>(*quote.instrumentTable, IDeA_KEY(SWAP, RATE), quote.row, value);
+			break;
+		case OIS:
+			IDeA::inject<double>(*quote.instrumentTable, IDeA_KEY(OIS, RATE), quote.row, value);
+			break;
+		}
+	}
+
+	void CurveBenchmark::shiftQuotes(const string& curveName, const double shift) const
+	{
+		for(vector<Quote>::const_iterator quote(m_quotes.begin()); quote != m_quotes.end(); ++quote)
+		{
+			if(quote->curveName == curveName)
+			{
+				setQuote(*quote, quote->quote + shift);
+			}
+		}
+		m_curves.find(curveName)->second->setRefreshRequired();
+	}
+
+	void CurveBenchmark::evaluate(const string& curveName, const FlexYCFZeroCurve& curve, PerformanceTracker& performanceTracker) const
+	{
+		static const long daysInWeek(7);
+		static const long daysInQuarter(91);
+
+		const LT::date valueDate(curve.getMarketData()->getValueDate());
+		vector<LT::date> dates(m_numberOfDates);
+		vector<double> flowTimes(m_numberOfDates);
+		for(size_t k(0); k < m_numberOfDates; ++k)
+		{
+			dates[k] = LT::date(valueDate.getAsLong() + daysInWeek * static_cast<long>(k + 1));
+			flowTimes[k] = ModuleDate::getYearsBetween(valueDate, dates[k]);
+		}
+		const ModuleDate::DayCounterPtr basis(ModuleDate::DayCounterFactory::create("ACT/365"));
+		const BaseModelPtr model(curve.getModel());
+
+		double sum(0.0);
+		LTQuant::Timer discountFactorTimer;
+		discountFactorTimer.start();
+		for(size_t k(0); k < m_numberOfDates; ++k)
+		{
+			sum += curve.getDiscountFactor(dates[k]);
+		}
+		discountFactorTimer.stop();
+		addTiming(performanceTracker, curveName + ".discountFactor", discountFactorTimer.getMilliseconds(), m_numberOfDates);
+
+		LTQuant::Timer forwardRateTimer;
+		forwardRateTimer.start();
+		for(size_t k(0); k < m_numberOfDates; ++k)
+		{
+			sum += curve.getForwardRate(dates[k], LT::date(dates[k].getAsLong() + daysInQuarter), basis);
+		}
+		forwardRateTimer.stop();
+		addTiming(performanceTracker, curveName + ".forwardRate", forwardRateTimer.getMilliseconds(), m_numberOfDates);
+
+		//	The gradient is accumulated over the whole grid, as the
+		//	jacobian rows and the analytical delta accumulate them
+		Gradient gradient(model->getLeastSquaresResiduals()->size(), 0.0);
+		LTQuant::Timer gradientTimer;
+		gradientTimer.start();
+		for(size_t k(0); k < m_numberOfDates; ++k)
+		{
+			model->accumulateDiscountFactorGradient(flowTimes[k], 1.0, gradient.begin(), gradient.end());
+		}
+		gradientTimer.stop();
+		addTiming(performanceTracker, curveName + ".gradient", gradientTimer.getMilliseconds(), m_numberOfDates);
+
+		for(Gradient::const_iterator derivative(gradient.begin()); derivative != gradient.end(); ++derivative)
+		{
+			sum += *derivative;
+		}
+		s_sink = sum;
+	}
+}
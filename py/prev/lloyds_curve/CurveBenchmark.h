@@ -0,0 +1,113 @@
+/*****************************************************************************
+
+    CurveBenchmark
+
+	Times the builds, the refreshes and the evaluations of FlexYCF
+	curves created from a quote file.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_CURVEBENCHMARK_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_CURVEBENCHMARK_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+
+#include <map>
+
+
+namespace LTQuant
+{
+	FWD_DECLARE_SMART_PTRS( PriceSupplier )
+    FWD_DECLARE_SMART_PTRS( FlexYCFZeroCurve )
+	FWD_DECLARE_SMART_GENERIC_DATA_PTRS
+}
+
+namespace FlexYCF
+{
+	class PerformanceTracker;
+
+    /// CurveBenchmark measures the time and the throughput of the builds,
+	/// of each refresh type and of the discount factor, forward rate and
+	/// gradient evaluations of FlexYCF curves, so that the figures can be
+	/// compared across runs and releases (see PerformanceTracker::saveCsv).
+	///
+	/// The curves are created from a CSV quote file, with the columns Curve,
+	/// Currency, Index, Instrument Type (Cash, Futures, FRA, Swaps or OIS),
+	/// Description and Quote, one line per instrument. The quote files of the
+	/// GBP and USD fixtures are written by py/benchmark_quotes.py.
+	/// Each curve gets a yield curve table with the instruments of its lines,
+	/// the model and its parameters being the defaults FlexYCF selects from
+	/// the instrument list, and is added to the price supplier.
+	///
+	/// Each run makes a full build of each curve, then, for each refresh
+	/// type the model of the curve supports, moves its quotes by the bump,
+	/// alternately up and down, and refreshes the curve. The discount factors,
+	/// forward rates and discount factor gradients are then evaluated on a
+	/// weekly grid of dates.
+	/// The tracker gets, per curve, in ms:
+	///		<curve>.build and <curve>.refresh.<type>,
+	///		<curve>.discountFactor, <curve>.forwardRate and <curve>.gradient, for the whole grid,
+	/// and the corresponding <key>.perSecond throughputs, in builds, refreshes or evaluations.
+    class CurveBenchmark
+    {
+    public:
+		/// Creates a benchmark of the specified number of runs, moving the quotes by
+		/// the bump and evaluating the curves on the specified number of weekly dates
+        explicit CurveBenchmark(const size_t numberOfRuns = 10,
+								const double quoteBump = 1.0e-4,
+								const size_t numberOfDates = 1560);
+
+		/// Creates the curves of the specified quote file, built on the date of
+		/// the price supplier, and adds them to the price supplier
+		void loadCurves(const std::string& fileName, const LTQuant::PriceSupplierPtr& priceSupplier);
+
+		/// Runs the benchmark of the loaded curves, adding the timings to the tracker.
+		/// The quotes and the refresh type of the curves are restored at the end
+		void run(PerformanceTracker& performanceTracker) const;
+
+    private:
+		enum InstrumentType
+		{
+			Cash,
+			Futures,
+			FRA,
+			Swaps,
+			OIS
+		};
+
+		struct Quote
+		{
+			std::string					curveName;
+			LTQuant::GenericDataPtr		instrumentTable;
+			InstrumentType				instrumentType;
+			size_t						row;
+			double						quote;
+		};
+
+		typedef std::map<std::string, LTQuant::FlexYCFZeroCurvePtr> Curves;
+
+		//	Sets the quote in the instrument table of its curve
+		static void setQuote(const Quote& quote, const double value);
+
+		//	Sets the quotes of the curve moved by the specified shift
+		void shiftQuotes(const std::string& curveName, const double shift) const;
+
+		//	Adds the timings of the evaluations of the curve on the grid of dates
+		void evaluate(const std::string& curveName,
+					  const LTQuant::FlexYCFZeroCurve& curve,
+					  PerformanceTracker& performanceTracker) const;
+
+		size_t				m_numberOfRuns;
+		double				m_quoteBump;
+		size_t				m_numberOfDates;
+		Curves				m_curves;
+		std::vector<Quote>	m_quotes;
+    };  //  CurveBenchmark
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_CURVEBENCHMARK_H_INCLUDED
@@ -107,6 +107,16 @@ namespace FlexYCF
 		m_baseCurve->addUnknownsToProblem(problem, onKnotPointVariableAddedToProblem);
 	}
     
+    void CurveFormulation::getDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                              std::vector<double>::const_iterator flowTimesEnd,
+                                              std::vector<double>::iterator discountFactorsBegin) const
+    {
+        for(; flowTimesBegin != flowTimesEnd; ++flowTimesBegin, ++discountFactorsBegin)
+        {
+            *discountFactorsBegin = getDiscountFactor(*flowTimesBegin);
+        }
+    }
+
 	void CurveFormulation::updateVariablesFromShifts(const LTQC::VectorDouble& variableShifts)
 	{
 		for(size_t k(0); k < variableShifts.size(); ++k)
@@ -53,6 +53,13 @@ namespace FlexYCF
     
     public:
         virtual double getDiscountFactor(const double flowTime) const = 0;
+
+        /// Computes the discount factors at the flow times, sorted in ascending
+        /// order, from flowTimesBegin to flowTimesEnd
+        /// Note: the default implementation calls getDiscountFactor for each flow time
+        virtual void getDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                        std::vector<double>::const_iterator flowTimesEnd,
+                                        std::vector<double>::iterator discountFactorsBegin) const;
         virtual void accumulateDiscountFactorGradient(const double x, 
 													  double multiplier, GradientIterator gradientBegin, GradientIterator gradientEnd) const = 0;
 		virtual double getVariableValueFromSpineDiscountFactor(const double flowTime,
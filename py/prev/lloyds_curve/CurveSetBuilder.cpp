@@ -0,0 +1,286 @@
+/*****************************************************************************
+
+	CurveSetBuilder
+
+	Implementation of the CurveSetBuilder
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "CurveSetBuilder.h"
+#include "FlexYCFZeroCurve.h"
+#include "GenericIRMarketData.h"
+#include "BaseModel.h"
+#include "ParallelLoop.h"
+
+//	LTQuantLib
+#include "Pricers/PriceSupplier.h"
+#include "Data/GenericData.h"
+
+//	IDeA
+#include "DataExtraction.h"
+#include "DictYieldCurve.h"
+
+#include <sstream>
+#include <boost/thread/thread.hpp>
+
+using namespace LTQC;
+using namespace std;
+using namespace IDeA;
+
+namespace FlexYCF
+{
+    using namespace LTQuant;
+
+	namespace
+	{
+		//	Returns the (currency, index) pairs of the IR curves the
+		//	specified curve depends on
+		void getDependentIRCurves(const GenericIRMarketData& marketData, vector<pair<LT::Str, LT::Str> >& dependentCurves)
+		{
+			const GenericDataPtr curveParametersTable(IDeA::extract<GenericDataPtr>(*marketData.getData(), IDeA_KEY(YIELDCURVE, YC_CURVEPARAMETERS)));
+			GenericDataPtr dependentMarketData;
+			IDeA::permissive_extract<GenericDataPtr>(curveParametersTable, IDeA_KEY(YC_CURVEPARAMETERS, YC_DEPENDENTMARKETDATA), dependentMarketData);
+			if(!dependentMarketData)
+			{
+				return;
+			}
+
+			for(size_t i = 1; i < dependentMarketData->table->rowsGet(); ++i)
+			{
+				const AssetDomainType adType(AssetDomainType(IDeA::extract<LT::Str>(dependentMarketData->table, IDeA_KEY(YC_DEPENDENTMARKETDATA, TYPE), i-1)));
+				if(adType == IDeA::AssetDomainType::IR)
+				{
+					const LT::Str asset(IDeA::extract<LT::Str>(dependentMarketData->table, IDeA_KEY(YC_DEPENDENTMARKETDATA, ASSET), i-1));
+					const LT::Str market(IDeA::extract<LT::Str>(dependentMarketData->table, IDeA_KEY(YC_DEPENDENTMARKETDATA, MARKET), i-1));
+					dependentCurves.push_back(make_pair(asset, market));
+				}
+			}
+		}
+
+		//	Throws if the curve set is not a directed acyclic graph
+		void checkNoCircularDependency(const CurveSetNodes& curveSet)
+		{
+			enum { NotVisited, Visiting, Visited };
+			vector<int> states(curveSet.size(), NotVisited);
+
+			for(size_t root(0); root < curveSet.size(); ++root)
+			{
+				if(states[root] != NotVisited)
+				{
+					continue;
+				}
+
+				//	Iterative depth-first search: (node, next parent to visit)
+				vector<pair<size_t, size_t> > path(1, make_pair(root, size_t(0)));
+				states[root] = Visiting;
+
+				while(!path.empty())
+				{
+					const size_t node(path.back().first);
+					size_t& nextParent(path.back().second);
+
+					if(nextParent == curveSet[node].parents.size())
+					{
+						states[node] = Visited;
+						path.pop_back();
+						continue;
+					}
+
+					const size_t parent(curveSet[node].parents[nextParent++]);
+					if(states[parent] == Visiting)
+					{
+						LTQC_THROW(IDeA::ModelException, "Circular dependency between the curves "
+							<< curveSet[node].currency << " " << curveSet[node].index << " and "
+							<< curveSet[parent].currency << " " << curveSet[parent].index);
+					}
+					if(states[parent] == NotVisited)
+					{
+						states[parent] = Visiting;
+						path.push_back(make_pair(parent, size_t(0)));
+					}
+				}
+			}
+		}
+
+		//	Returns the wave of each curve: the curves of a wave only
+		//	depend on curves of the previous waves
+		vector<size_t> getWaves(const CurveSetNodes& curveSet, size_t& numberOfWaves)
+		{
+			vector<size_t> waves(curveSet.size(), string::npos);
+			numberOfWaves = 0;
+			for(size_t numberOfCurvesLeft(curveSet.size()); numberOfCurvesLeft > 0; ++numberOfWaves)
+			{
+				vector<size_t> wave;
+				for(size_t k(0); k < curveSet.size(); ++k)
+				{
+					if(waves[k] != string::npos)
+					{
+						continue;
+					}
+					bool parentsBuilt(true);
+					for(vector<size_t>::const_iterator parent(curveSet[k].parents.begin()); parent != curveSet[k].parents.end() && parentsBuilt; ++parent)
+					{
+						parentsBuilt = (waves[*parent] < numberOfWaves);
+					}
+					if(parentsBuilt)
+					{
+						wave.push_back(k);
+					}
+				}
+				for(vector<size_t>::const_iterator k(wave.begin()); k != wave.end(); ++k)
+				{
+					waves[*k] = numberOfWaves;
+				}
+				numberOfCurvesLeft -= wave.size();
+			}
+			return waves;
+		}
+	}
+
+	CurveSetBuilder::CurveSetBuilder(const size_t numberOfThreads):
+		m_numberOfThreads(numberOfThreads == 0 ? max(1u, boost::thread::hardware_concurrency()) : numberOfThreads)
+	{
+	}
+
+	void CurveSetBuilder::build(PriceSupplier& priceSupplier) const
+	{
+		build(createCurveSet(priceSupplier));
+	}
+
+	void CurveSetBuilder::build(const CurveSetNodes& curveSet) const
+	{
+		size_t numberOfWaves;
+		const vector<size_t> waves(getWaves(curveSet, numberOfWaves));
+
+		vector<bool> failed(curveSet.size(), false);
+		ostringstream errors;
+		for(size_t wave(0); wave < numberOfWaves; ++wave)
+		{
+			vector<size_t> curves;
+			for(size_t k(0); k < curveSet.size(); ++k)
+			{
+				if(waves[k] == wave)
+				{
+					curves.push_back(k);
+				}
+			}
+
+			//	Dependents of a curve that failed are not built
+			vector<bool> skipped(curves.size(), false);
+			for(size_t n(0); n < curves.size(); ++n)
+			{
+				const vector<size_t>& parents(curveSet[curves[n]].parents);
+				for(vector<size_t>::const_iterator parent(parents.begin()); parent != parents.end(); ++parent)
+				{
+					skipped[n] = skipped[n] || failed[*parent];
+				}
+			}
+
+			vector<FlexYCFZeroCurve::DeferredNotifications> notifications(curves.size());
+			vector<string> curveErrors(curves.size());
+			parallelLoop(curves.size(), m_numberOfThreads, [&] (const size_t n)
+			{
+				if(skipped[n])
+				{
+					return;
+				}
+				try
+				{
+					const FlexYCFZeroCurve::NotificationDeferralScope notificationDeferralScope(notifications[n]);
+
+					//	Triggers the build, or the pending refresh, of the curve
+					curveSet[curves[n]].zeroCurve->getModel();
+				}
+				catch(const std::exception& e)
+				{
+					curveErrors[n] = e.what();
+				}
+				catch(...)
+				{
+					curveErrors[n] = "unknown error";
+				}
+			});
+
+			//	No curve is being built: the price supplier can be notified
+			for(size_t n(0); n < curves.size(); ++n)
+			{
+				if(!skipped[n] && curveErrors[n].empty())
+				{
+					try
+					{
+						FlexYCFZeroCurve::replayNotifications(notifications[n]);
+					}
+					catch(const std::exception& e)
+					{
+						curveErrors[n] = e.what();
+					}
+					catch(...)
+					{
+						curveErrors[n] = "unknown error";
+					}
+				}
+				failed[curves[n]] = skipped[n] || !curveErrors[n].empty();
+				if(!curveErrors[n].empty())
+				{
+					errors << curveSet[curves[n]].currency << " " << curveSet[curves[n]].index << ": " << curveErrors[n] << endl;
+				}
+			}
+		}
+
+		if(!errors.str().empty())
+		{
+			LTQC_THROW(IDeA::ModelException, "The following curves could not be built:" << endl << errors.str());
+		}
+	}
+
+	CurveSetNodes CurveSetBuilder::createCurveSet(PriceSupplier& priceSupplier)
+	{
+		CurveSetNodes curveSet;
+		vector<GenericIRMarketDataPtr> marketData;
+		for(size_t i = 0; i < priceSupplier.zeroCurvesSize(); ++i)
+		{
+			const FlexYCFZeroCurvePtr flexYcfZeroCurve(std::tr1::dynamic_pointer_cast<FlexYCFZeroCurve>(priceSupplier.getZeroCurve(i)));
+			const GenericIRMarketDataPtr genericIRMarketData(flexYcfZeroCurve ? std::tr1::dynamic_pointer_cast<GenericIRMarketData>(flexYcfZeroCurve->getMarketData()) : GenericIRMarketDataPtr());
+			if(genericIRMarketData)
+			{
+				CurveSetNode node;
+				node.zeroCurveIndex = i;
+				node.zeroCurve = flexYcfZeroCurve;
+				node.currency = genericIRMarketData->getCurrency();
+				node.index = genericIRMarketData->getIndexName();
+				curveSet.push_back(node);
+				marketData.push_back(genericIRMarketData);
+			}
+		}
+
+		vector<pair<LT::Str, LT::Str> > dependentCurves;
+		for(size_t n(0); n < curveSet.size(); ++n)
+		{
+			dependentCurves.clear();
+			getDependentIRCurves(*marketData[n], dependentCurves);
+
+			for(vector<pair<LT::Str, LT::Str> >::const_iterator dependentCurve(dependentCurves.begin()); dependentCurve != dependentCurves.end(); ++dependentCurve)
+			{
+				//	Dependencies on curves that are not FlexYCF curves are
+				//	ignored: those are resolved on demand
+				for(size_t k(0); k < curveSet.size(); ++k)
+				{
+					if(dependentCurve->first.compareCaseless(curveSet[k].currency.c_str()) == 0 &&
+					   dependentCurve->second.compareCaseless(curveSet[k].index.c_str()) == 0)
+					{
+						curveSet[n].parents.push_back(k);
+						break;
+					}
+				}
+			}
+		}
+
+		checkNoCircularDependency(curveSet);
+		return curveSet;
+	}
+}
@@ -0,0 +1,90 @@
+/*****************************************************************************
+
+    CurveSetBuilder
+
+	Builds all the FlexYCF curves of a price supplier, calibrating the
+	curves that do not depend on each other in parallel.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_CURVESETBUILDER_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_CURVESETBUILDER_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+
+
+namespace LTQuant
+{
+    FWD_DECLARE_SMART_PTRS( PriceSupplier )
+    FWD_DECLARE_SMART_PTRS( FlexYCFZeroCurve )
+}
+
+namespace FlexYCF
+{
+	/// A FlexYCF curve of the price supplier together with the
+	/// indices, in the curve set, of the curves it depends on
+	struct CurveSetNode
+	{
+		size_t							zeroCurveIndex;	// index of the curve in the price supplier
+		LTQuant::FlexYCFZeroCurvePtr	zeroCurve;
+		std::string						currency;
+		std::string						index;
+		std::vector<size_t>				parents;		// indices in the curve set
+	};
+
+	typedef std::vector<CurveSetNode> CurveSetNodes;
+
+    /// CurveSetBuilder builds the FlexYCF zero curves of a price supplier
+	/// in dependency order: OIS discount curves before the tenor curves
+	/// discounted on them, domestic curves before the cross-currency funding
+	/// curves, etc...
+	///
+	/// The dependency graph is read from the dependent market data table of
+	/// each master table (the same table BaseModel::prepareForSolve resolves
+	/// the dependent models from), so it is known before any curve is built.
+	/// The curves are built in waves: the curves of a wave only depend on
+	/// curves of the previous waves and are calibrated concurrently.
+	///
+	/// A solved curve notifies the price supplier, which its siblings read.
+	/// The notifications are therefore deferred while a wave is built, then
+	/// replayed on the calling thread, so that the price supplier is only
+	/// mutated by one thread at a time and the curves of a wave only start
+	/// once their parents are registered.
+	///
+	/// Note: curves are built by their own thread, each binding its own
+	/// GlobalComponentCache (see InstrumentComponent::GlobalCacheScope).
+    class CurveSetBuilder
+    {
+    public:
+		/// Creates a builder running on the specified number of threads.
+		/// Zero stands for the number of hardware threads.
+        explicit CurveSetBuilder(const size_t numberOfThreads = 0);
+
+		/// Builds (or refreshes, when a refresh is pending) all
+		/// the FlexYCF zero curves of the price supplier
+		void build(LTQuant::PriceSupplier& priceSupplier) const;
+
+		/// Builds (or refreshes) the specified curve set
+		void build(const CurveSetNodes& curveSet) const;
+
+		/// Returns the FlexYCF zero curves of the price supplier
+		/// and their dependencies on one another.
+		/// Throws if the dependencies are circular.
+		static CurveSetNodes createCurveSet(LTQuant::PriceSupplier& priceSupplier);
+
+		size_t getNumberOfThreads() const
+		{
+			return m_numberOfThreads;
+		}
+
+    private:
+		size_t m_numberOfThreads;
+    };  //  CurveSetBuilder
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_CURVESETBUILDER_H_INCLUDED
@@ -13,28 +13,109 @@
 //	FlexYCF
 #include "CurveType.h"
 #include "NullDeleter.h"
-#include "TenorUtils.h"
 
 //	IDeA
 #include "DictYieldCurve.h"
 
+#include <algorithm>
+#include <cctype>
+
 using namespace LTQC;
 
 namespace FlexYCF
 {
-	CurveType::CurveType(const std::string& description, 
+	namespace
+	{
+		//	Interned descriptions: the normalized descriptions of the curve
+		//	types and their aliases, sorted to be binary searched
+		typedef std::vector<std::pair<std::string, CurveTypeConstPtr> > InternedDescriptions;
+
+		struct InternedDescriptionLess
+		{
+			bool operator()(const InternedDescriptions::value_type& lhs, const InternedDescriptions::value_type& rhs) const
+			{
+				return lhs.first < rhs.first;
+			}
+
+			bool operator()(const InternedDescriptions::value_type& lhs, const std::string& rhs) const
+			{
+				return lhs.first < rhs;
+			}
+
+			bool operator()(const std::string& lhs, const InternedDescriptions::value_type& rhs) const
+			{
+				return lhs < rhs.first;
+			}
+		};
+
+		//	Removes the whitespaces and upper cases the description, as
+		//	descriptions are compared ignoring whitespaces and case
+		std::string normalizeDescription(const std::string& description)
+		{
+			std::string normalized;
+			normalized.reserve(description.size());
+			for(std::string::const_iterator iter(description.begin()); iter != description.end(); ++iter)
+			{
+				if(!isspace(static_cast<unsigned char>(*iter)))
+				{
+					normalized.push_back(static_cast<char>(toupper(static_cast<unsigned char>(*iter))));
+				}
+			}
+			return normalized;
+		}
+
+		void intern(InternedDescriptions& descriptions, const std::string& description, const CurveTypeConstPtr& curveType)
+		{
+			descriptions.push_back(InternedDescriptions::value_type(normalizeDescription(description), curveType));
+		}
+
+		InternedDescriptions buildInternedDescriptions()
+		{
+			InternedDescriptions descriptions;
+
+			// Note: cannot build a Null curve type from description
+			intern(descriptions, CurveType::AllTenors()->getDescription(), CurveType::AllTenors());
+			intern(descriptions, CurveType::Discount()->getDescription(), CurveType::Discount());
+			for(CurveType::Tenors::const_iterator iter(CurveType::Tenors::begin()); iter != CurveType::Tenors::end(); ++iter)
+			{
+				intern(descriptions, (*iter)->getDescription(), *iter);
+			}
+
+			// Handles 1D and its equivalent tenors (see tenorEquivalency) as ON, and 12M as 1Y
+			intern(descriptions, "1D", CurveType::ON());
+			intern(descriptions, "O/N", CurveType::ON());
+			intern(descriptions, "TN", CurveType::ON());
+			intern(descriptions, "T/N", CurveType::ON());
+			intern(descriptions, "12M", CurveType::_1Y());
+
+			sort(descriptions.begin(), descriptions.end(), InternedDescriptionLess());
+			return descriptions;
+		}
+
+		const InternedDescriptions& internedDescriptions()
+		{
+			const static InternedDescriptions descriptions(buildInternedDescriptions());
+			return descriptions;
+		}
+	}
+
+	CurveType::CurveType(const Id id,
+						 const std::string& description, 
                          const double yearFraction,
                          const bool isTenor) :
+        m_id(id),
         m_description(description),
         m_yearFraction(yearFraction),
         m_isTenor(isTenor)
     {
     }
 
-	CurveType::CurveType(const std::string& description,
+	CurveType::CurveType(const Id id,
+						 const std::string& description,
 					     const double yearFraction,
 					     const bool isTenor,
 						 const IDeA::DictionaryKey& key):
+        m_id(id),
         m_description(description),
         m_yearFraction(yearFraction),
         m_isTenor(isTenor),
@@ -53,46 +134,14 @@ namespace FlexYCF
     
 	CurveTypeConstPtr CurveType::getFromDescription(const std::string& description)
     {
-		// Note: cannot build a Null curve type from description
-		if(compareDescriptions(description, LT::Str(CurveType::AllTenors()->getDescription())))
-			return CurveType::AllTenors();
-        if(compareDescriptions(description, LT::Str(CurveType::Discount()->getDescription())))
-            return CurveType::Discount();
-        // Handles 1D as ON
-		if(compareDescriptions(description, LT::Str(CurveType::ON()->getDescription()))
-			|| compareDescriptions(FlexYCF::tenorEquivalency(description), LT::Str("1D")))
-            return CurveType::ON();
-		if(compareDescriptions(description, LT::Str(CurveType::_2D()->getDescription())))
-			return CurveType::_2D();
-        if(compareDescriptions(description, LT::Str(CurveType::_1W()->getDescription())))
-            return CurveType::_1W();
-        if(compareDescriptions(description, LT::Str(CurveType::_2W()->getDescription())))
-            return CurveType::_2W();
-        if(compareDescriptions(description, LT::Str(CurveType::_1M()->getDescription())))
-            return CurveType::_1M();
-        if(compareDescriptions(description, LT::Str(CurveType::_2M()->getDescription())))
-            return CurveType::_2M();
-        if(compareDescriptions(description, LT::Str(CurveType::_3M()->getDescription())))
-            return CurveType::_3M();
-        if(compareDescriptions(description, LT::Str(CurveType::_4M()->getDescription())))
-            return CurveType::_4M();
-        if(compareDescriptions(description, LT::Str(CurveType::_5M()->getDescription())))
-            return CurveType::_5M();
-        if(compareDescriptions(description, LT::Str(CurveType::_6M()->getDescription())))
-            return CurveType::_6M();
-        if(compareDescriptions(description, LT::Str(CurveType::_7M()->getDescription())))
-            return CurveType::_7M();
-        if(compareDescriptions(description, LT::Str(CurveType::_8M()->getDescription())))
-            return CurveType::_8M();
-        if(compareDescriptions(description, LT::Str(CurveType::_9M()->getDescription())))
-            return CurveType::_9M();
-        if(compareDescriptions(description, LT::Str(CurveType::_10M()->getDescription())))
-            return CurveType::_10M();
-        if(compareDescriptions(description, LT::Str(CurveType::_11M()->getDescription())))
-            return CurveType::_11M();
-        if(compareDescriptions(description, LT::Str(CurveType::_1Y()->getDescription()))
-			|| compareDescriptions(description, LT::Str("12M")))
-            return CurveType::_1Y();
+		const InternedDescriptions& descriptions(internedDescriptions());
+		const std::string normalized(normalizeDescription(description));
+
+		const InternedDescriptions::const_iterator lower(lower_bound(descriptions.begin(), descriptions.end(), normalized, InternedDescriptionLess()));
+		if(lower != descriptions.end() && lower->first == normalized)
+		{
+			return lower->second;
+		}
         LT_THROW_ERROR( "Invalid curve type description: '" << description << "'." )
     }
 
@@ -110,117 +159,117 @@ namespace FlexYCF
     CurveTypeConstPtr CurveType::Null()
     {
         // Magic invalid year fraction - will throw an exception if attempt to access it
-        static const CurveType Null_("Null", -10.0, false);        
+        static const CurveType Null_(NullId, "Null", -10.0, false);        
         return CurveTypeConstPtr(&Null_, NullDeleter());
     }
 
 	CurveTypeConstPtr CurveType::AllTenors()
 	{
 		// Magic invalid year fraction - will throw an exception if attempt to access it
-        static const CurveType AllTenors_("All Tenors", -2., false);
+        static const CurveType AllTenors_(AllTenorsId, "All Tenors", -2., false);
 		return CurveTypeConstPtr(&AllTenors_, NullDeleter());
 	}
 
     CurveTypeConstPtr CurveType::Discount()
     {
         // Magic invalid year fraction - will throw an exception if attempt to access it
-        static const CurveType Discount_("Discount", -1.0, false, IDeA_KEY(CURVESINTERPOLATION, FUNDING)); 
+        static const CurveType Discount_(DiscountId, "Discount", -1.0, false, IDeA_KEY(CURVESINTERPOLATION, FUNDING)); 
         return CurveTypeConstPtr(&Discount_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::ON()
     {
-        static const CurveType ON_("ON", 0.004, true, IDeA_KEY(CURVESINTERPOLATION, 1D));            // 1 / 250
+        static const CurveType ON_(ONId, "ON", 0.004, true, IDeA_KEY(CURVESINTERPOLATION, 1D));            // 1 / 250
         return CurveTypeConstPtr(&ON_, NullDeleter());
     }
 
     CurveTypeConstPtr  CurveType::_2D()
     {
-        static const CurveType _2D_("2D", 0.008, true, IDeA_KEY(CURVESINTERPOLATION, 2D));            // 2 / 250
+        static const CurveType _2D_(_2DId, "2D", 0.008, true, IDeA_KEY(CURVESINTERPOLATION, 2D));            // 2 / 250
         return CurveTypeConstPtr(&_2D_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_1W()
     {
-        static const CurveType _1W_("1W", 0.019230769230769, true, IDeA_KEY(CURVESINTERPOLATION, 1W));   // 1 / 52
+        static const CurveType _1W_(_1WId, "1W", 0.019230769230769, true, IDeA_KEY(CURVESINTERPOLATION, 1W));   // 1 / 52
         return CurveTypeConstPtr(&_1W_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_2W()
     {
-        static const CurveType _2W_("2W", 0.038461538461539, true, IDeA_KEY(CURVESINTERPOLATION, 2W));   // 2 /52
+        static const CurveType _2W_(_2WId, "2W", 0.038461538461539, true, IDeA_KEY(CURVESINTERPOLATION, 2W));   // 2 /52
         return CurveTypeConstPtr(&_2W_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_1M()
     {
-        static const CurveType _1M_("1M", 0.083333333333333, true, IDeA_KEY(CURVESINTERPOLATION, 1M));   // 1 / 12
+        static const CurveType _1M_(_1MId, "1M", 0.083333333333333, true, IDeA_KEY(CURVESINTERPOLATION, 1M));   // 1 / 12
         return CurveTypeConstPtr(&_1M_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_2M()
     {
-        static const CurveType _2M_("2M", 0.16666666666666649, true, IDeA_KEY(CURVESINTERPOLATION, 2M));   // 2 / 12
+        static const CurveType _2M_(_2MId, "2M", 0.16666666666666649, true, IDeA_KEY(CURVESINTERPOLATION, 2M));   // 2 / 12
         return CurveTypeConstPtr(&_2M_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_3M()
     {
-        static const CurveType _3M_("3M", 0.25, true, IDeA_KEY(CURVESINTERPOLATION, 3M));    // 3 / 12
+        static const CurveType _3M_(_3MId, "3M", 0.25, true, IDeA_KEY(CURVESINTERPOLATION, 3M));    // 3 / 12
         return CurveTypeConstPtr(&_3M_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_4M()
     {
-        static const CurveType _4M_("4M", 0.333333333333333, true, IDeA_KEY(CURVESINTERPOLATION, 4M));   // 4 / 12
+        static const CurveType _4M_(_4MId, "4M", 0.333333333333333, true, IDeA_KEY(CURVESINTERPOLATION, 4M));   // 4 / 12
         return CurveTypeConstPtr(&_4M_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_5M()
     {
-        static const CurveType _5M_("5M", 0.416666666666667, true, IDeA_KEY(CURVESINTERPOLATION, 5M));   // 5 / 12
+        static const CurveType _5M_(_5MId, "5M", 0.416666666666667, true, IDeA_KEY(CURVESINTERPOLATION, 5M));   // 5 / 12
         return CurveTypeConstPtr(&_5M_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_6M()
     {
-        static const CurveType _6M_("6M", 0.5, true, IDeA_KEY(CURVESINTERPOLATION,6M )); // 6 / 12
+        static const CurveType _6M_(_6MId, "6M", 0.5, true, IDeA_KEY(CURVESINTERPOLATION,6M )); // 6 / 12
         return CurveTypeConstPtr(&_6M_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_7M()
     {
-        static const CurveType _7M_("7M", 0.583333333333333, true, IDeA_KEY(CURVESINTERPOLATION, 7M));    // 7 / 12
+        static const CurveType _7M_(_7MId, "7M", 0.583333333333333, true, IDeA_KEY(CURVESINTERPOLATION, 7M));    // 7 / 12
         return CurveTypeConstPtr(&_7M_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_8M()
     {
-        static const CurveType _8M_("8M", 0.666666666666667, true, IDeA_KEY(CURVESINTERPOLATION, 8M));    // 8 / 12
+        static const CurveType _8M_(_8MId, "8M", 0.666666666666667, true, IDeA_KEY(CURVESINTERPOLATION, 8M));    // 8 / 12
         return CurveTypeConstPtr(&_8M_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_9M()
     {
-        static const CurveType _9M_("9M", 0.75, true, IDeA_KEY(CURVESINTERPOLATION, 9M));    // 9 / 12
+        static const CurveType _9M_(_9MId, "9M", 0.75, true, IDeA_KEY(CURVESINTERPOLATION, 9M));    // 9 / 12
         return CurveTypeConstPtr(&_9M_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_10M()
     {
-        static const CurveType _10M_("10M",  0.833333333333333, true, IDeA_KEY(CURVESINTERPOLATION, 10M));  // 10 / 12
+        static const CurveType _10M_(_10MId, "10M",  0.833333333333333, true, IDeA_KEY(CURVESINTERPOLATION, 10M));  // 10 / 12
         return CurveTypeConstPtr(&_10M_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_11M()
     {
-        static const CurveType _11M_("11M", 0.916666666666667, true, IDeA_KEY(CURVESINTERPOLATION, 11M));  // 11 / 12
+        static const CurveType _11M_(_11MId, "11M", 0.916666666666667, true, IDeA_KEY(CURVESINTERPOLATION, 11M));  // 11 / 12
         return CurveTypeConstPtr(&_11M_, NullDeleter());
     }
 
     CurveTypeConstPtr CurveType::_1Y()
     {
-        static const CurveType _1Y_("1Y", 1.0, true, IDeA_KEY(CURVESINTERPOLATION, 12M));
+        static const CurveType _1Y_(_1YId, "1Y", 1.0, true, IDeA_KEY(CURVESINTERPOLATION, 12M));
         return CurveTypeConstPtr(&_1Y_, NullDeleter());
     }
 
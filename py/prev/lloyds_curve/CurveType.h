@@ -50,6 +50,13 @@ namespace FlexYCF
 			return m_key;
 		}
 
+		/// Returns the small integer interned for this curve type, the ids
+		/// being in the same order as the curve types (see LessThan)
+		inline size_t getId() const
+		{
+			return m_id;
+		}
+
         double getYearFraction() const;
          
         static CurveTypeConstPtr getFromDescription(const std::string& description);
@@ -89,23 +96,50 @@ namespace FlexYCF
         static CurveTypeConstPtr _1Y();
 
         
+        // The ids interned for the curve types, in ascending order
+        enum Id
+        {
+            NullId,
+            AllTenorsId,
+            DiscountId,
+            ONId,
+            _2DId,
+            _1WId,
+            _2WId,
+            _1MId,
+            _2MId,
+            _3MId,
+            _4MId,
+            _5MId,
+            _6MId,
+            _7MId,
+            _8MId,
+            _9MId,
+            _10MId,
+            _11MId,
+            _1YId,
+            NumberOfIds
+        };
+
         // Null < AllTenors < Discount < ON < 1W < ..
+        // The ids are ordered as the year fractions, so that the curve types
+        // are compared as integers
         static bool LessThan(const CurveType& lhs, const CurveType& rhs)
         {
-            return lhs.m_yearFraction < rhs.m_yearFraction;
+            return lhs.m_id < rhs.m_id;
         }
 
         static bool Equals(const CurveType& lhs, const CurveType& rhs)
         {
-            return lhs.m_yearFraction == rhs.m_yearFraction;
+            return lhs.m_id == rhs.m_id;
         }
         
         // A inner struct to use to order CurveTypeConstPtr's inside STL containers
         struct DereferenceLess
         {
-            bool operator()(const CurveTypeConstPtr lhs, const CurveTypeConstPtr rhs) const
+            bool operator()(const CurveTypeConstPtr& lhs, const CurveTypeConstPtr& rhs) const
             {
-                return CurveType::LessThan(*lhs, *rhs);    
+                return lhs->m_id < rhs->m_id;    
             }
         };
 
@@ -113,19 +147,17 @@ namespace FlexYCF
         std::ostream& print(std::ostream& out) const;
 
     private:
-		static inline bool compareDescriptions(const LT::Str& lhs, const LT::Str& rhs)
-		{
-			return (0 == LT::compareStrings(lhs, rhs, LT::compare_strings_flag_ignore_whitespace | LT::compare_strings_flag_caseless));
-		}
-
-        CurveType(const std::string& description,
+        CurveType(const Id id,
+                  const std::string& description,
                   const double yearFraction,
                   const bool isTenor);
-		CurveType(const std::string& description,
+		CurveType(const Id id,
+                  const std::string& description,
                   const double yearFraction,
                   const bool isTenor,
 				  const IDeA::DictionaryKey& key);
 
+        const size_t				m_id;
         const std::string			m_description;
         const double				m_yearFraction;
         const bool					m_isTenor;
@@ -1,6 +1,8 @@
 /*****************************************************************************
 
-    Todo: - Add header file description
+    DaysOverBasisCache
+
+	Looks up the coverages of the day counters in their year fraction tables.
     
     @Originator		Nicolas Maury
     
@@ -11,8 +13,7 @@
 #define __LIBRARY_PRICERS_FLEXYCF_DAYSOVERBASISCACHE_H_INCLUDED
 #pragma once
 
-#include "Cache.h"
-#include "DaysOverBasisArguments.h"
+#include "YearFractionTable.h"
 #include "ModuleDate/InternalInterface/DayCounter.h"
 
 
@@ -20,26 +21,51 @@ namespace FlexYCF
 {
     /// A class to cache computations of day counter's getDaysOverBasis
     /// function.
+	///
+	/// The coverages are the differences of the entries of the shared
+	/// YearFractionTable of each day counter: the cache only keeps the
+	/// table of each day counter met, so that the lookups of a build do
+	/// not take the lock of the tables. The day counters without a table
+	/// compute their coverages.
     class DaysOverBasisCache
     {
     public:
-        DaysOverBasisCache()
-        {
-			m_cache.setFunction([] (const DaysOverBasisArguments& daysOverBasisArguments)
-				{return daysOverBasisArguments.computeValue();});
-        }
-
         double getDaysOverBasis(const ModuleDate::DayCounterConstPtr dayCounter, const LT::date startDate, const LT::date endDate)
         {
-            return m_cache.get(DaysOverBasisArguments(dayCounter, startDate, endDate));    
+			return YearFractionTable::getDaysOverBasis(getTable(dayCounter), dayCounter, startDate, endDate);
         }
 
+		/// Fills the coverages of all the periods of a schedule
+		void getDaysOverBasis(const ModuleDate::DayCounterConstPtr dayCounter, 
+							  const ModuleDate::Schedule::ScheduleEvents& periods,
+							  std::vector<double>& coverages)
+		{
+			YearFractionTable::getDaysOverBasis(getTable(dayCounter), dayCounter, periods, coverages);
+		}
+
     private:
-        Cache<DaysOverBasisArguments, double, DaysOverBasisArguments::Compare> m_cache;    
-    };  // DayCounterCache
+		typedef std::pair<ModuleDate::DayCounterConstPtr, YearFractionTableConstPtr> DayCounterTablePair;
+
+		//	There are only a few day counters per build: a linear search on
+		//	their addresses is faster than a map
+		const YearFractionTable* getTable(const ModuleDate::DayCounterConstPtr& dayCounter)
+		{
+			for(std::vector<DayCounterTablePair>::const_iterator iter(m_tables.begin()); iter != m_tables.end(); ++iter)
+			{
+				if(iter->first.get() == dayCounter.get())
+				{
+					return iter->second.get();
+				}
+			}
+			m_tables.push_back(DayCounterTablePair(dayCounter, YearFractionTable::get(dayCounter)));
+			return m_tables.back().second.get();
+		}
+
+		std::vector<DayCounterTablePair> m_tables;
+    };  // DaysOverBasisCache
 
     DECLARE_SMART_PTRS( DaysOverBasisCache )
 
 }   //  FlexYCF
 
-#endif //__LIBRARY_PRICERS_FLEXYCF_DAYSOVERBASISCACHE_H_INCLUDED
\ No newline at end of file
+#endif //__LIBRARY_PRICERS_FLEXYCF_DAYSOVERBASISCACHE_H_INCLUDED
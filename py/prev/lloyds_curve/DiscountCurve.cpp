@@ -40,6 +40,13 @@ namespace FlexYCF
         return m_baseCurve->evaluate(flowTime);
     }
 
+    void DiscountCurve::getDiscountFactors(vector<double>::const_iterator flowTimesBegin,
+                                           vector<double>::const_iterator flowTimesEnd,
+                                           vector<double>::iterator discountFactorsBegin) const
+    {
+        m_baseCurve->evaluateSorted(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+    }
+
     void DiscountCurve::accumulateDiscountFactorGradient(const double x, 
                                                          double multiplier,
                                                          GradientIterator gradientBegin,
@@ -14,6 +14,8 @@
 #include "LTQuantInitial.h"
 #include "Currency.h"
 
+#include <boost/functional/hash.hpp>
+
 namespace QDDate
 {
     FWD_DECLARE_SMART_PTRS( DayCounter )
@@ -44,6 +46,16 @@ namespace FlexYCF
             }   
         };
 
+        /// Hash functor consistent with Compare, used by CacheStorageHash.
+        /// Only the flow time is hashed, the currency and index rarely differ in a cache
+        struct Hash
+        {
+            size_t operator()(const DiscountFactorArguments& discountFactorArgs) const
+            {
+                return boost::hash_value(discountFactorArgs.m_flowTime);
+            }
+        };
+
         bool operator==(const DiscountFactorArguments& other) const
         {
             return m_flowTime == other.m_flowTime && 
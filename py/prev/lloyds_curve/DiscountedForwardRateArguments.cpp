@@ -2,6 +2,7 @@
 #include "LTQuantInitial.h"
 #include "DiscountedForwardRateArguments.h"
 #include "GlobalComponentCache.h"
+#include "YearFractionTable.h"
 #include "ModuleDate/InternalInterface/DayCounter.h"
 #include "ForwardRate.h"
 #include "DiscountFactor.h"
@@ -26,10 +27,11 @@ namespace FlexYCF
 																   const LT::date payDate,
 																   const std::string& tenorDescription,
 																   const DayCounterConstPtr rateBasis,
-																   const DayCounterConstPtr accrualBasis):
+																   const DayCounterConstPtr accrualBasis,
+																   const YearFractionTable* const accrualTable):
 		m_forwardRate(ForwardRate::create(ForwardRateArguments(valueDate, fixingDate, startDate, endDate, tenorDescription, rateBasis))),
 		m_discountFactor(DiscountFactor::create(DiscountFactorArguments(valueDate, payDate))), 
-		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(accrualBasis->getDaysOverBasis(accStartDate, accEndDate))
+		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(YearFractionTable::getDaysOverBasis(accrualTable, accrualBasis, accStartDate, accEndDate))
 	{
 	}
 
@@ -46,7 +48,7 @@ namespace FlexYCF
                                                                    GlobalComponentCache& globalComponentCache):
         m_forwardRate( globalComponentCache.get(ForwardRate::Arguments(valueDate, fixingDate, startDate, endDate, tenor, rateBasis, globalComponentCache)) ),
         m_discountFactor( globalComponentCache.get(DiscountFactor::Arguments(valueDate, payDate)) ),
-		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(accrualBasis->getDaysOverBasis(accStartDate, accEndDate))
+		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(globalComponentCache.getDaysOverBasis(accrualBasis, accStartDate, accEndDate))
     {
     }
 
@@ -63,7 +65,7 @@ namespace FlexYCF
                                                                    GlobalComponentCache& globalComponentCache):
         m_forwardRate( globalComponentCache.get(ForwardRate::Arguments(valueDate, fixingDate, startDate, endDate, tenorDescription, rateBasis, globalComponentCache)) ),
         m_discountFactor( globalComponentCache.get(DiscountFactor::Arguments(valueDate, payDate)) ),
-		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(accrualBasis->getDaysOverBasis(accStartDate, accEndDate))
+		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(globalComponentCache.getDaysOverBasis(accrualBasis, accStartDate, accEndDate))
     {
     }
 
@@ -77,11 +79,12 @@ namespace FlexYCF
 																   const std::string& tenorDescription,
 																   const DayCounterConstPtr rateBasis,
 																   const DayCounterConstPtr accrualBasis,
+																   const YearFractionTable* const accrualTable,
                                                                    const LTQC::Currency& ccy,
                                                                    const LT::Str& index):
 		m_forwardRate(ForwardRate::create(ForwardRateArguments(valueDate, fixingDate, startDate, endDate, tenorDescription, rateBasis, ccy, index))),
 		m_discountFactor(DiscountFactor::create(DiscountFactorArguments(valueDate, payDate, ccy, index))), 
-		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(accrualBasis->getDaysOverBasis(accStartDate, accEndDate))
+		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(YearFractionTable::getDaysOverBasis(accrualTable, accrualBasis, accStartDate, accEndDate))
 	{
 	}
 
@@ -100,7 +103,7 @@ namespace FlexYCF
                                                                    GlobalComponentCache& globalComponentCache):
         m_forwardRate( globalComponentCache.get(ForwardRate::Arguments(valueDate, fixingDate, startDate, endDate, tenorDescription, rateBasis, ccy, index, globalComponentCache)) ),
         m_discountFactor( globalComponentCache.get(DiscountFactor::Arguments(valueDate, payDate,ccy,index)) ),
-		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(accrualBasis->getDaysOverBasis(accStartDate, accEndDate))
+		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(globalComponentCache.getDaysOverBasis(accrualBasis, accStartDate, accEndDate))
     {
     }
      
@@ -169,6 +172,7 @@ namespace FlexYCF
 																   const std::string& tenorDescription,
 																   const DayCounterConstPtr rateBasis,
 																   const DayCounterConstPtr accrualBasis,
+																   const YearFractionTable* const accrualTable,
                                                                    const LTQC::Currency& ccy,
                                                                    const LT::Str& index):
 		m_forwardRate(ForwardRate::create(ForwardRateArguments(valueDate, fixingDate, startDate, endDate, tenorDescription, rateBasis, ccy, index))),
@@ -179,7 +183,7 @@ namespace FlexYCF
         m_foreignFixingDateDiscountFactor(DiscountFactor::create(DiscountFactorArguments(valueDate, startDate))),
 		m_domesticSpotFxDateDiscountFactor(DiscountFactor::create(DiscountFactor::Arguments(valueDate, spotFxDate, ccy, index))),
         m_foreignSpotFxDateDiscountFactor(DiscountFactor::create(DiscountFactor::Arguments(valueDate, spotFxDate))),
-		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(accrualBasis->getDaysOverBasis(accStartDate, accEndDate))
+		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(YearFractionTable::getDaysOverBasis(accrualTable, accrualBasis, accStartDate, accEndDate))
 	{
 	}
 
@@ -205,7 +209,7 @@ namespace FlexYCF
         m_foreignFixingDateDiscountFactor(globalComponentCache.get(DiscountFactor::Arguments(valueDate, startDate))),
 		m_domesticSpotFxDateDiscountFactor(globalComponentCache.get(DiscountFactor::Arguments(valueDate, spotFxDate, ccy, index))),
         m_foreignSpotFxDateDiscountFactor(globalComponentCache.get(DiscountFactor::Arguments(valueDate, spotFxDate))),
-		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(accrualBasis->getDaysOverBasis(accStartDate, accEndDate))
+		m_accStartDate(accStartDate), m_accEndDate(accEndDate), m_accrualBasis(accrualBasis), m_coverage(globalComponentCache.getDaysOverBasis(accrualBasis, accStartDate, accEndDate))
     {
     }
      
@@ -24,6 +24,7 @@ namespace QDDate
 namespace FlexYCF
 {
     class GlobalComponentCache;
+    class YearFractionTable;
 
 
     /// DiscountedForwardRateArguments encapsulates all the parameters
@@ -35,6 +36,8 @@ namespace FlexYCF
     class DiscountedForwardRateArguments
     {
     public:
+		/// The constructors without a cache take the year fraction table of the accrual basis,
+		/// if any, resolved once for all the cash-flows of a leg (see YearFractionTable::get)
 		DiscountedForwardRateArguments(const LT::date valueDate,
                                        const LT::date fixingDate,
                                        const LT::date startDate,
@@ -44,7 +47,8 @@ namespace FlexYCF
                                        const LT::date payDate,
                                        const std::string& tenorDescription,
                                        const ModuleDate::DayCounterConstPtr rateBasis,
-                                       const ModuleDate::DayCounterConstPtr accrualBasis);
+                                       const ModuleDate::DayCounterConstPtr accrualBasis,
+                                       const YearFractionTable* const accrualTable);
 
         DiscountedForwardRateArguments(const LT::date valueDate,
                                        const LT::date fixingDate,
@@ -80,6 +84,7 @@ namespace FlexYCF
                                        const std::string& tenorDescription,
                                        const ModuleDate::DayCounterConstPtr rateBasis,
                                        const ModuleDate::DayCounterConstPtr accrualBasis,
+                                       const YearFractionTable* const accrualTable,
                                        const LTQC::Currency& ccy,
                                        const LT::Str& index);
         
@@ -125,6 +130,19 @@ namespace FlexYCF
             }
         };
 
+        /// Hash functor consistent with Compare, used by CacheStorageHash
+        struct Hash
+        {
+            size_t operator()(const DiscountedForwardRateArguments& discountedForwardRateArgs) const
+            {
+                size_t seed(0);
+                boost::hash_combine(seed, discountedForwardRateArgs.m_coverage);
+                boost::hash_combine(seed, ForwardRateArguments::Hash()(discountedForwardRateArgs.m_forwardRate->getArguments()));
+                boost::hash_combine(seed, DiscountFactorArguments::Hash()(discountedForwardRateArgs.m_discountFactor->getArguments()));
+                return seed;
+            }
+        };
+
         bool operator==(const DiscountedForwardRateArguments& other) const
         {
             return *m_forwardRate == *(other.m_forwardRate)
@@ -180,6 +198,7 @@ namespace FlexYCF
                                        const std::string& tenorDescription,
                                        const ModuleDate::DayCounterConstPtr rateBasis,
                                        const ModuleDate::DayCounterConstPtr accrualBasis,
+                                       const YearFractionTable* const accrualTable,
                                        const LTQC::Currency& ccy,
                                        const LT::Str& index);
         
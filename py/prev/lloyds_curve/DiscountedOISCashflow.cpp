@@ -353,24 +353,13 @@ namespace FlexYCF
 		double covRatio = m_arguments.getCoverage()/m_arguments.getCoverageON();
 		double payDf = m_payDiscountFactor->getValue(baseModel);
 
-		double tmp = 0.0;
-		double startDf = m_endDatesTenorDiscountFactor[0]->getValue(baseModel);
-		for(size_t i=1; i < m_endDatesTenorDiscountFactor.size(); ++i)
-		{
-			double endDf = m_endDatesTenorDiscountFactor[i]->getValue(baseModel);
-			
-			if(i != m_endDatesTenorDiscountFactor.size() - 1)
-				tmp += startDf/endDf - 1.0;
-			else
-				tmp += m_cutoffAdj * (startDf/endDf - 1.0);
-			
-			startDf = endDf;
-		}
-		return covRatio * tmp * payDf;
+		return covRatio * computeDailyRatesSum(baseModel) * payDf;
     }
 
-    // As the discounted forward rate (DFR), is cov/covON * (startDf - endDf) * payDf/endDf, its gradient can be computed as:
-    //  grad(DFR) = ((grad(startDf) -grad(endDf))*payDf/endDf + (startDf-endDf)*(grad(payDf)*endDf - grad(endDf)*payDf)/endDf^2) * cov/covON 
+    // As the cash flow is cov/covON * sum(w(i) * (df(i-1)/df(i) - 1)) * payDf, its gradient can be computed as:
+    //  grad = cov/covON * (sum(d(sum)/d(df(k)) * grad(df(k))) * payDf + sum * grad(payDf))
+	//	where d(sum)/d(df(k)) = w(k+1)/df(k+1) - w(k) * df(k-1)/df(k)^2, so that each Tenor discount factor
+	//	accumulates its gradient once
     void DiscountedArithmeticOISCashflow::accumulateGradient(BaseModel const& baseModel, 
 												   double multiplier, 
 												   GradientIterator gradientBegin, 
@@ -378,24 +367,14 @@ namespace FlexYCF
     {
 		double covRatio = m_arguments.getCoverage()/m_arguments.getCoverageON();
 		double payDf = m_payDiscountFactor->getValue(baseModel);
+		const double sum = computeDailyRatesSum(baseModel);
+		computeDailyRatesSumDerivatives();
         
-		for(size_t i=1; i<m_endDatesTenorDiscountFactor.size(); ++i)
+		for(size_t k=0; k<m_endDatesTenorDiscountFactor.size(); ++k)
 		{
-			double startDf = m_endDatesTenorDiscountFactor[i-1]->getValue(baseModel);
-			double endDf = m_endDatesTenorDiscountFactor[i]->getValue(baseModel);
-			double payOverEnd = payDf/endDf;
-			if(i != m_endDatesTenorDiscountFactor.size() - 1)
-			{
-				m_endDatesTenorDiscountFactor[i-1]->accumulateGradient(baseModel, covRatio * multiplier * payOverEnd  , gradientBegin, gradientEnd);
-				m_endDatesTenorDiscountFactor[i]->accumulateGradient(baseModel,  -covRatio * multiplier * payOverEnd * startDf / endDf  , gradientBegin, gradientEnd);
-			}
-			else
-			{
-				m_endDatesTenorDiscountFactor[i-1]->accumulateGradient(baseModel, covRatio * multiplier * payOverEnd * m_cutoffAdj, gradientBegin, gradientEnd);
-				m_endDatesTenorDiscountFactor[i]->accumulateGradient(baseModel,  -covRatio * multiplier * payOverEnd * startDf / endDf * m_cutoffAdj, gradientBegin, gradientEnd);
-			}
+			m_endDatesTenorDiscountFactor[k]->accumulateGradient(baseModel, covRatio * multiplier * payDf * m_sumDerivatives[k], gradientBegin, gradientEnd);
 		}
-		m_payDiscountFactor->accumulateGradient(baseModel,   multiplier * getValue(baseModel)/payDf  , gradientBegin, gradientEnd);
+		m_payDiscountFactor->accumulateGradient(baseModel,   multiplier * covRatio * sum  , gradientBegin, gradientEnd);
     }
 
 	 void DiscountedArithmeticOISCashflow::accumulateGradient(BaseModel const& baseModel, 
@@ -406,51 +385,31 @@ namespace FlexYCF
 	 {
 		double covRatio = m_arguments.getCoverage()/m_arguments.getCoverageON();
 		double payDf = m_payDiscountFactor->getValue(baseModel);
+		const double sum = computeDailyRatesSum(baseModel);
+		computeDailyRatesSumDerivatives();
         
-		for(size_t i=1; i<m_endDatesTenorDiscountFactor.size(); ++i)
+		for(size_t k=0; k<m_endDatesTenorDiscountFactor.size(); ++k)
 		{
-			double startDf = m_endDatesTenorDiscountFactor[i-1]->getValue(baseModel);
-			double endDf = m_endDatesTenorDiscountFactor[i]->getValue(baseModel);
-			double payOverEnd = payDf/endDf;
-			if(i != m_endDatesTenorDiscountFactor.size() - 1)
-			{
-				m_endDatesTenorDiscountFactor[i-1]->accumulateGradient(baseModel, covRatio * multiplier * payOverEnd  , gradientBegin, gradientEnd, curveType);
-				m_endDatesTenorDiscountFactor[i]->accumulateGradient(baseModel,  -covRatio * multiplier * payOverEnd * startDf / endDf  , gradientBegin, gradientEnd, curveType);
-			}
-			else
-			{
-				m_endDatesTenorDiscountFactor[i-1]->accumulateGradient(baseModel, covRatio * multiplier * payOverEnd * m_cutoffAdj, gradientBegin, gradientEnd,curveType);
-				m_endDatesTenorDiscountFactor[i]->accumulateGradient(baseModel,  -covRatio * multiplier * payOverEnd * startDf / endDf * m_cutoffAdj, gradientBegin, gradientEnd,curveType);
-			}
+			m_endDatesTenorDiscountFactor[k]->accumulateGradient(baseModel, covRatio * multiplier * payDf * m_sumDerivatives[k], gradientBegin, gradientEnd, curveType);
 		}
-		m_payDiscountFactor->accumulateGradient(baseModel,   multiplier * getValue(baseModel)/payDf  , gradientBegin, gradientEnd, curveType);
+		m_payDiscountFactor->accumulateGradient(baseModel,   multiplier * covRatio * sum  , gradientBegin, gradientEnd, curveType);
 	 }
 	
 	void DiscountedArithmeticOISCashflow::accumulateGradientConstantDiscountFactor(BaseModel const& baseModel, BaseModel const& dfModel, double multiplier, GradientIterator gradientBegin, GradientIterator gradientEnd, bool spread)
 	{
 		double covRatio = m_arguments.getCoverage()/m_arguments.getCoverageON();
 		double payDf = m_payDiscountFactor->getValue(baseModel);
+		const double sum = computeDailyRatesSum(baseModel);
+		computeDailyRatesSumDerivatives();
         
-		for(size_t i=1; i<m_endDatesTenorDiscountFactor.size(); ++i)
+		for(size_t k=0; k<m_endDatesTenorDiscountFactor.size(); ++k)
 		{
-			double startDf = m_endDatesTenorDiscountFactor[i-1]->getValue(baseModel);
-			double endDf = m_endDatesTenorDiscountFactor[i]->getValue(baseModel);
-			double payOverEnd = payDf/endDf;
-			if(i != m_endDatesTenorDiscountFactor.size() - 1)
-			{
-				m_endDatesTenorDiscountFactor[i-1]->accumulateGradient(baseModel, covRatio * multiplier * payOverEnd  , gradientBegin, gradientEnd);
-				m_endDatesTenorDiscountFactor[i]->accumulateGradient(baseModel,  -covRatio * multiplier * payOverEnd * startDf / endDf  , gradientBegin, gradientEnd);
-			}
-			else
-			{
-				m_endDatesTenorDiscountFactor[i-1]->accumulateGradient(baseModel, covRatio * multiplier * payOverEnd  * m_cutoffAdj, gradientBegin, gradientEnd);
-				m_endDatesTenorDiscountFactor[i]->accumulateGradient(baseModel,  -covRatio * multiplier * payOverEnd * startDf / endDf  * m_cutoffAdj, gradientBegin, gradientEnd);
-			}
+			m_endDatesTenorDiscountFactor[k]->accumulateGradient(baseModel, covRatio * multiplier * payDf * m_sumDerivatives[k], gradientBegin, gradientEnd);
 		}
 		if( spread )
 		{
 			double  spreadDf = dfModel.getSpreadDiscountFactor(m_payDiscountFactor->getArguments().getFlowTime());
-			m_payDiscountFactor->accumulateGradient(baseModel,  multiplier * getValue(baseModel) / payDf * spreadDf,gradientBegin, gradientEnd);
+			m_payDiscountFactor->accumulateGradient(baseModel,  multiplier * covRatio * sum * spreadDf,gradientBegin, gradientEnd);
 		}
 	}
 
@@ -459,44 +418,70 @@ namespace FlexYCF
 	{
 		double covRatio = m_arguments.getCoverage()/m_arguments.getCoverageON();
 		double payDf = m_payDiscountFactor->getValue(baseModel);
+		const double sum = computeDailyRatesSum(baseModel);
+		computeDailyRatesSumDerivatives();
         
-		for(size_t i=1; i<m_endDatesTenorDiscountFactor.size(); ++i)
+		for(size_t k=0; k<m_endDatesTenorDiscountFactor.size(); ++k)
 		{
-			double startDf = m_endDatesTenorDiscountFactor[i-1]->getValue(baseModel);
-			double endDf = m_endDatesTenorDiscountFactor[i]->getValue(baseModel);
-			double payOverEnd = payDf/endDf;
-			if(i != m_endDatesTenorDiscountFactor.size() - 1)
-			{
-				m_endDatesTenorDiscountFactor[i-1]->accumulateGradientConstantTenorDiscountFactor(baseModel, dfModel, covRatio * multiplier * payOverEnd  , gradientBegin, gradientEnd, spread);
-				m_endDatesTenorDiscountFactor[i]->accumulateGradientConstantTenorDiscountFactor(baseModel,  dfModel, -covRatio * multiplier * payOverEnd * startDf / endDf  , gradientBegin, gradientEnd, spread);
-			}
-			else
-			{
-				m_endDatesTenorDiscountFactor[i-1]->accumulateGradientConstantTenorDiscountFactor(baseModel, dfModel, covRatio * multiplier * payOverEnd  * m_cutoffAdj, gradientBegin, gradientEnd, spread);
-				m_endDatesTenorDiscountFactor[i]->accumulateGradientConstantTenorDiscountFactor(baseModel,  dfModel, -covRatio * multiplier * payOverEnd * startDf / endDf * m_cutoffAdj, gradientBegin, gradientEnd, spread);
-			}
+			m_endDatesTenorDiscountFactor[k]->accumulateGradientConstantTenorDiscountFactor(baseModel, dfModel, covRatio * multiplier * payDf * m_sumDerivatives[k], gradientBegin, gradientEnd, spread);
 		}
-		m_payDiscountFactor->accumulateGradient(baseModel,  multiplier * getValue(baseModel) / payDf, gradientBegin, gradientEnd);
+		m_payDiscountFactor->accumulateGradient(baseModel,  multiplier * covRatio * sum, gradientBegin, gradientEnd);
 	}
 
 	double DiscountedArithmeticOISCashflow::getRate(const BaseModel& baseModel)
 	{
-		double tmp = 0.0;
-		double startDf = m_endDatesTenorDiscountFactor[0]->getValue(baseModel);
-		for(size_t i=1; i<m_endDatesTenorDiscountFactor.size(); ++i)
+		return computeDailyRatesSum(baseModel)/m_arguments.getCoverageON();
+	}
+
+	void DiscountedArithmeticOISCashflow::initializeDailyRates()
+	{
+		const size_t numberOfDates(m_endDatesTenorDiscountFactor.size());
+		m_flowTimes.resize(numberOfDates);
+		m_weights.assign(numberOfDates, 1.0);
+		m_tenor = (numberOfDates == 0 ? 0.0 : m_endDatesTenorDiscountFactor[0]->getArguments().getTenor());
+
+		for(size_t i=0; i<numberOfDates; ++i)
 		{
-			double endDf = m_endDatesTenorDiscountFactor[i]->getValue(baseModel);
-			if(i != m_endDatesTenorDiscountFactor.size() - 1)
-			{
-				tmp += startDf/endDf - 1.0;
-			}
-			else
-			{
-				tmp += m_cutoffAdj * (startDf/endDf - 1.0);
-			}
-			startDf = endDf;
+			m_flowTimes[i] = m_endDatesTenorDiscountFactor[i]->getArguments().getFlowTime();
+		}
+		if(numberOfDates > 0)
+		{
+			m_weights[0] = 0.0;
+			m_weights[numberOfDates - 1] = (numberOfDates > 1 ? m_cutoffAdj : 0.0);
+		}
+	}
+
+	double DiscountedArithmeticOISCashflow::computeDailyRatesSum(const BaseModel& baseModel)
+	{
+		//	Same dispatch as the Tenor discount factors: the model only sees the currency and the index if both are set
+		const LTQC::Currency ccy(m_arguments.getCurrency());
+		const LT::Str index(m_arguments.getIndex());
+		if(!ccy.empty() && !index.empty())
+		{
+			baseModel.getTenorDiscountFactors(m_flowTimes, m_tenor, ccy, index, m_discountFactors);
+		}
+		else
+		{
+			baseModel.getTenorDiscountFactors(m_flowTimes, m_tenor, m_discountFactors);
+		}
+
+		double sum = 0.0;
+		for(size_t i=1; i<m_discountFactors.size(); ++i)
+		{
+			sum += m_weights[i] * (m_discountFactors[i-1]/m_discountFactors[i] - 1.0);
+		}
+		return sum;
+	}
+
+	void DiscountedArithmeticOISCashflow::computeDailyRatesSumDerivatives()
+	{
+		m_sumDerivatives.assign(m_discountFactors.size(), 0.0);
+		for(size_t i=1; i<m_discountFactors.size(); ++i)
+		{
+			const double weightOverEnd = m_weights[i]/m_discountFactors[i];
+			m_sumDerivatives[i-1] += weightOverEnd;
+			m_sumDerivatives[i]   -= weightOverEnd * m_discountFactors[i-1]/m_discountFactors[i];
 		}
-		return tmp/m_arguments.getCoverageON();
 	}
 
     void DiscountedArithmeticOISCashflow::update()
@@ -526,11 +511,12 @@ namespace FlexYCF
 	{
 		double covRatio = m_arguments.getCoverage()/m_arguments.getCoverageON();
 		double payDf = m_payDiscountFactor->getValue(model);
+		computeDailyRatesSum(model);
         
 		for(size_t i=1; i<m_endDatesTenorDiscountFactor.size(); ++i)
 		{
-			double startDf = m_endDatesTenorDiscountFactor[i-1]->getValue(model);
-			double endDf = m_endDatesTenorDiscountFactor[i]->getValue(model);
+			double startDf = m_discountFactors[i-1];
+			double endDf = m_discountFactors[i];
 			double payOverEnd = payDf/endDf;
 			if(i != m_endDatesTenorDiscountFactor.size() - 1)
 			{
@@ -577,7 +563,11 @@ namespace FlexYCF
         m_startDateTenorDiscountFactor(lookup.get(original.m_startDateTenorDiscountFactor)),
         m_endDateTenorDiscountFactor(lookup.get(original.m_endDateTenorDiscountFactor)),
 		m_payDiscountFactor(lookup.get(original.m_payDiscountFactor)),
-		m_cutoffAdj(original.m_cutoffAdj)
+		m_endDatesTenorDiscountFactor(original.m_endDatesTenorDiscountFactor.size()),
+		m_cutoffAdj(original.m_cutoffAdj),
+		m_flowTimes(original.m_flowTimes),
+		m_weights(original.m_weights),
+		m_tenor(original.m_tenor)
     {
 		for(size_t i=0; i<m_endDatesTenorDiscountFactor.size(); ++i)
 		{
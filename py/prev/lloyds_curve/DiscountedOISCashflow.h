@@ -215,6 +215,7 @@ namespace FlexYCF
 			{
 				 m_endDatesTenorDiscountFactor.push_back(TenorDiscountFactor::create(TenorDiscountFactorArguments(arguments.getValueDate(), endDates[i] , "1b", arguments.getCurrency(), arguments.getIndex())));
 			}
+			initializeDailyRates();
         }
 
         static DiscountedArithmeticOISCashflowPtr create(const Arguments& arguments)
@@ -284,6 +285,25 @@ namespace FlexYCF
 		 
 		std::vector<TenorDiscountFactorPtr>	m_endDatesTenorDiscountFactor;
 		double m_cutoffAdj;
+
+		//	Computes the flow times and the weights of the daily rates,
+		//	which do not change during the calibration
+		void initializeDailyRates();
+
+		//	Computes the Tenor discount factors at the end dates with one call
+		//	to the model and returns the weighted sum of the daily rates times
+		//	their coverage: sum of weight(i) * (df(i-1)/df(i) - 1)
+		double computeDailyRatesSum(const BaseModel& baseModel);
+
+		//	Computes the derivatives of the sum of the daily rates with respect
+		//	to each Tenor discount factor computed by computeDailyRatesSum
+		void computeDailyRatesSumDerivatives();
+
+		std::vector<double>	m_flowTimes;			// of the end dates
+		std::vector<double>	m_weights;				// of the daily rate ending at each end date, 0 for the first one
+		double				m_tenor;
+		std::vector<double>	m_discountFactors;		// buffers reused by each evaluation
+		std::vector<double>	m_sumDerivatives;
     };  
 }   //  FlexYCF
 
@@ -3,6 +3,7 @@
 #include "ModuleDate/InternalInterface/DayCounter.h"
 #include "DateUtils.h"
 #include "GlobalComponentCache.h"
+#include "YearFractionTable.h"
 
 using namespace std;
 
@@ -18,14 +19,16 @@ namespace FlexYCF
 															   const LT::Str& payCalendar,
 															   const ModuleDate::DayCounterConstPtr basisON,
 															   const ModuleDate::DayCounterConstPtr basisCashflow,
+															   const YearFractionTable* const tableON,
+															   const YearFractionTable* const tableCashflow,
                                                                const LTQC::Currency& ccy, 
                                                                const LT::Str& index):
         m_startDate(startDate), 
 		m_endDate(endDate), 
 		m_valueDate(valueDate),
 		m_payDate(endDate),
-		m_coverageON(basisON->getDaysOverBasis(startDate, endDate)),
-		m_coverage(basisCashflow->getDaysOverBasis(startDate, endDate)),
+		m_coverageON(YearFractionTable::getDaysOverBasis(tableON, basisON, startDate, endDate)),
+		m_coverage(YearFractionTable::getDaysOverBasis(tableCashflow, basisCashflow, startDate, endDate)),
         m_ccy(ccy),
         m_index(index)
 	{
@@ -65,7 +68,7 @@ namespace FlexYCF
         m_startDate(startDate), 
 		m_endDate(endDate), 
 		m_valueDate(valueDate),
-		m_coverage(basisCashflow->getDaysOverBasis(startDate, endDate)),
+		m_coverage(YearFractionTable::getDaysOverBasis(basisCashflow, startDate, endDate)),
         m_ccy(ccy),
         m_index(index)
 	{
@@ -112,8 +115,8 @@ namespace FlexYCF
 		m_cutoff(cutoff),
 		m_accrualCalendar(accrualCalendar),
 		m_cutOffAdj(1.0),
-		m_coverageON(basisON->getDaysOverBasis(startDate, endDate)),
-		m_coverage(basisCashflow->getDaysOverBasis(startDate, endDate)),
+		m_coverageON(YearFractionTable::getDaysOverBasis(basisON, startDate, endDate)),
+		m_coverage(YearFractionTable::getDaysOverBasis(basisCashflow, startDate, endDate)),
         m_ccy(ccy),
         m_index(index)
 	{
@@ -144,6 +147,9 @@ namespace FlexYCF
 		
 		if(m_cutoff != 1)
 		{
+			// the overnight coverages are looked up in the year fraction table of the basis, if any
+			const YearFractionTableConstPtr tableON(YearFractionTable::get(basisON));
+
 			// use only the first rate
 			if(m_cutoff >= m_endDates.size() - 1)
 			{
@@ -153,11 +159,11 @@ namespace FlexYCF
 				for(size_t i=1; i<m_endDates.size(); ++i)
 				{
 					LT::date endON = m_endDates[i];
-					adj += basisON->getDaysOverBasis(startON, endON);
+					adj += YearFractionTable::getDaysOverBasis(tableON.get(), basisON, startON, endON);
 					startON = endON;
 				}
 
-				m_cutOffAdj = adj / basisON->getDaysOverBasis(m_endDates[0], m_endDates[1]);
+				m_cutOffAdj = adj / YearFractionTable::getDaysOverBasis(tableON.get(), basisON, m_endDates[0], m_endDates[1]);
 				auto it = m_endDates.begin(), itEnd = m_endDates.end();
 				std::advance(it,2);
 				m_endDates.erase(it,itEnd);
@@ -172,14 +178,14 @@ namespace FlexYCF
 				while(i > 0)
 				{
 					LT::date startON = m_endDates[k];
-					adj += basisON->getDaysOverBasis(startON, endON);
+					adj += YearFractionTable::getDaysOverBasis(tableON.get(), basisON, startON, endON);
 					endON = startON;
 
 					--i;
 					--k;
 				}
 				
-				m_cutOffAdj = adj / basisON->getDaysOverBasis(m_endDates[k+1], m_endDates[k+2]);
+				m_cutOffAdj = adj / YearFractionTable::getDaysOverBasis(tableON.get(), basisON, m_endDates[k+1], m_endDates[k+2]);
 				auto it = m_endDates.begin(), itEnd = m_endDates.end();
 				std::advance(it, m_endDates.size() + 1 - m_cutoff);
 				m_endDates.erase(it,itEnd);
@@ -16,10 +16,13 @@ namespace ModuleDate
 namespace FlexYCF
 {
     class GlobalComponentCache;
+    class YearFractionTable;
 
     class DiscountedOISCashflowArguments
     {
     public:
+		/// Takes the year fraction tables of the bases, if any, resolved once
+		/// for all the cash-flows of a leg (see YearFractionTable::get)
         DiscountedOISCashflowArguments(const LT::date& valueDate,
 									   const LT::date& startDate,
 									   const LT::date& endDate,
@@ -27,6 +30,8 @@ namespace FlexYCF
 									   const LT::Str& payCalendar,
 									   const ModuleDate::DayCounterConstPtr basisON,
 									   const ModuleDate::DayCounterConstPtr basisCashflow,
+									   const YearFractionTable* const tableON,
+									   const YearFractionTable* const tableCashflow,
                                        const LTQC::Currency& ccy= "", 
                                        const LT::Str& index = "");
         
@@ -143,9 +143,9 @@ namespace
 		// Create a global component cache
 		GlobalComponentCache gcc;
 		
-		// Set it for global access (otherwise the program may crash
-		// when calling getGlobalComponentCache())
-		InstrumentComponent::setGlobalComponentCache(&gcc);
+		// Set it for global access on this thread (otherwise the program may
+		// crash when calling getGlobalComponentCache())
+		const InstrumentComponent::GlobalCacheScope cacheScope(&gcc);
 
 		std::string instrumentType;
 		LTQuant::GenericDataPtr instrumentTable;
@@ -13,6 +13,7 @@
 //	FlexYCF
 #include "FixedCashFlowArguments.h"
 #include "GlobalComponentCache.h"
+#include "YearFractionTable.h"
 #include "FlexYCFCloneLookup.h"
 
 using namespace std;
@@ -29,7 +30,7 @@ namespace FlexYCF
 												   const ModuleDate::DayCounterConstPtr basis):
 		m_discountFactorArguments(DiscountFactor::Arguments(valueDate, payDate)),
 		m_discountFactor(DiscountFactor::create(m_discountFactorArguments)),
-        m_coverage(basis->getDaysOverBasis(setDate, payDate)),
+        m_coverage(YearFractionTable::getDaysOverBasis(basis, setDate, payDate)),
         m_rate(rate),
         m_setDate(setDate)
 	{
@@ -43,7 +44,7 @@ namespace FlexYCF
                                                    GlobalComponentCache& globalComponentCache):
         m_discountFactorArguments(DiscountFactor::Arguments(valueDate, payDate)),
         m_discountFactor(globalComponentCache.get(m_discountFactorArguments)),
-        m_coverage(basis->getDaysOverBasis(setDate, payDate)),
+        m_coverage(globalComponentCache.getDaysOverBasis(basis, setDate, payDate)),
         m_rate(rate),
         m_setDate(setDate)
     {
@@ -19,8 +19,11 @@
 #include "ModuleDate/InternalInterface/ScheduleGeneratorFactory.h"
 #include "ModuleDate/InternalInterface/DayCounter.h"
 #include "GlobalComponentCache.h"
+#include "YearFractionTable.h"
 #include "RepFlowsData.h"
 #include "FlexYCFCloneLookup.h"
+#include "ScheduleCache.h"
+#include "PortfolioCashFlows.h"
 
 #include "RollConv.h"
 #include "dates/DateBuilderGenerator.h"
@@ -118,6 +121,39 @@ namespace FlexYCF
 	}
 
 
+	void FixedLeg::fillPortfolioCashFlows(PortfolioCashFlows& cashFlows, const double multiplier)
+	{
+		initializeCashFlows();
+
+		// if m_cvg is provided, ignore m_scheduleDates
+		vector<double> coverages(m_cvg);
+		if(coverages.empty())
+		{
+			getCoverages(coverages);
+		}
+
+		vector<Date>::const_iterator itPayment(m_paymentDates.begin());
+		for(vector<double>::const_iterator itCoverage(coverages.begin()); itCoverage != coverages.end(); ++itCoverage, ++itPayment)
+		{
+			cashFlows.addFixedCashFlow(multiplier * (*itCoverage), itPayment->getAsLTdate());
+		}
+	}
+
+	void FixedLeg::getCoverages(vector<double>& coverages) const
+	{
+		const ModuleDate::DayCounterConstPtr basis(arguments().getBasis());
+
+		// the coverages of all the periods are looked up at once in the year fraction table of the basis
+		if(InstrumentComponent::getUseCacheFlag())
+		{
+			getGlobalComponentCache()->getDaysOverBasis(basis, m_scheduleDates, coverages);
+		}
+		else
+		{
+			YearFractionTable::getDaysOverBasis(basis, m_scheduleDates, coverages);
+		}
+	}
+
 	void FixedLeg::initializeCashFlows()
 	{
 		using namespace LTQuant;
@@ -132,27 +168,21 @@ namespace FlexYCF
 
 		if(m_scheduleDates.empty() && m_cvg.empty())
 		{
-			const string tenorDescription(arguments().getTenorDescription());
-
-			// ON & 1D are NOT handled by ScheduleGenerator,
-			//  so they are interpreted as 1M for now.
-	        LTQC::Tenor tenor(tenorDescription == "ON" || tenorDescription == "1D" ? "1M" : tenorDescription);
-
-			LTQC::DateBuilderGenerator fixedGen(LTQC::DateBuilder(arguments().getStartDate(), 
-																	   arguments().getEndDate(), 
-																	   tenor, 
-																	   arguments().getCalendarString(), 
-																	   arguments().getStubType(),
-																	   Date(), 
-																	   arguments().getRollConvMethod(),    
-																	   arguments().getRollRuleMethod(), 
-																	   LT::Str("1w"), 
-																	   LTQC::RollConv(LTQC::RollConvMethod::None),
-																	   arguments().payDelay(),
-																	   arguments().payCalendar(),
-																	   arguments().payRollConvention()));	
+			// the schedule is generated once for all the legs with the same dates and conventions
+			const LegScheduleConstPtr schedule(ScheduleCache::get(ScheduleArguments(arguments().getStartDate(),
+																					 arguments().getEndDate(),
+																					 arguments().getTenorDescription(),
+																					 arguments().getCalendarString(),
+																					 arguments().getStubType(),
+																					 arguments().getRollConvMethod(),
+																					 arguments().getRollRuleMethod(),
+																					 arguments().payDelay(),
+																					 arguments().payCalendar(),
+																					 arguments().payRollConvention()),
+																	 arguments().getValueDate()));
 			// fill the payment dates
-			fixedGen.fillEvents(m_scheduleDates, m_paymentDates, arguments().getStartDate(), arguments().getEndDate());
+			m_scheduleDates = schedule->scheduleDates;
+			m_paymentDates = schedule->paymentDates;
 		}
 
 	}
@@ -162,18 +192,21 @@ namespace FlexYCF
 		if(m_cashFlows.empty())
 		{
 			const LT::date valueDate(arguments().getValueDate());
-			const ModuleDate::DayCounterConstPtr basis(arguments().getBasis());
             const LT::Str& ccy = arguments().currency();
             const LT::Str& mkt = arguments().market();
 			// fill the cash-flows
 			vector<Date>::const_iterator itPayment = m_paymentDates.begin();
 			if (m_cvg.empty())
 			{
-				for(ModuleDate::Schedule::ScheduleEvents::const_iterator iter(m_scheduleDates.begin()); iter != m_scheduleDates.end(); ++iter, ++itPayment)
+				vector<double> coverages;
+				getCoverages(coverages);
+
+				vector<double>::const_iterator itCoverage = coverages.begin();
+				for(ModuleDate::Schedule::ScheduleEvents::const_iterator iter(m_scheduleDates.begin()); iter != m_scheduleDates.end(); ++iter, ++itPayment, ++itCoverage)
 				{
 					const LT::date& paymentDate = (*itPayment).getAsLTdate();
 					m_cashFlows.push_back  (
-						CvgDfPair(	basis->getDaysOverBasis(iter->begin(), iter->end()), 
+						CvgDfPair(	*itCoverage, 
 										(InstrumentComponent::getUseCacheFlag()
 										? getGlobalComponentCache()->get(DiscountFactor::Arguments(valueDate, paymentDate, ccy, mkt))
 										: DiscountFactor::create(DiscountFactorArguments(valueDate, paymentDate, ccy, mkt)))
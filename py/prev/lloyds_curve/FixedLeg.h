@@ -23,6 +23,8 @@ namespace FlexYCF
 {
     FWD_DECLARE_SMART_PTRS( FixedLeg )
 
+	class PortfolioCashFlows;
+
     /// Represents a fixed leg as collection of
     /// (year fraction, discount factor).
     /// Note: the fixed leg schedule is constructed
@@ -99,6 +101,10 @@ namespace FlexYCF
 								  const double multiplier,
 								  IDeA::RepFlowsData<IDeA::Funding>& fundingRepFlows);
 
+		/// Adds the cash-flows of the leg, multiplied by the multiplier, to the
+		/// cash flows of a book, without creating the discount factors
+		void fillPortfolioCashFlows(PortfolioCashFlows& cashFlows, const double multiplier);
+
         virtual std::ostream& print(std::ostream& out) const;        
 
         virtual ICloneLookupPtr cloneWithLookup(CloneLookup& lookup) const;
@@ -140,6 +146,9 @@ namespace FlexYCF
 										  const BaseModel& model,
 										  LTQuant::GenericData& cashFlowPVsTable);
 
+		// computes the coverages of the periods of the schedule
+		void getCoverages(std::vector<double>& coverages) const;
+
         CvgDfContainer  m_cashFlows;
 
 		std::vector<double> m_cvg;
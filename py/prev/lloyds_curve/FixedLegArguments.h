@@ -15,6 +15,8 @@
 
 #include "IDeA\src\market\MarketConvention.h"
 
+#include <boost/functional/hash.hpp>
+
 namespace QDDate
 {
     FWD_DECLARE_SMART_PTRS( DayCounter )
@@ -114,6 +116,21 @@ namespace FlexYCF
             }
         };
 
+        /// Hash functor consistent with Compare, used by CacheStorageHash.
+        /// The case insensitive fields are not hashed
+        struct Hash
+        {
+            size_t operator()(const FixedLegArguments& fixedLegArgs) const
+            {
+                size_t seed(0);
+                boost::hash_combine(seed, fixedLegArgs.m_tenorDescription);
+                boost::hash_combine(seed, fixedLegArgs.m_startDate.day_number());
+                boost::hash_combine(seed, fixedLegArgs.m_endDate.day_number());
+                boost::hash_combine(seed, fixedLegArgs.m_calendarString);
+                return seed;
+            }
+        };
+
         // used by CalculationCache -- NOT VALID AS IT IS
         bool operator==(const FixedLegArguments& /* other */) const
         {
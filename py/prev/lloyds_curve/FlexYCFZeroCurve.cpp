@@ -40,6 +40,11 @@
 #include "ModelSelection.h"
 #include "FlexYCFCloneLookup.h"
 #include "SpineDataCache.h"
+#include "SpineDataSnapshot.h"
+#include "BuildProfile.h"
+#include "BuildArena.h"
+#include "PerformanceTracker.h"
+#include "BumpScenarioEngine.h"
 
 //	LTQuantLib
 #include "Maths/LevenbergMarquardtSolver.h"
@@ -53,6 +58,10 @@
 // ModuleStaticData
 #include "ModuleStaticData/InternalInterface/IRIndexProperties.h"
 
+#include <cmath>
+#include <sstream>
+#include <boost/thread/tss.hpp>
+
 using namespace LTQC;
 using namespace std;
 using namespace IDeA;
@@ -100,11 +109,10 @@ namespace FlexYCF
 			LTQC::VectorDouble shockedRates(oldPartialInstruments.size());
 
 			// Get the rates of the target curve
-			//	Remember existing cache to set it back later (create a RAII class for that, for proper handling when exceptions occur)
-			GlobalComponentCache* const existingCache(InstrumentComponent::getGlobalComponentCache());
-			
-			//	Create a new cache:
-			const GlobalComponentCache cache(GlobalComponentCache::createCache(newMasterTable));
+			//	Create a new cache and bind it to this thread, the existing
+			//	cache being set back when the scope is left
+			GlobalComponentCache cache(GlobalComponentCache::createCache(newMasterTable));
+			const InstrumentComponent::GlobalCacheScope cacheScope(&cache);
 
 			//	Update the instrument list with the shifted rates
 			//CalibrationInstrumentFactory::loadInstrumentList(shockedInstruments, shiftedMasterTable, cache); 
@@ -116,11 +124,49 @@ namespace FlexYCF
 				shockedRates[k] = oldPartialInstruments[k]->getDifferenceWithNewRate(*instrumentListData);
 			}
 
-			//	Set the cache back to what it was
-			InstrumentComponent::setGlobalComponentCache(existingCache);
-
 			return shockedRates;
 		}
+
+		//	Records the profile of a build or refresh of the curve to its performance
+		//	tracker, unless the profile of the curve is already being recorded (e.g.
+		//	for a refresh that falls back on a full rebuild)
+		class BuildProfileRecorder: private DevCore::NonCopyable
+		{
+		public:
+			BuildProfileRecorder(const void* const curve,
+								 FlexYCF::PerformanceTrackerPtr& performanceTracker,
+								 const string& curveName):
+				m_isRecording(BuildProfile::isEnabled() && !(BuildProfile::current() && BuildProfile::current()->getOwner() == curve)),
+				m_profile(curve),
+				m_scope(m_isRecording ? &m_profile : BuildProfile::current()),
+				m_performanceTracker(performanceTracker),
+				m_curveName(curveName)
+			{
+			}
+
+			~BuildProfileRecorder()
+			{
+				if(m_isRecording)
+				{
+					if(!m_performanceTracker)
+					{
+						m_performanceTracker.reset(new FlexYCF::PerformanceTracker);
+					}
+					m_profile.addTo(*m_performanceTracker);
+
+					ostringstream profile;
+					m_profile.print(profile);
+					LT_LOG << "Build profile for " << m_curveName << endl << profile.str();
+				}
+			}
+
+		private:
+			const bool							m_isRecording;
+			BuildProfile						m_profile;
+			const BuildProfile::Scope			m_scope;
+			FlexYCF::PerformanceTrackerPtr&		m_performanceTracker;
+			const string						m_curveName;
+		};
     }
 }
 
@@ -130,6 +176,16 @@ namespace LTQuant
 {
     using namespace FlexYCF;
 
+    namespace
+    {
+        //	The notifications are owned by the deferral scopes, not by the threads
+        void doNotDelete(FlexYCFZeroCurve::DeferredNotifications*)
+        {
+        }
+
+        boost::thread_specific_ptr<FlexYCFZeroCurve::DeferredNotifications> s_deferredNotifications(&doNotDelete);
+    }
+
     FlexYCFZeroCurve::FlexYCFZeroCurve(PriceSupplier* parent, GenericIRMarketDataPtr marketData, const string& constructionMethod, ModuleStaticData::IRIndexPropertiesPtr indexProp) : 
         ZeroCurve(parent, marketData->getValueDate(), indexProp),
         m_marketData(marketData),
@@ -243,13 +299,17 @@ namespace LTQuant
 
         // Irrelevant what value is used here as it is overwritten in the next solveCurve invocation
         m_solver->setState(BaseSolver::FIRST_SOLVING);
+
+		//	Release the instruments with no cache bound, leaving
+		//	the cache bound by the caller, if any, untouched
+		const InstrumentComponent::GlobalCacheScope cacheScope(0);
 		finishCalibInstruments();
-		InstrumentComponent::setGlobalComponentCache(0);
     }
 
 	// similar to BaseModelFactory::createBaseModel
     void FlexYCFZeroCurve::rebuildCurveFromData()
     {
+		const BuildProfileRecorder buildProfileRecorder(this, m_performanceTracker, m_marketData->getIndexName());
 
  		LTQuant::Timer firstTotalBuildTimer;
 		firstTotalBuildTimer.start();
@@ -299,9 +359,10 @@ namespace LTQuant
         // 0. Create the GlobalComponentCache here and use it in the CalibrationInstrumentFactory::loadInstrumentList function
         // ----------------------------------------------------------------------------------------------------------------------
 		
-		GlobalComponentCache* gcc = InstrumentComponent::getGlobalComponentCache();
+		//	The cache is bound to the calling thread only, so that curves
+		//	can be built concurrently, and unbound when leaving this scope
 		GlobalComponentCache globalComponentCache = GlobalComponentCache::createCache(masterTable, buildDate);
-		InstrumentComponent::setGlobalComponentCache(&globalComponentCache);
+		const InstrumentComponent::GlobalCacheScope cacheScope(&globalComponentCache);
 
         // ----------------------------------------------------------------------------------------------------------------------
         // 1. Load the calibration instruments
@@ -395,7 +456,10 @@ namespace LTQuant
 
 		LT_LOG << "First build from data for " << m_marketData->getIndexName() << " in " << firstSolvingTimerBuildData.getMilliseconds() << " ms" << endl;
 		
-        solveCurve();
+        if(!restoreFromSpineDataSnapshot())
+        {
+            solveCurve();
+        }
 		m_model->setCalibrated();
         calibrationInstrumentSetValues();
         // Set default refresh type
@@ -411,11 +475,6 @@ namespace LTQuant
         if(m_lightweightClone)
         {
             	finishCalibInstruments();
-                InstrumentComponent::setGlobalComponentCache(0);
-        }
-        else
-        {
-		    InstrumentComponent::setGlobalComponentCache(gcc);
         }
 	}
 
@@ -451,6 +510,7 @@ namespace LTQuant
         switch (m_refreshType) {
             case FlexYCF::FromSolver:
 		    case FlexYCF::FromJacobian:
+		    case FlexYCF::Incremental:
 		    {
                 if (!m_model->isJacobianSupported()) {
 					    LT_THROW_ERROR("Attempting to refresh from Solver, but model does not support it ");
@@ -467,6 +527,7 @@ namespace LTQuant
 
     void FlexYCFZeroCurve::refresh()
     {
+		const BuildProfileRecorder buildProfileRecorder(this, m_performanceTracker, m_marketData->getIndexName());
 		LTQuant::Timer refreshTimer;
 		refreshTimer.start();
 
@@ -487,61 +548,14 @@ namespace LTQuant
 		{
             switch (m_refreshType) {
             case FlexYCF::FromSolver:
-			{
+            {
+                    refreshFromSolver();
+            }
+            break;
 
-				    // Check that the date hasn't changed
-				    if(m_valueDate != m_marketData->getValueDate())
-				    {
-					    LT_THROW_ERROR("Market data has changed Date to " << m_marketData->getValueDate() << " from " << m_valueDate);
-				    }
-                
-                    //if we don't have instruments must rebuild
-                    //for this refresh from data
-                    //else can refresh
-                    if(!m_calibInstrumentsExist)
-                    {
-                    
-                        const GenericDataPtr masterTable(m_marketData->getData());
-						GlobalComponentCache* gcc = InstrumentComponent::getGlobalComponentCache();
-						GlobalComponentCache globalComponentCache = GlobalComponentCache::createCache(masterTable, m_valueDate);
-						InstrumentComponent::setGlobalComponentCache(&globalComponentCache);
-                        
-						FlexYCF::CalibrationInstrumentsPtr tmpFullInstruments;
-                        // ----------------------------------------------------------------------------------------------------------------------
-                        // 1. Load the calibration instruments
-                        // ----------------------------------------------------------------------------------------------------------------------
-                        tmpFullInstruments.reset(new CalibrationInstruments);
-                        CalibrationInstrumentFactory::loadInstrumentList(*tmpFullInstruments, 
-                            masterTable, 
-                            globalComponentCache,
-                            getParent());
-
-                        FlexYCF::CalibrationInstruments::iterator curFullInstr=m_fullInstruments->begin();
-                        FlexYCF::CalibrationInstruments::iterator curTmpInst=tmpFullInstruments->begin();
-                        for (;curFullInstr!=m_fullInstruments->end() && curTmpInst!=tmpFullInstruments->end();++curFullInstr,++curTmpInst)
-                        {
-                           if( (*curFullInstr)->getName()!=(*curTmpInst)->getName() || 
-                               (*curFullInstr)->getDescription()!=(*curTmpInst)->getDescription())
-                           {
-                               LTQC_THROW(IDeA::SystemException, "Different number/type of instruments between build/rebuild of curve!");
-                           }
-
-                           (*curFullInstr)->reloadInternalState(*curTmpInst);
-                        }
-
-                        CalibrationInstrumentFactory::updateInstrumentList(*m_fullInstruments, masterTable);
-
-                        m_calibInstrumentsExist=true;
-                        m_solver->setState(BaseSolver::REFRESHING);
-                        //this solve curve needs to be in the same scope as the cache above hence can't factor it out of the if/else
-                        solveCurve();
-						finishCalibInstruments();
-						InstrumentComponent::setGlobalComponentCache(gcc);
-                    }
-                    else
-                    {
-						rebuildFromGenericData();
-                    }
+            case FlexYCF::Incremental:
+            {
+                    refreshIncrementally();
             }
             break;
   
@@ -579,6 +593,223 @@ namespace LTQuant
     }
 
 
+	void FlexYCFZeroCurve::refreshFromSolver()
+	{
+		// Check that the date hasn't changed
+		if(m_valueDate != m_marketData->getValueDate())
+		{
+			LT_THROW_ERROR("Market data has changed Date to " << m_marketData->getValueDate() << " from " << m_valueDate);
+		}
+
+		//if we don't have instruments must rebuild
+		//for this refresh from data
+		//else can refresh
+		if(!m_calibInstrumentsExist)
+		{
+			//	The components reloaded here are all dropped by finishCalibInstruments
+			const BuildArena::Scope buildArenaScope;
+			GlobalComponentCache globalComponentCache = GlobalComponentCache::createCache(m_marketData->getData(), m_valueDate);
+			const InstrumentComponent::GlobalCacheScope cacheScope(&globalComponentCache);
+
+			reloadCalibInstruments(globalComponentCache);
+			m_solver->setState(BaseSolver::REFRESHING);
+			//this solve curve needs to be in the same scope as the cache above hence can't factor it out of the if/else
+			solveCurve();
+			finishCalibInstruments();
+		}
+		else
+		{
+			rebuildFromGenericData();
+		}
+	}
+
+	//	Reloads the internal state of the calibration instruments, emptied by
+	//	finishCalibInstruments, and sets their rates to the current market data.
+	//	The instruments can be valued as long as the cache is alive.
+	void FlexYCFZeroCurve::reloadCalibInstruments(GlobalComponentCache& globalComponentCache)
+	{
+		const GenericDataPtr masterTable(m_marketData->getData());
+
+		FlexYCF::CalibrationInstrumentsPtr tmpFullInstruments;
+		// ----------------------------------------------------------------------------------------------------------------------
+		// 1. Load the calibration instruments
+		// ----------------------------------------------------------------------------------------------------------------------
+		tmpFullInstruments.reset(new CalibrationInstruments);
+		CalibrationInstrumentFactory::loadInstrumentList(*tmpFullInstruments, 
+			masterTable, 
+			globalComponentCache,
+			getParent());
+
+		FlexYCF::CalibrationInstruments::iterator curFullInstr=m_fullInstruments->begin();
+		FlexYCF::CalibrationInstruments::iterator curTmpInst=tmpFullInstruments->begin();
+		for (;curFullInstr!=m_fullInstruments->end() && curTmpInst!=tmpFullInstruments->end();++curFullInstr,++curTmpInst)
+		{
+			if( (*curFullInstr)->getName()!=(*curTmpInst)->getName() || 
+				(*curFullInstr)->getDescription()!=(*curTmpInst)->getDescription())
+			{
+				LTQC_THROW(IDeA::SystemException, "Different number/type of instruments between build/rebuild of curve!");
+			}
+
+			(*curFullInstr)->reloadInternalState(*curTmpInst);
+		}
+
+		CalibrationInstrumentFactory::updateInstrumentList(*m_fullInstruments, masterTable);
+
+		m_calibInstrumentsExist=true;
+	}
+
+	//	Refreshes the model from the quotes that moved since the last build or refresh
+	//	only. The first-order step of refreshFromJacobian is solved against the (cached)
+	//	factorization of the jacobian, with a right-hand side that is non-zero for the
+	//	moved quotes only:
+	//
+	//								J[C/z]  x  dz  =  - Sum_j  dC_j/dR_j  x  dR_j  x  e_j
+	//
+	//	The residuals of all the instruments are then re-evaluated and the step corrected
+	//	by chord iterations against the same factorization, so that the linearization
+	//	error does not build up from a refresh to the next. The curve is re-solved when
+	//	the residuals do not converge, or when most of the quotes moved, since the sparse
+	//	step then brings nothing.
+	//	The instruments are kept loaded from a refresh to the next, so that a refresh
+	//	only sets the rates of the instruments whose quotes moved.
+	void FlexYCFZeroCurve::refreshIncrementally()
+	{
+		// Check that the date hasn't changed
+		if(m_valueDate != m_marketData->getValueDate())
+		{
+			LT_THROW_ERROR("Market data has changed Date to " << m_marketData->getValueDate() << " from " << m_valueDate);
+		}
+
+		//	The shifts are taken against the rates of the last build or refresh,
+		//	hence before the instruments are reloaded with the current rates
+		const LTQC::VectorDouble ratesShifts(createShockedRates(*m_partialInstruments, m_marketData->getData()));
+
+		vector<size_t> movedInstruments;
+		for(size_t j(0); j < ratesShifts.size(); ++j)
+		{
+			if(ratesShifts[j] != 0.0)
+			{
+				movedInstruments.push_back(j);
+			}
+		}
+
+		if(movedInstruments.empty())
+		{
+			return;
+		}
+
+		if(2 * movedInstruments.size() > ratesShifts.size())
+		{
+			refreshFromSolver();
+			return;
+		}
+
+		if(m_calibInstrumentsExist)
+		{
+			setMovedRates(ratesShifts, movedInstruments);
+			shiftOrSolve(ratesShifts, movedInstruments);
+		}
+		else
+		{
+			//	The instruments are only reloaded the first time, or after a refresh of
+			//	another type released them: the reloaded components outlive the refresh
+			GlobalComponentCache globalComponentCache = GlobalComponentCache::createCache(m_marketData->getData(), m_valueDate);
+			const InstrumentComponent::GlobalCacheScope cacheScope(&globalComponentCache);
+
+			reloadCalibInstruments(globalComponentCache);
+			shiftOrSolve(ratesShifts, movedInstruments);
+		}
+
+		m_model->setCalibrated();
+		calibrationInstrumentSetValues();
+
+		//	As after a build, lightweight clones do not hold on to their instruments
+		if(m_lightweightClone)
+		{
+			finishCalibInstruments();
+		}
+	}
+
+	//	Sets the rates of the moved instruments to their current quotes. The partial
+	//	instruments can be shared with the full instruments, hence the new rates are
+	//	set to both, not the shifts
+	void FlexYCFZeroCurve::setMovedRates(const LTQC::VectorDouble& ratesShifts, const vector<size_t>& movedInstruments)
+	{
+		vector<double> newRates(m_partialInstruments->size());
+		for(size_t j(0); j < m_partialInstruments->size(); ++j)
+		{
+			newRates[j] = (*m_partialInstruments)[j]->getRate() + ratesShifts[j];
+		}
+		for(size_t i(0), k(0); i < m_fullInstruments->size() && k < newRates.size(); ++i)
+		{
+			if((*m_fullInstruments)[i]->wasPlaced())
+			{
+				if(ratesShifts[k] != 0.0)
+				{
+					(*m_fullInstruments)[i]->setRate(newRates[k]);
+				}
+				++k;
+			}
+		}
+		for(vector<size_t>::const_iterator iter(movedInstruments.begin()); iter != movedInstruments.end(); ++iter)
+		{
+			(*m_partialInstruments)[*iter]->setRate(newRates[*iter]);
+		}
+	}
+
+	void FlexYCFZeroCurve::shiftOrSolve(const LTQC::VectorDouble& ratesShifts, const vector<size_t>& movedInstruments)
+	{
+		if(!shiftFromMovedInstruments(ratesShifts, movedInstruments))
+		{
+			LT_LOG << "Incremental refresh of " << m_marketData->getIndexName() << " did not converge, re-solving the curve" << endl;
+			m_solver->setState(BaseSolver::REFRESHING);
+			solveCurve();
+		}
+	}
+
+	bool FlexYCFZeroCurve::shiftFromMovedInstruments(const LTQC::VectorDouble& ratesShifts, const vector<size_t>& movedInstruments)
+	{
+		//	A refresh is accepted when all the instruments reprice within this tolerance
+		const double residualTolerance(1.0e-10);
+		const size_t maxNumberOfCorrections(3);
+
+		const JacobianFactorization& jacobianFactorization(m_model->getJacobianFactorization());
+
+		LTQC::VectorDouble scaledRatesShifts(ratesShifts.size(), 0.0);
+		for(vector<size_t>::const_iterator iter(movedInstruments.begin()); iter != movedInstruments.end(); ++iter)
+		{
+			scaledRatesShifts[*iter] = -ratesShifts[*iter] * (*m_partialInstruments)[*iter]->getRateDerivative();
+		}
+		m_model->updateVariablesFromShifts(jacobianFactorization.solve(scaledRatesShifts));
+		m_model->update();
+
+		for(size_t correction(0); ; ++correction)
+		{
+			//	The shift can move the instruments whose quotes did not move
+			//	away from their rates too, hence all the residuals are checked
+			LTQC::VectorDouble negativeResiduals(m_partialInstruments->size(), 0.0);
+			double maxResidual(0.0);
+			for(size_t j(0); j < m_partialInstruments->size(); ++j)
+			{
+				negativeResiduals[j] = -(*m_partialInstruments)[j]->getResidual(m_model);
+				maxResidual = max(maxResidual, fabs(negativeResiduals[j]));
+			}
+
+			if(maxResidual <= residualTolerance)
+			{
+				return true;
+			}
+			if(correction == maxNumberOfCorrections)
+			{
+				return false;
+			}
+
+			m_model->updateVariablesFromShifts(jacobianFactorization.solve(negativeResiduals));
+			m_model->update();
+		}
+	}
+
+
 	//	Calculates the shock on the unknowns from a shock in the input rates according
 	//	the first-order approximation:
 	//
@@ -601,22 +832,19 @@ namespace LTQuant
         //and only use the cashed (eg getRateDerivative) values
         //at least always check m_calibInstrumentsExist before calcing the isntruments
        
-		//	Calculate (or retrieve) the inverse Jacobian
-		LTQC::Matrix invJacobian(m_model->getInverseJacobian());
-        invJacobian.negate();
-        
 		LTQC::VectorDouble scaledRatesShifts(createShockedRates(*m_partialInstruments, m_marketData->getData()));
 		
       
 		//	TODO: Check that the size of the rate differences is the same as the # of partial instruments
 		
-		//	Multiplication of the diagonal matrix J[C/R] with (column) vector dR
+		//	Multiplication of the diagonal matrix -J[C/R] with (column) vector dR
 		for(size_t j(0); j < m_partialInstruments->size(); ++j)
 		{
-			scaledRatesShifts[j] *= (*m_partialInstruments)[j]->getRateDerivative();
+			scaledRatesShifts[j] *= -(*m_partialInstruments)[j]->getRateDerivative();
 		}	
        
-		const LTQC::VectorDouble variablesShifts(invJacobian.dot(scaledRatesShifts));
+		//	Solve against the (cached) factorization of the Jacobian rather than inverting it
+		const LTQC::VectorDouble variablesShifts(m_model->getJacobianFactorization().solve(scaledRatesShifts));
 		
 		//	Shift by the unknowns of the model by the solved shifts
 		m_model->updateVariablesFromShifts(variablesShifts);
@@ -633,30 +861,109 @@ namespace LTQuant
 		}
 		string adDiscriminator;
 		IRAssetDomain::buildDiscriminator(getIRIndexProperties()->getCurrencyName(),getIRIndexProperties()->getIndexName(),adDiscriminator);
-		LTQC::Matrix negativeInverseJacobian(m_model->getInverseJacobian());
-		negativeInverseJacobian.negate();
-		size_t numberOfInstruments = negativeInverseJacobian.getNumRows();
+		const JacobianFactorization& jacobianFactorization(m_model->getJacobianFactorization());
+		size_t numberOfInstruments = jacobianFactorization.size();
 		vector<double> dR;
 		shockedRates(dR);
-		refreshFromNegativeInverseJacobianAndRatesShift(dR, negativeInverseJacobian);
+		vector<double> dR2 = ratesShiftTimesRatesDerivative(dR);
+
+		LTQC::VectorDouble negativeScaledRatesShifts(numberOfInstruments, 0.0);
+		for(size_t j = 0; j < numberOfInstruments; ++j)
+		{
+			negativeScaledRatesShifts[j] = -dR2[j];
+		}
+		m_model->updateVariablesFromShifts(jacobianFactorization.solve(negativeScaledRatesShifts));
 		
 		for(size_t i = 0; i < childrenModels.size(); ++i)
 		{
 			ZeroCurvePtr zc = getParentRaw()->getZeroCurve(childrenModels[i]);        
 			LTQuant::FlexYCFZeroCurvePtr flexYcfZeroCurveChildModel(std::tr1::dynamic_pointer_cast<LTQuant::FlexYCFZeroCurve>(zc));
 			FlexYCF::BaseModelPtr childModel = flexYcfZeroCurveChildModel->getModel();
-			LTQC::Matrix negativeInverseJacobian2(childModel->getInverseFullJacobian());
-			negativeInverseJacobian2.negate();
+			const JacobianFactorization& childJacobianFactorization(childModel->getFullJacobianFactorization());
 
-			const size_t rows = negativeInverseJacobian2.getNumRows();
+			const size_t rows = childJacobianFactorization.size();
 			const size_t k = childModel->numberOfPlacedInstruments();
 			size_t offset = childModel->jacobianOffset(AssetDomain::createAssetDomain(adDiscriminator));
 			
-			LTQC::Matrix negativeInverseJacobianChildModel;
-			negativeInverseJacobianChildModel.subMatrix(negativeInverseJacobian2, rows - k, offset, rows - 1,  offset + numberOfInstruments - 1);
-			vector<double> dR2 = ratesShiftTimesRatesDerivative(dR);
-			flexYcfZeroCurveChildModel->refreshFromNegativeInversePartialJacobianAndRatesShift(dR2, negativeInverseJacobianChildModel);
+			//	The shifts of the child unknowns are the last k rows of -J^{-1} applied
+			//	to the scaled rates shifts of this curve, placed at its offset in the full jacobian
+			LTQC::VectorDouble childScaledRatesShifts(rows, 0.0);
+			for(size_t j = 0; j < numberOfInstruments; ++j)
+			{
+				childScaledRatesShifts[offset + j] = negativeScaledRatesShifts[j];
+			}
+			const LTQC::VectorDouble fullVariablesShifts(childJacobianFactorization.solve(childScaledRatesShifts));
+
+			LTQC::VectorDouble childVariablesShifts(k, 0.0);
+			for(size_t j = 0; j < k; ++j)
+			{
+				childVariablesShifts[j] = fullVariablesShifts[rows - k + j];
+			}
+			childModel->updateVariablesFromShifts(childVariablesShifts);
+		}
+	}
+
+	void FlexYCFZeroCurve::prepareForScenarios(GlobalComponentCache& globalComponentCache)
+	{
+		const GenericDataPtr masterTable(m_marketData->getData());
+
+		//	As in refreshFromSolver, the instruments of the clone are empty shells
+		//	until reloaded from instruments freshly created from the market data
+		if(!m_calibInstrumentsExist)
+		{
+			CalibrationInstruments reloadedInstruments;
+			CalibrationInstrumentFactory::loadInstrumentList(reloadedInstruments, masterTable, globalComponentCache, getParent());
+
+			CalibrationInstruments::iterator fullInstrument(m_fullInstruments->begin());
+			CalibrationInstruments::iterator reloadedInstrument(reloadedInstruments.begin());
+			for(; fullInstrument != m_fullInstruments->end() && reloadedInstrument != reloadedInstruments.end(); ++fullInstrument, ++reloadedInstrument)
+			{
+				if((*fullInstrument)->getName() != (*reloadedInstrument)->getName() || 
+					(*fullInstrument)->getDescription() != (*reloadedInstrument)->getDescription())
+				{
+					LTQC_THROW(IDeA::SystemException, "Different number/type of instruments between build/rebuild of curve!");
+				}
+				(*fullInstrument)->reloadInternalState(*reloadedInstrument);
+			}
+			CalibrationInstrumentFactory::updateInstrumentList(*m_fullInstruments, masterTable);
+			m_calibInstrumentsExist = true;
+		}
+
+		m_scenarioBaseRates.resize(m_partialInstruments->size());
+		for(size_t j(0); j < m_partialInstruments->size(); ++j)
+		{
+			m_scenarioBaseRates[j] = (*m_partialInstruments)[j]->getRate();
+		}
+
+		m_scenarioBaseKnots.reset(new SpineDataCache);
+		getModelSpineInternalData(m_scenarioBaseKnots);
+		m_solver->setState(BaseSolver::REFRESHING);
+	}
+
+	void FlexYCFZeroCurve::solveScenario(const vector<QuoteBump>& bumps)
+	{
+		if(!m_scenarioBaseKnots)
+		{
+			LT_THROW_ERROR("The curve must be prepared for scenarios before solving one");
+		}
+
+		vector<double> rates(m_scenarioBaseRates);
+		for(vector<QuoteBump>::const_iterator bump(bumps.begin()); bump != bumps.end(); ++bump)
+		{
+			if(bump->instrument >= rates.size())
+			{
+				LT_THROW_ERROR("Invalid instrument index " << bump->instrument << " in the scenario, there are " << rates.size() << " placed instruments");
+			}
+			rates[bump->instrument] += bump->shift;
+		}
+		for(size_t j(0); j < rates.size(); ++j)
+		{
+			(*m_partialInstruments)[j]->setRate(rates[j]);
 		}
+
+		//	Warm-start from the solved knots of the base curve
+		BaseModel::restoreModelSpineData(m_scenarioBaseKnots);
+		m_solver->solve(*m_partialInstruments, m_model);
 	}
 
     void FlexYCFZeroCurve::shockedRates(vector<double>& result) const
@@ -758,6 +1065,7 @@ namespace LTQuant
 
     void FlexYCFZeroCurve::solveCurve()
     {
+		const BuildProfile::ScopedTimer solvingTimer(BuildProfile::Solving);
         GenericDataPtr masterTable(m_marketData->getData());
         GenericDataPtr convexityModelTable;
         
@@ -811,11 +1119,7 @@ namespace LTQuant
                     //else if one of the other children of this price supplier decides to call back into as (it may need a rate)
                     //we will start an infinite recursion
                     m_requiresRebuildFromData = false;
-                    if(getParent())
-                    {
-                        getParent()->addZeroCurve(m_marketData->getCurrency(), m_marketData->getIndexName(), FlexYCFZeroCurvePtr(this, FlexYCF::NullDeleter()));
-                        getParent()->zeroCurveUpdateNotify(m_marketData);
-                    }
+                    notifyParent(true);
                 }
 
                 // need to update convexity adjustments once the swaption vol cube has changed!
@@ -834,14 +1138,51 @@ namespace LTQuant
             //else if one of the other children of this price supplier decides to call back into as (it may need a rate)
             //we will start an infinite recursion
             m_requiresRebuildFromData = false;
-            if(getParent())
-            {
-                // getParent()->addZeroCurve(m_marketData->getCurrency(), m_marketData->getIndexName(), FlexYCFZeroCurvePtr(this, FlexYCF::NullDeleter<FlexYCFZeroCurve>()));
-                getParent()->zeroCurveUpdateNotify(m_marketData);   // not factored out
-            }
+            notifyParent(false);
         }
     }
 
+    void FlexYCFZeroCurve::notifyParent(const bool addZeroCurve)
+    {
+        if(!getParent())
+        {
+            return;
+        }
+
+        DeferredNotifications* const deferredNotifications(s_deferredNotifications.get());
+        if(deferredNotifications)
+        {
+            const DeferredNotification notification = { this, addZeroCurve };
+            deferredNotifications->push_back(notification);
+            return;
+        }
+
+        if(addZeroCurve)
+        {
+            getParent()->addZeroCurve(m_marketData->getCurrency(), m_marketData->getIndexName(), FlexYCFZeroCurvePtr(this, FlexYCF::NullDeleter()));
+        }
+        getParent()->zeroCurveUpdateNotify(m_marketData);
+    }
+
+    void FlexYCFZeroCurve::replayNotifications(const DeferredNotifications& notifications)
+    {
+        for(DeferredNotifications::const_iterator iter(notifications.begin()); iter != notifications.end(); ++iter)
+        {
+            iter->curve->notifyParent(iter->addZeroCurve);
+        }
+    }
+
+    FlexYCFZeroCurve::NotificationDeferralScope::NotificationDeferralScope(DeferredNotifications& notifications):
+        m_previousNotifications(s_deferredNotifications.get())
+    {
+        s_deferredNotifications.reset(&notifications);
+    }
+
+    FlexYCFZeroCurve::NotificationDeferralScope::~NotificationDeferralScope()
+    {
+        s_deferredNotifications.reset(m_previousNotifications);
+    }
+
     void FlexYCFZeroCurve::zeroCurveUpdateNotify(const string& currency, const string& indexName)
     {
         // reestablish the model dependencies
@@ -1112,8 +1453,8 @@ namespace LTQuant
 	}
 
 	void FlexYCFZeroCurve::getSpineInternalData(FlexYCF::SpineDataCachePtr& sdp) {
-		sdp->model_ = getModel();
-		sdp->model_->getSpineInternalData(sdp);
+		lazyInit();
+		getModelSpineInternalData(sdp);
 
 		string ccy = getIRIndexProperties()->getCurrencyName();
 		string idx = getIRIndexProperties()->getIndexName();
@@ -1132,4 +1473,83 @@ namespace LTQuant
 	void FlexYCFZeroCurve::restoreModelSpineData(FlexYCF::SpineDataCachePtr& sdp) {
 		BaseModel::restoreModelSpineData(sdp);
 	}
+
+	//	Fills the spine data of the model of this curve only, not of its dependent curves
+	void FlexYCFZeroCurve::getModelSpineInternalData(FlexYCF::SpineDataCachePtr& sdp) const
+	{
+		sdp->model_ = m_model;
+		sdp->valueDate_ = m_model->getValueDate();
+		m_model->getSpineInternalData(sdp);
+		sdp->jacobian_ = m_model->getJacobian();
+
+		const FlexYCF::CalibrationInstruments& instruments(m_model->getFullInstruments());
+		sdp->instruments_.clear();
+		for(FlexYCF::CalibrationInstruments::const_iterator iter(instruments.begin()); iter != instruments.end(); ++iter)
+		{
+			sdp->instruments_.push_back((*iter)->getDescription().string());
+		}
+	}
+
+	string FlexYCFZeroCurve::getSpineDataSnapshotKey() const
+	{
+		return SpineDataSnapshot::getKey(getIRIndexProperties()->getCurrencyName(), getIRIndexProperties()->getIndexName());
+	}
+
+	void FlexYCFZeroCurve::saveSpineDataSnapshot(PriceSupplier& priceSupplier, const string& fileName)
+	{
+		SpineDataByCurve spineData;
+		for(size_t i(0); i < priceSupplier.zeroCurvesSize(); ++i)
+		{
+			const FlexYCFZeroCurvePtr curve(std::tr1::dynamic_pointer_cast<FlexYCFZeroCurve>(priceSupplier.getZeroCurve(i)));
+			if(curve)
+			{
+				curve->lazyInit();
+				SpineDataCachePtr sdp(new SpineDataCache);
+				curve->getModelSpineInternalData(sdp);
+				spineData[curve->getSpineDataSnapshotKey()] = sdp;
+			}
+		}
+		SpineDataSnapshot::save(spineData, fileName);
+	}
+
+	//	Restores the model from the spine data snapshot, if any, at the
+	//	point of the build the model would be solved. Returns false if the
+	//	model still needs to be solved: the snapshot does not match the curve
+	//	or the restored model does not reprice the current quotes, in which
+	//	case the solver starts from the restored model
+	bool FlexYCFZeroCurve::restoreFromSpineDataSnapshot()
+	{
+		//	The restored model is kept when the instruments reprice within this tolerance
+		const double residualTolerance(1.0e-8);
+
+		if(!m_spineDataSnapshot)
+		{
+			return false;
+		}
+
+		const SpineDataSnapshotConstPtr spineDataSnapshot(m_spineDataSnapshot);
+		m_spineDataSnapshot.reset();
+
+		SpineDataCachePtr sdp(new SpineDataCache);
+		getModelSpineInternalData(sdp);
+		if(!spineDataSnapshot->restore(getSpineDataSnapshotKey(), *sdp))
+		{
+			LT_LOG << "The spine data snapshot does not match " << m_marketData->getIndexName() << ", solving" << endl;
+			return false;
+		}
+
+		BaseModel::restoreModelSpineData(sdp);
+
+		for(size_t k(0); k < m_partialInstruments->size(); ++k)
+		{
+			if(fabs((*m_partialInstruments)[k]->getResidual(m_model)) > residualTolerance)
+			{
+				LT_LOG << "The spine data snapshot does not reprice the quotes of " << m_marketData->getIndexName() << ", solving" << endl;
+				return false;
+			}
+		}
+
+		LT_LOG << "Restored " << m_marketData->getIndexName() << " from the spine data snapshot" << endl;
+		return true;
+	}
 }
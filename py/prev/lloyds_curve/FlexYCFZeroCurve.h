@@ -21,12 +21,17 @@ namespace FlexYCF
     FWD_DECLARE_SMART_PTRS(CalibrationInstruments)
     FWD_DECLARE_SMART_PTRS(BaseSolver)
 	FWD_DECLARE_SMART_PTRS(SpineDataCache)
+	FWD_DECLARE_SMART_PTRS(SpineDataSnapshot)
+	FWD_DECLARE_SMART_PTRS(PerformanceTracker)
+	struct QuoteBump;
+	class GlobalComponentCache;
 
 	enum ZeroCurveRefreshType
 	{
 		FromSolver,
 		FromJacobian,
-        FullRebuild
+        FullRebuild,
+		Incremental		//	update from the quotes that moved only, corrected until they reprice
 	};
 
     // Forward declarations
@@ -47,6 +52,18 @@ namespace LTQuant
         virtual ~FlexYCFZeroCurve() {};
 		void getSpineInternalData(FlexYCF::SpineDataCachePtr& sdp);
 		void restoreModelSpineData(FlexYCF::SpineDataCachePtr& sdp);
+
+		//	Writes the spine data of all the FlexYCF curves of the price supplier to a snapshot file
+		static void saveSpineDataSnapshot(PriceSupplier& priceSupplier, const string& fileName);
+
+		//	Sets the snapshot the next build restores the curve from, instead of
+		//	calibrating it, if the snapshot holds a curve with the same value date,
+		//	instruments and knot points that reprices the current quotes.
+		//	The snapshot is only used by the next build.
+		void setSpineDataSnapshot(const FlexYCF::SpineDataSnapshotConstPtr& spineDataSnapshot)
+		{
+			m_spineDataSnapshot = spineDataSnapshot;
+		}
         virtual double getDiscountFactor(LT::date flowDate) const;
         virtual double getDiscountFactor2(double flowTime) const;
         virtual double getTenorDiscountFactor(LT::date flowDate, double tenor) const;
@@ -79,6 +96,9 @@ namespace LTQuant
 		void refreshFromJacobian();
 		void refreshFromFullJacobian();
 
+		//	Deprecated: refreshFromJacobian and refreshFromFullJacobian solve against the
+		//	factorization of the jacobian (see FlexYCF::BaseModel::getJacobianFactorization).
+		//	Refresh the model from the inverse of the jacobian, e.g. BaseModel::getInverseJacobian()
         LTQC::VectorDouble refreshFromNegativeInverseJacobianAndRatesShift(const std::vector<double>& dR, const LTQC::Matrix& invJacobian);
 		LTQC::VectorDouble refreshFromNegativeInversePartialJacobianAndRatesShift(const std::vector<double>& dR, const LTQC::Matrix& invJacobian);
         std::vector<double> ratesShiftTimesRatesDerivative(const std::vector<double>& dR) const;
@@ -99,10 +119,61 @@ namespace LTQuant
 		//	Set the refresh type:
 		void setRefreshType(const FlexYCF::ZeroCurveRefreshType refreshType);
 
+		FlexYCF::ZeroCurveRefreshType getRefreshType() const
+		{
+			return m_refreshType;
+		}
+
         FlexYCF::ICloneLookupPtr cloneWithLookup(FlexYCF::CloneLookup& lookup) const;
 
         void getPillarPoints(std::list<double>& pillarPoints) const;
 
+		//	Bump-and-revalue support for the clones of a solved curve (see BumpScenarioEngine):
+		//	reloads the calibration instruments from the market data, with the components of
+		//	the specified cache, and records the rates of the placed instruments and the knots
+		//	the scenarios are solved from. The cache must outlive the scenarios.
+		void prepareForScenarios(FlexYCF::GlobalComponentCache& globalComponentCache);
+
+		//	Re-solves the curve, starting from the recorded knots, with the rates of the placed
+		//	instruments shifted by the specified bumps.
+		//	Note: unlike a refresh, the price supplier is not notified
+		void solveScenario(const std::vector<FlexYCF::QuoteBump>& bumps);
+
+		//	A notification of the price supplier by a solved curve, deferred
+		//	while a NotificationDeferralScope is bound to the building thread
+		struct DeferredNotification
+		{
+			FlexYCFZeroCurve*	curve;
+			bool				addZeroCurve;	// registers the curve before the update notification
+		};
+
+		typedef std::vector<DeferredNotification> DeferredNotifications;
+
+		//	Nested class to defer, at a given scope level of the calling thread, the
+		//	notifications of the price supplier by the curves solved, so that the curves
+		//	built concurrently do not mutate the price supplier the others read (see
+		//	CurveSetBuilder). The notifications are to be replayed, in order, by
+		//	replayNotifications once no other curve is being built.
+		//	Note: this is robust in presence of exceptions.
+		struct NotificationDeferralScope: private DevCore::NonCopyable
+		{
+		public:
+			explicit NotificationDeferralScope(DeferredNotifications& notifications);
+			~NotificationDeferralScope();
+
+		private:
+			DeferredNotifications* const m_previousNotifications;
+		};
+
+		static void replayNotifications(const DeferredNotifications& notifications);
+
+		//	Returns the timings and counts of the builds and refreshes of
+		//	the curve made while profiling was on (see BuildProfile), null if none
+		FlexYCF::PerformanceTrackerConstPtr getPerformanceTracker() const
+		{
+			return m_performanceTracker;
+		}
+
     private:
         explicit FlexYCFZeroCurve(const FlexYCFZeroCurve& copyFrom);
         FlexYCFZeroCurve(const FlexYCFZeroCurve& copyFrom, FlexYCF::CloneLookup& lookup);
@@ -113,6 +184,15 @@ namespace LTQuant
         void rebuildCurveFromData();
 		void rebuildFromGenericData();
         void solveCurve();
+		bool restoreFromSpineDataSnapshot();
+		void getModelSpineInternalData(FlexYCF::SpineDataCachePtr& sdp) const;
+		string getSpineDataSnapshotKey() const;
+		void refreshFromSolver();
+		void refreshIncrementally();
+		void reloadCalibInstruments(FlexYCF::GlobalComponentCache& globalComponentCache);
+		void setMovedRates(const LTQC::VectorDouble& ratesShifts, const std::vector<size_t>& movedInstruments);
+		void shiftOrSolve(const LTQC::VectorDouble& ratesShifts, const std::vector<size_t>& movedInstruments);
+		bool shiftFromMovedInstruments(const LTQC::VectorDouble& ratesShifts, const std::vector<size_t>& movedInstruments);
         void lazyInit() const;
         //release the the calibration instruments
         //to minimise memory usage
@@ -121,6 +201,8 @@ namespace LTQuant
         //this function will have undefined effects
         void finishCalibInstruments();
 		void calibrationInstrumentSetValues();
+		//	Notifies the price supplier that the curve is solved, or defers the notification
+		void notifyParent(const bool addZeroCurve);
 
 		std::vector<size_t> getChildrenZeroCurves(const string& currency, const string& index) const;
 
@@ -138,6 +220,10 @@ namespace LTQuant
 		bool	                            m_requiresRefreshFromData;
         //is this a clone flexYCF zero curve, hence always clear out the calib instruments
         bool                                m_lightweightClone;
+		FlexYCF::PerformanceTrackerPtr		m_performanceTracker;
+		FlexYCF::SpineDataSnapshotConstPtr	m_spineDataSnapshot;
+		std::vector<double>					m_scenarioBaseRates;	// of the placed instruments
+		FlexYCF::SpineDataCachePtr			m_scenarioBaseKnots;
     };
 
     FWD_DECLARE_SMART_PTRS(FlexYCFZeroCurve)
@@ -16,6 +16,10 @@
 #include "FloatingLegCashFlow.h"
 #include "GlobalComponentCache.h"
 #include "FlexYCFCloneLookup.h"
+#include "ScheduleCache.h"
+#include "PortfolioCashFlows.h"
+#include "YearFractionTable.h"
+#include "TenorUtils.h"
 
 //	LTQuantLib
 #include "ModuleDate/InternalInterface/ScheduleGeneratorFactory.h"
@@ -161,22 +165,16 @@ namespace FlexYCF
 	{
 		if(m_scheduleDates.empty())
 		{
-			const string tenorDescription(arguments().getTenorDescription());
-	        LTQC::Tenor tenor(tenorDescription == "ON" || tenorDescription == "1D" ? "1M" : tenorDescription);
-			
-			LTQC::DateBuilderGenerator floatingGen(LTQC::DateBuilder(arguments().getStartDate(), 
-																	   arguments().getEndDate(), 
-																	   tenor, 
-																	   arguments().getCalendarString(), 
-																	   arguments().getStubType(),
-																	   Date(), 
-																	   arguments().getRateDetails().m_rollConvention,    
-                                                                       arguments().getRateDetails().m_rollRuleConvention, 
-																	   LT::Str("1w"), 
-																	   LTQC::RollConv(LTQC::RollConvMethod::None)));	
-	       
-			 // fill the payment dates
-			floatingGen.fillEvents(m_scheduleDates, arguments().getStartDate(), arguments().getEndDate());
+			// the schedule is generated once for all the legs with the same dates and conventions
+			const LegScheduleConstPtr schedule(ScheduleCache::get(ScheduleArguments(arguments().getStartDate(),
+																					 arguments().getEndDate(),
+																					 arguments().getTenorDescription(),
+																					 arguments().getCalendarString(),
+																					 arguments().getStubType(),
+																					 arguments().getRateDetails().m_rollConvention,
+																					 arguments().getRateDetails().m_rollRuleConvention),
+																	 arguments().getValueDate()));
+			m_scheduleDates = schedule->scheduleDates;
 		}
 
 	}
@@ -198,6 +196,10 @@ namespace FlexYCF
 			const DayCounterConstPtr rateBasis(LTQC::DayCount::create(rateDetails.m_dcm));
 			const DayCounterConstPtr accrualBasis(arguments().getBasis());
 
+			// the year fraction tables of the bases are resolved once for all the cash-flows
+			const YearFractionTableConstPtr rateTable(YearFractionTable::get(rateBasis));
+			const YearFractionTableConstPtr accrualTable(YearFractionTable::get(accrualBasis));
+
 			// fill the cash-flows
 			// the first cash-flow is fixed if Libor fixing is provided
 			Schedule::ScheduleEvents::const_iterator iter(m_scheduleDates.begin());
@@ -238,10 +240,10 @@ namespace FlexYCF
 				switch(rateDetails.m_depositRateType)
 				{
 					case DepositRateType::IBOR:
-						firstFloatFlowPtr = createDiscountedForwardRate(valueDate, iter->begin(), iter->end(), arguments().getPayDelay() , rateDetails.m_accrualValueCalendar, rateBasis, accrualBasis, rateDetails, nbPeriods == periodCnt);
+						firstFloatFlowPtr = createDiscountedForwardRate(valueDate, iter->begin(), iter->end(), arguments().getPayDelay() , rateDetails.m_accrualValueCalendar, rateBasis, accrualBasis, accrualTable.get(), rateDetails, nbPeriods == periodCnt);
 						break;
 					case DepositRateType::ON:
-						firstFloatFlowPtr = createDiscountedOISCashflow(valueDate, iter->begin(), iter->end(), arguments().getPayDelay() , rateDetails.m_accrualValueCalendar ,rateBasis, accrualBasis, rateDetails.m_currency, rateDetails.m_index );
+						firstFloatFlowPtr = createDiscountedOISCashflow(valueDate, iter->begin(), iter->end(), arguments().getPayDelay() , rateDetails.m_accrualValueCalendar ,rateBasis, accrualBasis, rateTable.get(), accrualTable.get(), rateDetails.m_currency, rateDetails.m_index );
 						break;
 					case DepositRateType::OnArithmetic:
 						firstFloatFlowPtr = createDiscountedArithmeticOISCashflow(valueDate, iter->begin(), iter->end(), rateDetails.m_accrualValueCalendar, arguments().getPayDelay() , rateDetails.m_accrualValueCalendar ,rateBasis, accrualBasis, rateDetails.m_rateCutOff, rateDetails.m_currency, rateDetails.m_index );
@@ -264,10 +266,10 @@ namespace FlexYCF
 				switch(rateDetails.m_depositRateType)
 				{
 					case DepositRateType::IBOR:
-						m_cashflows.push_back(createDiscountedForwardRate(valueDate, iter->begin(), iter->end(), arguments().getPayDelay() , rateDetails.m_accrualValueCalendar, rateBasis, accrualBasis, rateDetails, nbPeriods == periodCnt));
+						m_cashflows.push_back(createDiscountedForwardRate(valueDate, iter->begin(), iter->end(), arguments().getPayDelay() , rateDetails.m_accrualValueCalendar, rateBasis, accrualBasis, accrualTable.get(), rateDetails, nbPeriods == periodCnt));
 						break;
 					case DepositRateType::ON:
-						m_cashflows.push_back(createDiscountedOISCashflow(valueDate, iter->begin(), iter->end(), arguments().getPayDelay() , rateDetails.m_accrualValueCalendar, rateBasis, accrualBasis,  rateDetails.m_currency, rateDetails.m_index));
+						m_cashflows.push_back(createDiscountedOISCashflow(valueDate, iter->begin(), iter->end(), arguments().getPayDelay() , rateDetails.m_accrualValueCalendar, rateBasis, accrualBasis, rateTable.get(), accrualTable.get(), rateDetails.m_currency, rateDetails.m_index));
 						break;
 					case DepositRateType::OnArithmetic:
 						m_cashflows.push_back(createDiscountedArithmeticOISCashflow(valueDate, iter->begin(), iter->end(), rateDetails.m_accrualValueCalendar, arguments().getPayDelay() , rateDetails.m_accrualValueCalendar, rateBasis, accrualBasis,  rateDetails.m_rateCutOff, rateDetails.m_currency, rateDetails.m_index));
@@ -290,26 +292,15 @@ namespace FlexYCF
 																	  const LT::Str& payCalendar,
 																	  const DayCounterConstPtr& rateBasis,
 																	  const DayCounterConstPtr& accrualBasis,
+																	  const YearFractionTable* const accrualTable,
 																	  const IDeA::DepositRateMktConvention& rateDetails,
 																	  const bool isLastPeriod) const
 	{	
-		LT::date payDate(accrualEndDate);	// pay date (assume pay and acc hols are the same)
+		const LT::date payDate(calculatePayDate(accrualEndDate, payDelay, payCalendar));	// pay date (assume pay and acc hols are the same)
 		
-		Date tmp(payDate);
-		payDelay.nextPeriod(tmp,payCalendar,LTQC::RollRuleMethod::None);
-		payDate = tmp.getAsLTdate();
 		// Calculate dates
 		LT::date fixingDate, startDate, endDate;
-		
-		//	calculate index dates, allowing for special end date calculations only for the last period
-		if(arguments().getBackStubEndDateCalculationType() != EndDateCalculationType::UseLocal)
-		{
-			ForwardRate::calculateIndexDates(fixingDate, startDate, endDate, accrualStartDate, accrualEndDate, rateDetails, rateBasis, isLastPeriod? arguments().getBackStubEndDateCalculationType(): rateDetails.m_endDateCalculationType);
-		}
-		else
-		{
-			ForwardRate::calculateIndexDates(fixingDate, startDate, endDate, accrualStartDate, accrualEndDate, rateDetails, rateBasis, rateDetails.m_endDateCalculationType);
-		}
+		calculateIndexDates(fixingDate, startDate, endDate, accrualStartDate, accrualEndDate, rateBasis, rateDetails, isLastPeriod);
 
 		return	(
 			InstrumentComponent::getUseCacheFlag()	?
@@ -339,11 +330,106 @@ namespace FlexYCF
 																		 arguments().getTenorDescription(),
 																		 rateBasis,
 																		 accrualBasis,
+																		 accrualTable,
                                                                          rateDetails.m_currency,
                                                                          rateDetails.m_index))
 				);
 	}
 
+	LT::date FloatingLeg::calculatePayDate(const LT::date accrualEndDate,
+										   const LTQC::Tenor& payDelay,
+										   const LT::Str& payCalendar)
+	{
+		Date payDate(accrualEndDate);
+		payDelay.nextPeriod(payDate, payCalendar, LTQC::RollRuleMethod::None);
+		return payDate.getAsLTdate();
+	}
+
+	void FloatingLeg::calculateIndexDates(LT::date& fixingDate,
+										  LT::date& startDate,
+										  LT::date& endDate,
+										  const LT::date accrualStartDate,
+										  const LT::date accrualEndDate,
+										  const DayCounterConstPtr& rateBasis,
+										  const IDeA::DepositRateMktConvention& rateDetails,
+										  const bool isLastPeriod) const
+	{
+		//	calculate index dates, allowing for special end date calculations only for the last period
+		if(arguments().getBackStubEndDateCalculationType() != EndDateCalculationType::UseLocal)
+		{
+			ForwardRate::calculateIndexDates(fixingDate, startDate, endDate, accrualStartDate, accrualEndDate, rateDetails, rateBasis, isLastPeriod? arguments().getBackStubEndDateCalculationType(): rateDetails.m_endDateCalculationType);
+		}
+		else
+		{
+			ForwardRate::calculateIndexDates(fixingDate, startDate, endDate, accrualStartDate, accrualEndDate, rateDetails, rateBasis, rateDetails.m_endDateCalculationType);
+		}
+	}
+
+	void FloatingLeg::fillPortfolioCashFlows(PortfolioCashFlows& cashFlows, const double multiplier)
+	{
+		initializeCashFlows();
+
+        const string tenorDescription(arguments().getTenorDescription()); 
+        const IDeA::DepositRateMktConvention& rateDetails = arguments().getRateDetails();
+		const DayCounterConstPtr rateBasis(LTQC::DayCount::create(rateDetails.m_dcm));
+		const DayCounterConstPtr accrualBasis(arguments().getBasis());
+		const YearFractionTableConstPtr rateTable(YearFractionTable::get(rateBasis));
+		const YearFractionTableConstPtr accrualTable(YearFractionTable::get(accrualBasis));
+		const double tenor(tenorDescToYears(tenorDescription));
+		const double overnightTenor(tenorDescToYears("1b"));
+		const size_t nbPeriods(m_scheduleDates.size());
+		size_t periodCnt(0);
+
+		for(Schedule::ScheduleEvents::const_iterator iter(m_scheduleDates.begin()); iter != m_scheduleDates.end(); ++iter)
+		{
+			++periodCnt;
+			const LT::date accrualStartDate(iter->begin());
+			const LT::date accrualEndDate(iter->end());
+			const double coverage(YearFractionTable::getDaysOverBasis(accrualTable.get(), accrualBasis, accrualStartDate, accrualEndDate));
+
+			// the first cash-flow is fixed if Libor fixing is provided
+			if(periodCnt == 1 && arguments().useLiborFixing())
+			{
+				if( rateDetails.m_depositRateType == DepositRateType::ON || rateDetails.m_depositRateType == DepositRateType::OnArithmetic )
+				{
+					LTQC_THROW(IDeA::MarketException,"Floating tenor " << tenorDescription << " can not deal with fixings at this time");
+				}
+				cashFlows.addFixedCashFlow(multiplier * coverage * arguments().getLiborFixing(), accrualEndDate);
+				continue;
+			}
+
+			switch(rateDetails.m_depositRateType)
+			{
+				case DepositRateType::IBOR:
+					{
+						//	as DiscountedForwardRate: cvg / rate cvg * (P(start) / P(end) - 1) * DF(pay)
+						LT::date fixingDate, startDate, endDate;
+						calculateIndexDates(fixingDate, startDate, endDate, accrualStartDate, accrualEndDate, rateBasis, rateDetails, nbPeriods == periodCnt);
+						cashFlows.addFloatingCashFlow(multiplier * coverage / YearFractionTable::getDaysOverBasis(rateTable.get(), rateBasis, startDate, endDate),
+													  startDate,
+													  endDate,
+													  tenor,
+													  rateDetails.m_currency,
+													  rateDetails.m_index,
+													  calculatePayDate(accrualEndDate, arguments().getPayDelay(), rateDetails.m_accrualValueCalendar));
+					}
+					break;
+				case DepositRateType::ON:
+					//	as DiscountedOISCashflow: cvg / cvg ON * (P(start) / P(end) - 1) * DF(pay)
+					cashFlows.addFloatingCashFlow(multiplier * coverage / YearFractionTable::getDaysOverBasis(rateTable.get(), rateBasis, accrualStartDate, accrualEndDate),
+												  accrualStartDate,
+												  accrualEndDate,
+												  overnightTenor,
+												  rateDetails.m_currency,
+												  rateDetails.m_index,
+												  calculatePayDate(accrualEndDate, arguments().getPayDelay(), rateDetails.m_accrualValueCalendar));
+					break;
+				default:
+					LTQC_THROW(IDeA::MarketException,"FloatingLeg " << tenorDescription << " can not value " << rateDetails.m_depositRateType.asString().data() << " cash-flows in a portfolio");
+			}
+		}
+	}
+
 	DiscountedOISCashflowPtr FloatingLeg::createDiscountedOISCashflow(const LT::date& valueDate,
 																	  const LT::date& accrualStartDate,
 																	  const LT::date& accrualEndDate,
@@ -351,10 +437,12 @@ namespace FlexYCF
 																	  const LT::Str& payCalendar,
 																	  const DayCounterConstPtr basisON,
 																	  const DayCounterConstPtr accrualBasis,
+																	  const YearFractionTable* const tableON,
+																	  const YearFractionTable* const accrualTable,
 																	  const LTQC::Currency& ccy, 
                                                                       const LT::Str& index) const
 	{	
-		return	DiscountedOISCashflow::create(DiscountedOISCashflowArguments(valueDate, accrualStartDate, accrualEndDate, payDelay, payCalendar, basisON, accrualBasis,ccy,index));
+		return	DiscountedOISCashflow::create(DiscountedOISCashflowArguments(valueDate, accrualStartDate, accrualEndDate, payDelay, payCalendar, basisON, accrualBasis, tableON, accrualTable, ccy, index));
 	}
 
     DiscountedArithmeticOISCashflowPtr FloatingLeg::createDiscountedArithmeticOISCashflow(const LT::date& valueDate,
@@ -570,22 +658,16 @@ namespace FlexYCF
 	{
 		if(m_scheduleDates.empty())
 		{
-			const string tenorDescription(arguments().getTenorDescription());
-	        LTQC::Tenor tenor(tenorDescription == "ON" || tenorDescription == "1D" ? "1M" : tenorDescription);
-			
-			LTQC::DateBuilderGenerator floatingGen(LTQC::DateBuilder(arguments().getStartDate(), 
-																	   arguments().getEndDate(), 
-																	   tenor, 
-																	   arguments().getCalendarString(), 
-																	   arguments().getStubType(),
-																	   Date(), 
-																	   arguments().getRateDetails().m_rollConvention,    
-                                                                       arguments().getRateDetails().m_rollRuleConvention, 
-																	   LT::Str("1w"), 
-																	   LTQC::RollConv(LTQC::RollConvMethod::None)));	
-	       
-			 // fill the payment dates
-			floatingGen.fillEvents(m_scheduleDates, arguments().getStartDate(), arguments().getEndDate());
+			// the schedule is generated once for all the legs with the same dates and conventions
+			const LegScheduleConstPtr schedule(ScheduleCache::get(ScheduleArguments(arguments().getStartDate(),
+																					 arguments().getEndDate(),
+																					 arguments().getTenorDescription(),
+																					 arguments().getCalendarString(),
+																					 arguments().getStubType(),
+																					 arguments().getRateDetails().m_rollConvention,
+																					 arguments().getRateDetails().m_rollRuleConvention),
+																	 arguments().getValueDate()));
+			m_scheduleDates = schedule->scheduleDates;
 		}
 
 	}
@@ -601,6 +683,7 @@ namespace FlexYCF
 			const LT::date fixingDate(arguments().getFixingDate());
 			const DayCounterConstPtr rateBasis(LTQC::DayCount::create(rateDetails.m_dcm));
 			const DayCounterConstPtr accrualBasis(arguments().getBasis());
+			const YearFractionTableConstPtr accrualTable(YearFractionTable::get(accrualBasis));
 
 		
 			Schedule::ScheduleEvents::const_iterator iter(m_scheduleDates.begin());
@@ -614,7 +697,7 @@ namespace FlexYCF
 			} 
 			else 
 			{
-				firstFloatFlowPtr = createDiscountedForwardRateNotionalExchange(valueDate, iter->begin(), iter->end(), rateBasis, accrualBasis, rateDetails, nbPeriods == periodCnt);
+				firstFloatFlowPtr = createDiscountedForwardRateNotionalExchange(valueDate, iter->begin(), iter->end(), rateBasis, accrualBasis, accrualTable.get(), rateDetails, nbPeriods == periodCnt);
 			}
 			m_cashflows.push_back (firstFloatFlowPtr);
 
@@ -623,7 +706,7 @@ namespace FlexYCF
 			for(++iter; iter != m_scheduleDates.end(); ++iter)
 			{
 				++periodCnt;
-			    m_cashflows.push_back(createDiscountedForwardRateNotionalExchange(valueDate, iter->begin(), iter->end(), rateBasis, accrualBasis, rateDetails, nbPeriods == periodCnt));
+			    m_cashflows.push_back(createDiscountedForwardRateNotionalExchange(valueDate, iter->begin(), iter->end(), rateBasis, accrualBasis, accrualTable.get(), rateDetails, nbPeriods == periodCnt));
 			}
 		}
 	}
@@ -633,6 +716,7 @@ namespace FlexYCF
 																	  const LT::date accrualEndDate,
 																	  const DayCounterConstPtr& rateBasis,
 																	  const DayCounterConstPtr& accrualBasis,
+																	  const YearFractionTable* const accrualTable,
 																	  const IDeA::DepositRateMktConvention& rateDetails,
 																	  const bool isLastPeriod) const
 	{	
@@ -660,6 +744,7 @@ namespace FlexYCF
 																		 arguments().getTenorDescription(),
 																		 rateBasis,
 																		 accrualBasis,
+																		 accrualTable,
                                                                          rateDetails.m_currency,
                                                                          rateDetails.m_index));
 	}
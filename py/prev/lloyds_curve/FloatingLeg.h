@@ -24,6 +24,8 @@ namespace FlexYCF
 {
     FWD_DECLARE_SMART_PTRS( FloatingLeg )
     FWD_DECLARE_SMART_PTRS( FloatingLegCashFlow )
+    class PortfolioCashFlows;
+    class YearFractionTable;
 
     /// Represents a floating leg whose cash-flows can be either
     /// of type DiscountedForwardRate or FixedCashFlow.
@@ -77,6 +79,10 @@ namespace FlexYCF
 								  const double multiplier,
 								  IDeA::RepFlowsData<IDeA::Index>& indexRepFlows);
 
+        /// Adds the cash-flows of the leg, multiplied by the multiplier, to the
+        /// cash flows of a book, without creating the forward rates
+        void fillPortfolioCashFlows(PortfolioCashFlows& cashFlows, const double multiplier);
+
         virtual std::ostream& print(std::ostream& out) const;        
     
         virtual ICloneLookupPtr cloneWithLookup(CloneLookup& lookup) const;
@@ -108,9 +114,23 @@ namespace FlexYCF
 															 const LT::Str& payCalendar,
                                                              const ModuleDate::DayCounterConstPtr& rateBasis,
 															 const ModuleDate::DayCounterConstPtr& accrualBasis,
+															 const YearFractionTable* const accrualTable,
 															 const IDeA::DepositRateMktConvention& rateDetails,
 															 const bool isLastPeriod) const;
 
+		static LT::date calculatePayDate(const LT::date accrualEndDate,
+										 const LTQC::Tenor& payDelay,
+										 const LT::Str& payCalendar);
+
+		void calculateIndexDates(LT::date& fixingDate,
+								 LT::date& startDate,
+								 LT::date& endDate,
+								 const LT::date accrualStartDate,
+								 const LT::date accrualEndDate,
+								 const ModuleDate::DayCounterConstPtr& rateBasis,
+								 const IDeA::DepositRateMktConvention& rateDetails,
+								 const bool isLastPeriod) const;
+
 		DiscountedOISCashflowPtr createDiscountedOISCashflow(const LT::date& valueDate,
 															 const LT::date& accrualStartDate,
 															 const LT::date& accrualEndDateconst,
@@ -118,6 +138,8 @@ namespace FlexYCF
 															 const LT::Str& payCalendar,
 															 ModuleDate::DayCounterConstPtr basisON,
 															 ModuleDate::DayCounterConstPtr accrualBasis,
+															 const YearFractionTable* const tableON,
+															 const YearFractionTable* const accrualTable,
                                                              const LTQC::Currency& ccy, 
                                                              const LT::Str& index) const;
 
@@ -265,6 +287,7 @@ namespace FlexYCF
 															 const LT::date accrualEndDate,
                                                              const ModuleDate::DayCounterConstPtr& rateBasis,
 															 const ModuleDate::DayCounterConstPtr& accrualBasis,
+															 const YearFractionTable* const accrualTable,
 															 const IDeA::DepositRateMktConvention& rateDetails,
 															 const bool isLastPeriod) const;
 
@@ -23,6 +23,8 @@
 //	IDeA
 #include "IDeA\src\market\MarketConvention.h"
 
+#include <boost/functional/hash.hpp>
+
 
 namespace ModuleDate
 {
@@ -152,6 +154,23 @@ namespace FlexYCF
             }
         };
 
+        /// Hash functor consistent with Compare, used by CacheStorageHash
+        struct Hash
+        {
+            size_t operator()(const FloatingLegArguments& floatingLegArgs) const
+            {
+                size_t seed(0);
+                boost::hash_combine(seed, floatingLegArgs.m_liborFixing);
+                boost::hash_combine(seed, floatingLegArgs.m_useLiborFixing);
+                boost::hash_combine(seed, floatingLegArgs.m_tenorDescription);
+                boost::hash_combine(seed, floatingLegArgs.m_startDate.day_number());
+                boost::hash_combine(seed, floatingLegArgs.m_endDate.day_number());
+                boost::hash_combine(seed, floatingLegArgs.m_fixingDate.day_number());
+                boost::hash_combine(seed, floatingLegArgs.m_calendarString);
+                return seed;
+            }
+        };
+
         // used by CalculationCache -- NOT VALID AS IT IS
         bool operator==(const FloatingLegArguments& /* other */) const
         {
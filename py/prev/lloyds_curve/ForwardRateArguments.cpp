@@ -45,7 +45,7 @@ namespace FlexYCF
                                                GlobalComponentCache& globalComponentCache) :
 		m_tenorDescription(CurveType::getFromYearFraction(tenor)->getDescription()),    
 		m_tenor(tenor),
-        m_coverage(basis->getDaysOverBasis(startDate, endDate)),
+        m_coverage(globalComponentCache.getDaysOverBasis(basis, startDate, endDate)),
         m_coverageInverse(1.0 / m_coverage),
         m_startDateTenorDiscountFactor( 
             globalComponentCache.get(TenorDiscountFactor::Arguments(valueDate, startDate, m_tenor)))  ,   
@@ -70,8 +70,7 @@ namespace FlexYCF
                                                GlobalComponentCache& globalComponentCache):
 		m_tenorDescription(tenorDescription),
 		m_tenor(tenorDescToYears(tenorDescription)),
-        m_coverage(basis->getDaysOverBasis(startDate, endDate)),
-        // m_coverage(globalComponentCache.getDaysOverBasis(basis, setDate, payDate)), // using DaysOverBasisCache
+        m_coverage(globalComponentCache.getDaysOverBasis(basis, startDate, endDate)),
         m_coverageInverse(1.0 / m_coverage),
         m_startDateTenorDiscountFactor( 
             globalComponentCache.get(TenorDiscountFactor::Arguments(valueDate, startDate, m_tenor))) ,
@@ -123,7 +122,7 @@ namespace FlexYCF
                                                GlobalComponentCache& globalComponentCache):
 		m_tenorDescription(tenorDescription),
 		m_tenor(tenorDescToYears(tenorDescription)),
-        m_coverage(basis->getDaysOverBasis(startDate, endDate)),
+        m_coverage(globalComponentCache.getDaysOverBasis(basis, startDate, endDate)),
         m_coverageInverse(1.0 / m_coverage),
         m_startDateTenorDiscountFactor(globalComponentCache.get(TenorDiscountFactor::Arguments(valueDate, startDate, m_tenor,ccy,index))) ,
         m_endDateTenorDiscountFactor(globalComponentCache.get(TenorDiscountFactor::Arguments(valueDate, endDate, m_tenor,ccy,index))) ,
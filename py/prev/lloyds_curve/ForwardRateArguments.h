@@ -176,6 +176,20 @@ namespace FlexYCF
             }
         };  //  Compare
 
+        /// Hash functor consistent with Compare, used by CacheStorageHash
+        struct Hash
+        {
+            size_t operator()(const ForwardRateArguments& forwardRateArgs) const
+            {
+                size_t seed(0);
+                boost::hash_combine(seed, forwardRateArgs.m_tenor);
+                boost::hash_combine(seed, forwardRateArgs.m_coverage);
+                boost::hash_combine(seed, TenorDiscountFactorArguments::Hash()(forwardRateArgs.m_startDateTenorDiscountFactor->getArguments()));
+                boost::hash_combine(seed, TenorDiscountFactorArguments::Hash()(forwardRateArgs.m_endDateTenorDiscountFactor->getArguments()));
+                return seed;
+            }
+        };  //  Hash
+
         bool operator==(const ForwardRateArguments& other) const
         {
             return *m_startDateTenorDiscountFactor == *(other.m_startDateTenorDiscountFactor) 
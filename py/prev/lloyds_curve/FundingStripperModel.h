@@ -47,6 +47,18 @@ namespace FlexYCF
             }
             return m_dependentModel->getTenorDiscountFactor(flowTime,tenor);
         }
+
+        virtual void getSortedTenorDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                                   std::vector<double>::const_iterator flowTimesEnd,
+                                                   const double tenor,
+                                                   std::vector<double>::iterator discountFactorsBegin) const
+        {
+            if(!m_dependentModel)
+            {
+                initialize();
+            }
+            m_dependentModel->getSortedTenorDiscountFactors(flowTimesBegin, flowTimesEnd, tenor, discountFactorsBegin);
+        }
        void accumulateSpreadDiscountFactorGradient(const double flowTime, double multiplier, GradientIterator gradientBegin, GradientIterator gradientEnd) const;
 	   void accumulateBaseDiscountFactorGradient(const double flowTime, double multiplier, GradientIterator gradientBegin, GradientIterator gradientEnd) const;
        void accumulateTenorDiscountFactorGradient(const double flowTime, const double tenor, double multiplier, GradientIterator gradientBegin, GradientIterator gradientEnd) const;
@@ -203,6 +215,30 @@ namespace FlexYCF
             }
             return m_dependentModel->getTenorDiscountFactor(flowTime,tenor);
         }
+
+        virtual void getSortedDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                              std::vector<double>::const_iterator flowTimesEnd,
+                                              std::vector<double>::iterator discountFactorsBegin) const
+        {
+            if(!m_dependentModel)
+            {
+                initialize();
+            }
+            m_dependentModel->getSortedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+            multiplyByStrippedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+        }
+
+        virtual void getSortedTenorDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                                   std::vector<double>::const_iterator flowTimesEnd,
+                                                   const double tenor,
+                                                   std::vector<double>::iterator discountFactorsBegin) const
+        {
+            if(!m_dependentModel)
+            {
+                initialize();
+            }
+            m_dependentModel->getSortedTenorDiscountFactors(flowTimesBegin, flowTimesEnd, tenor, discountFactorsBegin);
+        }
          
         void accumulateDiscountFactorGradient(const double flowTime, double multiplier, GradientIterator gradientBegin, GradientIterator gradientEnd) const;
 		
@@ -372,6 +408,36 @@ namespace FlexYCF
             }
             return m_dependentModel->getTenorDiscountFactor(flowTime,tenor);
         }
+
+        virtual void getSortedDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                              std::vector<double>::const_iterator flowTimesEnd,
+                                              std::vector<double>::iterator discountFactorsBegin) const
+        {
+            if(!m_dependentModel)
+            {
+                initialize();
+            }
+            m_dependentModel->getSortedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+            multiplyByStrippedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+        }
+
+        virtual void getSortedTenorDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                                   std::vector<double>::const_iterator flowTimesEnd,
+                                                   const double tenor,
+                                                   std::vector<double>::iterator discountFactorsBegin) const
+        {
+			if(m_isCalibrated)
+			{
+				getSortedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+				return;
+			}
+
+            if(!m_dependentModel)
+            {
+                initialize();
+            }
+            m_dependentModel->getSortedTenorDiscountFactors(flowTimesBegin, flowTimesEnd, tenor, discountFactorsBegin);
+        }
          
         void accumulateDiscountFactorGradient(const double flowTime, double multiplier, GradientIterator gradientBegin, GradientIterator gradientEnd) const;
 		
@@ -15,6 +15,13 @@
 #include "GlobalComponentCache.h"
 #include "ImpliedVolQuote.h"
 #include "LiborMarketModelFactory.h"
+#include "ConvexityCalibrationCache.h"
+#include "ParallelLoop.h"
+#include "BuildProfile.h"
+
+#include <sstream>
+#include <iomanip>
+#include <typeinfo>
 
 // ModuleStaticData
 #include "ModuleStaticData/InternalInterface/IRIndexProperties.h"
@@ -51,6 +58,34 @@ namespace
         }
     };
 
+    // Writes every value of the table to the key, by tag and item, whatever its type
+    void writeTableToKey(ostringstream& key, const LTQuant::GenericData& table)
+    {
+        key << "|" << table.numTags() << "x" << table.numItems();
+        for(size_t tag(0); tag < table.numTags(); ++tag)
+        {
+            for(size_t item(0); item < table.numItems(); ++item)
+            {
+                key << "|";
+                try
+                {
+                    key << table.get<double>(tag, item);
+                }
+                catch(...)
+                {
+                    try
+                    {
+                        key << table.get<string>(tag, item);
+                    }
+                    catch(...)
+                    {
+                        // empty cell or value of another type, e.g. a sub-table
+                    }
+                }
+            }
+        }
+    }
+
 }
 
 
@@ -66,7 +101,11 @@ namespace FlexYCF
                                                  const LTQuant::GenericDataPtr& lmmTable,
                                                  const LTQuant::InstantaneousVolPtr& instantaneousVolatility,
                                                  const LTQuant::CorrelationStructurePtr& correlationStructure,
-                                                 GlobalComponentCache& globalComponentCache):
+                                                 GlobalComponentCache& globalComponentCache,
+                                                 const string& instantaneousVolModelName,
+                                                 const vector<double>& volTenorStructure,
+                                                 const double beta,
+                                                 const size_t numberOfThreads):
         m_timeEpsilon(1.e-4),                   // time epsilon to speed up algorithms, < 1 day, could be a parameter
         m_valueDate(valueDate),
         m_currencyName(irIndexProperties->getCurrencyName()),
@@ -78,7 +117,12 @@ namespace FlexYCF
         m_lmmTable(lmmTable),
         m_instantaneousVolatility(instantaneousVolatility),
         m_correlationStructure(correlationStructure),
-        m_instantaneousVolCalibrator(new InstantaneousVolCalibrator)        
+        m_instantaneousVolCalibrator(new InstantaneousVolCalibrator(numberOfThreads)),
+        m_instantaneousVolModelName(instantaneousVolModelName),
+        m_volTenorStructure(volTenorStructure),
+        m_beta(beta),
+        m_numberOfThreads(numberOfThreads),
+        m_sharesCalibration(false)
     {
         if(m_futuresStartDates.size() != m_futuresEndDates.size())
         {
@@ -149,12 +193,15 @@ namespace FlexYCF
             // 1. Retrieve parameters
             const double defaultBeta(10.0);
             const string defaultInstantaneousVolModelName(RebonatoVol::getName());
+            const long defaultNumberOfThreads(1);
            
             double beta(defaultBeta);
             string instantaneousVolModelName(defaultInstantaneousVolModelName);
+            long numberOfThreads(defaultNumberOfThreads);
             LTQuant::GenericDataPtr lmmTable;
 
             convexityModelTable->permissive_get<double>("Beta", 0, beta, defaultBeta);
+            convexityModelTable->permissive_get<long>("Threads", 0, numberOfThreads, defaultNumberOfThreads);
             convexityModelTable->permissive_get<string>("Vol Model", 0, instantaneousVolModelName, defaultInstantaneousVolModelName);
             convexityModelTable->permissive_get<LTQuant::GenericDataPtr>("LMM", 0, lmmTable);
 
@@ -246,13 +293,19 @@ namespace FlexYCF
                                                                       lmmTable,
                                                                       instantaneousVolatility,
                                                                       correlationStructure,
-                                                                      globalComponentCache));
+                                                                      globalComponentCache,
+                                                                      instantaneousVolModelName,
+                                                                      tenorStructure,
+                                                                      beta,
+                                                                      static_cast<size_t>(max(1L, numberOfThreads))));
         }
         return FuturesConvexityModelPtr();
     }
 
     void FuturesConvexityModel::calibrateToSwaptionCube(/*const BaseModelPtr& model*/)
     {
+        const BuildProfile::ScopedTimer timer(BuildProfile::ConvexityCalibration);
+
         const size_t lookupIndex(m_priceSupplier->getLookupValue(m_currencyName, m_indexName)); 
         SwaptionCubePtr swaptionCube(m_priceSupplier->getSwaptionCube(lookupIndex));
         if(!static_cast<bool>(swaptionCube))
@@ -261,8 +314,12 @@ namespace FlexYCF
         }
 		TwoQSwaptionCubePtr twoQSwaptionCube(std::tr1::dynamic_pointer_cast<TwoQSwaptionCube>(m_priceSupplier->getSwaptionCube(lookupIndex)));
 
-        LT::date expiryDate, maturityDate;         
-        double timeToExpiry, timeToMaturity, blackVol, forwardRate;
+        double timeToExpiry;
+
+        // The quotes are independent: they are read from the cube on the threads of the model, 
+        // and logged afterwards. The ATM forward rates and the first vols are only logged
+        const size_t numberOfQuotes(m_impliedVolQuotes.size());
+        vector<double> forwardRates(numberOfQuotes, 0.0), firstBlackVols(numberOfQuotes, 0.0), blackVols(numberOfQuotes, 0.0);
 
         /// Fills the caplet implied vol quotes with 2Q caplet vols
         if(static_cast<bool>(twoQSwaptionCube))
@@ -274,38 +331,42 @@ namespace FlexYCF
                 m_lmmTable->permissive_get<double>("Alpha", 0, alpha, 0.0);
             }
 
-
-            LT_LOG << "Adding caplet vol quotes:" << endl << "Expiry\tBlack Vol\tFwd Rate" << endl;
-            for(size_t k(0); k < m_impliedVolQuotes.size(); ++k)
+            parallelLoop(numberOfQuotes, m_numberOfThreads, [&] (const size_t k)
             {
-                expiryDate      = m_impliedVolQuotes[k].getExpiry();
-                maturityDate    = m_impliedVolQuotes[k].getMaturity();
-                timeToExpiry    = m_impliedVolQuotes[k].getTimeToExpiry();
-                timeToMaturity  = m_impliedVolQuotes[k].getTimeToMaturity();
+                const ImpliedVolQuote& quote(m_impliedVolQuotes[k]);
+                const LT::date expiryDate(quote.getExpiry());
+                const LT::date maturityDate(quote.getMaturity());
 
                 //  twoQVol = twoQSwaptionCube->getAtmTwoQVolatility(expiryDate, maturityDate);    
                 // Note: we could add the time to maturity as well to the quote, but this is not used
                 //  capletImpliedVols.add(ImpliedVolQuote(timeToExpiry, twoQVol)); 
 
-                if(m_impliedVolQuotes[k].useAtmStrike())
+                if(quote.useAtmStrike())
                 { 
-					forwardRate = swaptionCube->getATMForwardRate(expiryDate, ModuleDate::getMonthsBetween(expiryDate, maturityDate));
-                    blackVol = twoQSwaptionCube->getSwaptionVolatility(expiryDate, maturityDate, forwardRate, alpha);
-                    LT_LOG << "fwd rate: " << forwardRate << "\t black vol1:" << blackVol << endl;
-                    
-                    blackVol = twoQSwaptionCube->getAtmSwaptionVolatility(expiryDate, maturityDate, alpha); 
-                    LT_LOG << "black vol2:" << blackVol << endl;
+					forwardRates[k] = swaptionCube->getATMForwardRate(expiryDate, ModuleDate::getMonthsBetween(expiryDate, maturityDate));
+                    firstBlackVols[k] = twoQSwaptionCube->getSwaptionVolatility(expiryDate, maturityDate, forwardRates[k], alpha);
+                    blackVols[k] = twoQSwaptionCube->getAtmSwaptionVolatility(expiryDate, maturityDate, alpha); 
                 }
                 else
                 {
-                    blackVol = twoQSwaptionCube->getSwaptionVolatility(expiryDate, 
-                                                                       maturityDate, 
-                                                                       m_impliedVolQuotes[k].getStrike(),
-                                                                       alpha);
+                    blackVols[k] = twoQSwaptionCube->getSwaptionVolatility(expiryDate, 
+                                                                           maturityDate, 
+                                                                           quote.getStrike(),
+                                                                           alpha);
+                }
+            });
+
+            LT_LOG << "Adding caplet vol quotes:" << endl << "Expiry\tBlack Vol\tFwd Rate" << endl;
+            for(size_t k(0); k < numberOfQuotes; ++k)
+            {
+                if(m_impliedVolQuotes[k].useAtmStrike())
+                {
+                    LT_LOG << "fwd rate: " << forwardRates[k] << "\t black vol1:" << firstBlackVols[k] << endl;
+                    LT_LOG << "black vol2:" << blackVols[k] << endl;
                 }
 
                 // capletImpliedVols.add(ImpliedVolQuote(timeToExpiry, blackVol));
-                m_impliedVolQuotes[k].setVolatility(blackVol);
+                m_impliedVolQuotes[k].setVolatility(blackVols[k]);
 
                 // DEBUG info:
                 //forwardRate = (model->getTenorDiscountFactor(timeToExpiry, 0.25) / model->getTenorDiscountFactor(timeToMaturity, 0.25) - 1.0) / ModuleDate::getYearsBetween(expiryDate, maturityDate);
@@ -316,28 +377,33 @@ namespace FlexYCF
         {
             LT_LOG << "NOT 2Q model - cannot use shift LMM." << endl;
 
-            
-            LT_LOG << "Adding caplet vol quotes:" << endl << "Expiry\tBlack Vol\tFwd Rate" << endl;
-            for(size_t k(0); k < m_impliedVolQuotes.size(); ++k)
+            parallelLoop(numberOfQuotes, m_numberOfThreads, [&] (const size_t k)
             {
-                expiryDate      = m_impliedVolQuotes[k].getExpiry();
-                maturityDate    = m_impliedVolQuotes[k].getMaturity();
-                timeToExpiry    = m_impliedVolQuotes[k].getTimeToExpiry();
-                timeToMaturity  = m_impliedVolQuotes[k].getTimeToMaturity();
+                const ImpliedVolQuote& quote(m_impliedVolQuotes[k]);
+                const LT::date expiryDate(quote.getExpiry());
+                const LT::date maturityDate(quote.getMaturity());
 
-                if(m_impliedVolQuotes[k].useAtmStrike())
+                if(quote.useAtmStrike())
                 { 
-                    forwardRate = swaptionCube->getATMForwardRate(expiryDate, ModuleDate::getMonthsBetween(expiryDate, maturityDate));
-                    blackVol = swaptionCube->getSwaptionVolatility(expiryDate, maturityDate, forwardRate);
-                    LT_LOG << "fwd rate: " << forwardRate << "\t black vol1:" << blackVol << endl;
+                    forwardRates[k] = swaptionCube->getATMForwardRate(expiryDate, ModuleDate::getMonthsBetween(expiryDate, maturityDate));
+                    blackVols[k] = swaptionCube->getSwaptionVolatility(expiryDate, maturityDate, forwardRates[k]);
                 }
                 else
                 {
-                    blackVol = swaptionCube->getSwaptionVolatility(expiryDate, maturityDate, m_impliedVolQuotes[k].getStrike());
+                    blackVols[k] = swaptionCube->getSwaptionVolatility(expiryDate, maturityDate, quote.getStrike());
+                }
+            });
+            
+            LT_LOG << "Adding caplet vol quotes:" << endl << "Expiry\tBlack Vol\tFwd Rate" << endl;
+            for(size_t k(0); k < numberOfQuotes; ++k)
+            {
+                if(m_impliedVolQuotes[k].useAtmStrike())
+                {
+                    LT_LOG << "fwd rate: " << forwardRates[k] << "\t black vol1:" << blackVols[k] << endl;
                 }
 
                 // capletImpliedVols.add(ImpliedVolQuote(timeToExpiry, blackVol));
-                m_impliedVolQuotes[k].setVolatility(blackVol);
+                m_impliedVolQuotes[k].setVolatility(blackVols[k]);
 
                 // DEBUG info:
                 //forwardRate = (model->getTenorDiscountFactor(timeToExpiry, 0.25) / model->getTenorDiscountFactor(timeToMaturity, 0.25) - 1.0) / ModuleDate::getYearsBetween(expiryDate, maturityDate);
@@ -346,6 +412,31 @@ namespace FlexYCF
 
         }
 
+        // Reuse the last calibration of the curve if its vol data have not changed. The 
+        // calibration can only be shared when the vol model can be created again, so that
+        // the cached instantaneous vol is never calibrated in place
+        const bool isShareable(!m_instantaneousVolModelName.empty());
+        const string curve(m_currencyName + "|" + m_indexName);
+        const string calibrationKey(isShareable ? getCalibrationKey() : string());
+        const ConvexityCalibrationConstPtr cachedCalibration(isShareable ? ConvexityCalibrationCache::get(curve, calibrationKey) : ConvexityCalibrationConstPtr());
+        if(cachedCalibration)
+        {
+            LT_LOG << "Reusing the convexity calibration of " << curve << endl;
+            // the LMM holds the cached instantaneous vol, which is read-only: a
+            // new one is created by the next calibration (see below)
+            m_instantaneousVolatility.reset();
+            m_lmm = cachedCalibration->lmm;
+            m_sharesCalibration = true;
+            BuildProfile::record(BuildProfile::ConvexityCalibrationReuse);
+            return;
+        }
+
+        if(m_sharesCalibration)
+        {
+            m_instantaneousVolatility = InstantaneousVolFactory::create(m_instantaneousVolModelName, m_volTenorStructure);
+            m_sharesCalibration = false;
+        }
+
         // Fits the instantaneous volatility to the implied caplet volatilities (if any)
         if(!m_impliedVolQuotes.empty())
         {
@@ -390,6 +481,52 @@ namespace FlexYCF
             LT_LOG << timeToExpiry << "\t" << volQuote.getVolatility() << "\t" 
                 << sqrt(m_lmm->getIntegralSigmaSquared(0, timeToExpiry, timeToExpiry) / timeToExpiry) << endl;
         }
+
+        if(isShareable)
+        {
+            const ConvexityCalibrationPtr calibration(new ConvexityCalibration);
+            calibration->instantaneousVolatility = m_instantaneousVolatility;
+            calibration->lmm = m_lmm;
+            ConvexityCalibrationCache::set(curve, calibrationKey, calibration);
+            m_sharesCalibration = ConvexityCalibrationCache::isEnabled();
+        }
+    }
+
+    string FuturesConvexityModel::getCalibrationKey() const
+    {
+        ostringstream key;
+        key << setprecision(17) << m_valueDate.getAsLong() << "|" << m_instantaneousVolModelName << "|" << m_beta;
+
+        // The correlation structure is created from beta
+        key << "|" << (m_correlationStructure ? typeid(*m_correlationStructure).name() : "");
+
+        // The LMM reads its settings from the whole table, not only Alpha and Epsilon
+        if(m_lmmTable)
+        {
+            writeTableToKey(key, *m_lmmTable);
+        }
+
+        const vector<LT::date> tenorStructure(getTenorStructure());
+        key << "|" << tenorStructure.size();
+        for(vector<LT::date>::const_iterator date(tenorStructure.begin()); date != tenorStructure.end(); ++date)
+        {
+            key << "|" << date->getAsLong();
+        }
+        for(size_t k(0); k < m_futuresStartDates.size(); ++k)
+        {
+            key << "|" << m_futuresStartDates[k].getAsLong() << "," << m_futuresEndDates[k].getAsLong();
+        }
+        for(vector<double>::const_iterator time(m_volTenorStructure.begin()); time != m_volTenorStructure.end(); ++time)
+        {
+            key << "|" << *time;
+        }
+        for(size_t k(0); k < m_impliedVolQuotes.size(); ++k)
+        {
+            const ImpliedVolQuote& quote(m_impliedVolQuotes[k]);
+            key << "|" << quote.getExpiry().getAsLong() << "," << quote.getMaturity().getAsLong() << ","
+                << (quote.useAtmStrike() ? string("ATM") : string()) << (quote.useAtmStrike() ? 0.0 : quote.getStrike()) << "," << quote.getVolatility();
+        }
+        return key.str();
     }
 
     // Hardcoded linear interpolation
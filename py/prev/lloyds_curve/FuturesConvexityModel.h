@@ -61,7 +61,11 @@ namespace FlexYCF
                                        const LTQuant::GenericDataPtr& lmmTable,
                                        const LTQuant::InstantaneousVolPtr& instantaneousVolatility,
                                        const LTQuant::CorrelationStructurePtr& correlationStructure,
-                                       GlobalComponentCache& globalComponentCache);
+                                       GlobalComponentCache& globalComponentCache,
+                                       const std::string& instantaneousVolModelName = std::string(),
+                                       const std::vector<double>& volTenorStructure = std::vector<double>(),
+                                       const double beta = 0.0,
+                                       const size_t numberOfThreads = 1);
 
         // Note:
         // Tenor structure should contain the expiry/maturity dates of the futures
@@ -75,6 +79,13 @@ namespace FlexYCF
         /// Calibrates the instantaneous volatility of the convexity model to the swap cube
         /// of the price supplier, according to the index properties passed in the constructor
 		/// Note: only used the model for DEBUG to see what forward rates look like
+        ///
+        /// The implied vol quotes are read from the cube on the number of threads of the
+        /// model ("Threads" in the convexity model table, 1 by default). When the vol model
+        /// was given its name and tenor structure, the calibration is reused from the 
+        /// ConvexityCalibrationCache if the quotes have not changed since the last 
+        /// calibration of the curve. The time spent is added to the ConvexityCalibration
+        /// phase of the build profile.
         void calibrateToSwaptionCube(/*const BaseModelPtr& model*/);
 
 
@@ -128,6 +139,9 @@ namespace FlexYCF
                                                    const size_t upperIndex) const;
         void checkIndex(const size_t index) const;
 
+        // Returns the key identifying the inputs of the calibration to the implied vol quotes
+        std::string getCalibrationKey() const;
+
         LT::date m_valueDate;
         std::vector<LT::date> m_futuresStartDates;
         std::vector<LT::date> m_futuresEndDates;
@@ -135,7 +149,7 @@ namespace FlexYCF
         //std::vector<date> m_endDates;
         ImpliedVolQuotes m_impliedVolQuotes;
         //std::string m_lmmModelName;
-        LTQuant::LiborMarketModelPtr m_lmm;
+        LTQuant::LiborMarketModelConstPtr m_lmm;
         typedef std::vector<ForwardRatePtr> ForwardRateVector;
         ForwardRateVector m_forwardRates;
         double m_timeEpsilon;
@@ -146,6 +160,11 @@ namespace FlexYCF
         std::string m_indexName;
         InstantaneousVolCalibratorPtr m_instantaneousVolCalibrator;
         LTQuant::GenericDataPtr m_lmmTable;
+        std::string m_instantaneousVolModelName;
+        std::vector<double> m_volTenorStructure;
+        double m_beta;
+        size_t m_numberOfThreads;
+        bool m_sharesCalibration;   // true if the LMM and its instantaneous vol are held by the ConvexityCalibrationCache
     };
 }
 
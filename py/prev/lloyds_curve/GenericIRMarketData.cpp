@@ -797,5 +797,40 @@ namespace LTQuant
 			m_builtPoints = false;
 		}
 	}
+
+	bool GenericIRMarketData::setQuote(const IDeA::DictionaryKey& instrumentKey,
+									   const IDeA::DictionaryKey& descriptionKey,
+									   const IDeA::DictionaryKey& quoteKey,
+									   const string& description,
+									   const double quote)
+	{
+		syncMarketData();
+
+		GenericDataPtr data(MarketData::getData());
+		if (!data)
+			LTQC_THROW(IDeA::DataException, "No data in yield curve");
+
+		GenericDataPtr instrumentListTable = IDeA::extract<GenericDataPtr>(*data, IDeA_KEY(YIELDCURVE, YC_INSTRUMENTLIST));
+		if (!instrumentListTable)
+			LTQC_THROW(IDeA::DataException, "No instrument list in yield curve");
+
+		GenericDataPtr instrumentTable;
+		GenericDataPtr nullTable;
+		if (!IDeA::permissive_extract<GenericDataPtr>(*instrumentListTable, instrumentKey, instrumentTable, nullTable) || !instrumentTable)
+		{
+			return false;
+		}
+
+		const size_t numInstrumentTags(instrumentTable->numItems());
+		for(size_t j(0); j + 1 < numInstrumentTags; ++j)
+		{
+			if(IDeA::extract<std::string>(*instrumentTable, descriptionKey, j) == description)
+			{
+				IDeA::inject<double>(*instrumentTable, quoteKey, j, quote);
+				return true;
+			}
+		}
+		return false;
+	}
 }
 
@@ -14,6 +14,11 @@
 #include "MarketData\IRMarketData.h"
 #include "Data\GenericData.h"
 
+namespace IDeA
+{
+	class DictionaryKey;
+}
+
 namespace LTQuant
 {
     FWD_DECLARE_SMART_PTRS(GenericIRMarketData)
@@ -60,6 +65,16 @@ namespace LTQuant
 		// otherwise the reset blip is not applied back to the "real" data
 		// *** smelly code warning ***
 		virtual void syncMarketData();
+
+		/// Sets the quote of the instrument with the specified description in
+		/// the specified instrument table of the instrument list, after syncing
+		/// the table with the blipped points. Returns false if there is no such
+		/// instrument in the table
+		bool setQuote(const IDeA::DictionaryKey& instrumentKey,
+					  const IDeA::DictionaryKey& descriptionKey,
+					  const IDeA::DictionaryKey& quoteKey,
+					  const std::string& description,
+					  const double quote);
     private:
         /// copy constructor required as we need cloning
         /// support so that price supplier can work properly for risk
@@ -84,6 +84,7 @@ namespace FlexYCF
 								 const BaseModelPtr baseModel)
 	{
 		// Note: finalize and initializeKnotPoints done in FlexYCFZeroCurve::rebuildCurveFromData()
+		const BaseModel::CalibrationScope calibrationScope(*baseModel);
         const LeastSquaresResidualsPtr leastSquaresResiduals(baseModel->getLeastSquaresResiduals());
 
 		//	Set the least squares residuals representation (PV/Rate)
@@ -123,10 +124,11 @@ namespace FlexYCF
 			//	- the number of iterations (max and on solved)
 			//	- the residuals norm
 
-			//	Calculate the jacobian and set it to the model
-			LTQC::Matrix jacobian(leastSquaresProblem->getNumFunctions(), leastSquaresProblem->getNumDimensions());
-			leastSquaresProblem->computeJacobian(jacobian);
-			baseModel->setJacobian(jacobian);
+			//	Calculate the jacobian row by row from the non-zero entries
+			//	of the gradients of the residuals and set it to the model
+			SparseJacobian jacobian;
+			leastSquaresResiduals->computeJacobian(leastSquaresProblem->getNumDimensions(), jacobian);
+			baseModel->setJacobian(jacobian, leastSquaresProblem->getNumDimensions());
 
 			/*
 			//	Debug: output Jacobian:
@@ -109,13 +109,18 @@ namespace FlexYCF
 			return m_inflationIndexCache.get(arguments);
 		}
 
-        /*
         // Days over Basis
-        double getDaysOverBasis(const DayCounterConstPtr dayCounter, const date startDate, const date endDate)
+        double getDaysOverBasis(const ModuleDate::DayCounterConstPtr dayCounter, const LT::date startDate, const LT::date endDate)
         {
             return m_daysOverBasisCache->getDaysOverBasis(dayCounter, startDate, endDate);
         }
-        */
+
+        void getDaysOverBasis(const ModuleDate::DayCounterConstPtr dayCounter, 
+                              const ModuleDate::Schedule::ScheduleEvents& periods,
+                              std::vector<double>& coverages)
+        {
+            m_daysOverBasisCache->getDaysOverBasis(dayCounter, periods, coverages);
+        }
        
         // This is to be used by fixed and floating leg component arguments (FixedLegArguments and FloatingLegArguments)
         const ModuleDate::Schedule::ScheduleEvents& getScheduleEvents(const std::string& tenorDescription) const;
@@ -157,7 +162,7 @@ namespace FlexYCF
 
         DaysOverBasisCachePtr       m_daysOverBasisCache;
 
-        TenorScheduleEventsContainer m_scheduleEventsList; // filled with the appropriate ctor, but not used by instr. components yet
+        TenorScheduleEventsContainer m_scheduleEventsList; // filled with the appropriate ctor, the legs get their schedules from the ScheduleCache
     };  // GlobalComponentCache
 
 }
@@ -31,4 +31,39 @@ namespace FlexYCF
         vect.resize(size, 0.0);
     }
 
+    void SparseGradient::assign(GradientIterator gradientBegin, GradientIterator gradientEnd)
+    {
+        m_dimension = static_cast<size_t>(std::distance(gradientBegin, gradientEnd));
+        m_entries.clear();
+        for(size_t index(0); gradientBegin != gradientEnd; ++gradientBegin, ++index)
+        {
+            if(*gradientBegin != 0.0)
+            {
+                m_entries.push_back(Entry(index, *gradientBegin));
+            }
+        }
+    }
+
+    void SparseGradient::accumulateTo(const double multiplier, GradientIterator gradientBegin) const
+    {
+        for(const_iterator iter(m_entries.begin()); iter != m_entries.end(); ++iter)
+        {
+            gradientBegin[iter->first] += multiplier * iter->second;
+        }
+    }
+
+    void SparseGradient::clearFrom(GradientIterator gradientBegin) const
+    {
+        for(const_iterator iter(m_entries.begin()); iter != m_entries.end(); ++iter)
+        {
+            gradientBegin[iter->first] = 0.0;
+        }
+    }
+
+    void SparseGradient::reset(const size_t dimension)
+    {
+        m_dimension = dimension;
+        m_entries.clear();
+    }
+
 }
\ No newline at end of file
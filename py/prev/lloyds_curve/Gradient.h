@@ -33,6 +33,67 @@ namespace FlexYCF
     /// Resize the specified gradient at the given size and fills it with zeros 
     void fillWithZeros(Gradient& vect, const size_t size);
 
+    /// A gradient that only stores its non-zero entries, as (index, value)
+    /// pairs sorted by index of the unknown.
+    /// Note: an instrument component usually only depends on the few
+    /// knot-points around its flow times, so that most of the entries
+    /// of its gradient relative to all the unknowns of a model are zero.
+    class SparseGradient
+    {
+    public:
+        typedef std::pair<size_t, double>   Entry;
+        typedef std::vector<Entry>          Entries;
+        typedef Entries::const_iterator     const_iterator;
+
+        explicit SparseGradient(const size_t dimension = 0):
+            m_dimension(dimension)
+        {
+        }
+
+        /// Returns the number of unknowns the gradient is relative to
+        size_t dimension() const
+        {
+            return m_dimension;
+        }
+
+        /// Returns the number of non-zero entries
+        size_t numberOfNonZeros() const
+        {
+            return m_entries.size();
+        }
+
+        const_iterator begin() const
+        {
+            return m_entries.begin();
+        }
+
+        const_iterator end() const
+        {
+            return m_entries.end();
+        }
+
+        /// Replaces the contents by the non-zero entries of the specified dense gradient
+        void assign(GradientIterator gradientBegin, GradientIterator gradientEnd);
+
+        /// Adds this gradient, multiplied by the specified scalar, to the dense
+        /// gradient starting at the specified iterator
+        void accumulateTo(const double multiplier, GradientIterator gradientBegin) const;
+
+        /// Sets back to zero the entries of the dense gradient starting at the
+        /// specified iterator that are non-zero in this gradient
+        void clearFrom(GradientIterator gradientBegin) const;
+
+        /// Removes all the entries and sets the dimension
+        void reset(const size_t dimension);
+
+    private:
+        size_t  m_dimension;
+        Entries m_entries;
+    };  //  SparseGradient
+
+    /// A jacobian represented row by row as sparse gradients
+    typedef std::vector<SparseGradient> SparseJacobian;
+
 }
 
 #endif //__LIBRARY_PRICERS_FLEXYCF_GRADIENT_H_INCLUDED
\ No newline at end of file
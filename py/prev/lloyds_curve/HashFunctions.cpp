@@ -14,7 +14,6 @@
 #include "FixedLegArguments.h"
 #include "FloatingLegArguments.h"
 #include "TenorDiscountFactorArguments.h"
-#include "DaysOverBasisArguments.h"
 #include "forwardratearguments.h"
 #include "InflationIndex.h"
 
@@ -96,15 +95,6 @@ namespace FlexYCF
         return hasher(date_.day_number());
     }
 
-	size_t hash_value(const DaysOverBasisArguments& daysOverBasisArguments)
-    {
-        size_t seed(0);
-        hash_combine(seed, daysOverBasisArguments.getStartDate().day_number());
-        hash_combine(seed, daysOverBasisArguments.getEndDate().day_number());
-        hash_combine(seed, daysOverBasisArguments.getBasis()->getName());   
-        return seed;
-	}
-
 	size_t hash_value(const ForwardRateArguments& forwardRateArgs)
 	{
 		size_t seed(0);
@@ -55,6 +55,18 @@ namespace FlexYCF
          /// Evaluates the value of the curve function at x
         virtual double evaluate(const double x) const = 0;
 
+        /// Evaluates the curve function at the abscissas from xBegin to xEnd,
+        /// sorted in ascending order, and writes the values from yBegin
+        virtual void evaluateSorted(std::vector<double>::const_iterator xBegin,
+                                    std::vector<double>::const_iterator xEnd,
+                                    std::vector<double>::iterator yBegin) const
+        {
+            for(; xBegin != xEnd; ++xBegin, ++yBegin)
+            {
+                *yBegin = evaluate(*xBegin);
+            }
+        }
+
         /// Accumulates to the gradient at x from gradientBegin to gradientEnd
         /// using the specified multiplier.
         virtual void accumulateGradient(const double x, 
@@ -241,6 +241,20 @@ namespace FlexYCF
         return m_dependentModel->getTenorDiscountFactor(flowTime,tenor,ccy,index);
 	}
 
+	void FundingIndexSpreadStripperModel::getSortedTenorDiscountFactors(vector<double>::const_iterator flowTimesBegin,
+																		vector<double>::const_iterator flowTimesEnd,
+																		const double tenor,
+																		const LTQC::Currency& ccy,
+																		const LT::Str& index,
+																		vector<double>::iterator discountFactorsBegin) const
+	{
+		if(!m_dependentModel)
+        {
+            initialize();
+        }
+        m_dependentModel->getSortedTenorDiscountFactors(flowTimesBegin, flowTimesEnd, tenor, ccy, index, discountFactorsBegin);
+	}
+
     void FundingIndexSpreadStripperModel::accumulateDiscountFactorGradient(const double flowTime, double multiplier, GradientIterator gradientBegin,  GradientIterator gradientEnd) const
     {
 		if(!m_dependentModel)
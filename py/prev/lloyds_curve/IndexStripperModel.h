@@ -52,6 +52,30 @@ namespace FlexYCF
             double tdf = m_dependentModel->getTenorDiscountFactor(flowTime,tenor);
             return tdf * StripperModel::getDiscountFactor(flowTime);
         }
+
+        virtual void getSortedDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                              std::vector<double>::const_iterator flowTimesEnd,
+                                              std::vector<double>::iterator discountFactorsBegin) const
+        {
+            if(!m_dependentModel)
+            {
+                initialize();
+            }
+            m_dependentModel->getSortedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+        }
+
+        virtual void getSortedTenorDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                                   std::vector<double>::const_iterator flowTimesEnd,
+                                                   const double tenor,
+                                                   std::vector<double>::iterator discountFactorsBegin) const
+        {
+            if(!m_dependentModel)
+            {
+                initialize();
+            }
+            m_dependentModel->getSortedTenorDiscountFactors(flowTimesBegin, flowTimesEnd, tenor, discountFactorsBegin);
+            multiplyByStrippedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+        }
         
 		virtual double getBaseTenorDiscountFactor(const double flowTime, const double tenor) const
         {
@@ -215,8 +239,34 @@ namespace FlexYCF
         {
             return getDiscountFactor(flowTime);
         }
+
+        virtual void getSortedDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                              std::vector<double>::const_iterator flowTimesEnd,
+                                              std::vector<double>::iterator discountFactorsBegin) const
+        {
+            if(!m_dependentModel)
+            {
+                initialize();
+            }
+            m_dependentModel->getSortedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+            multiplyByStrippedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+        }
+
+        virtual void getSortedTenorDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                                   std::vector<double>::const_iterator flowTimesEnd,
+                                                   const double tenor,
+                                                   std::vector<double>::iterator discountFactorsBegin) const
+        {
+            getSortedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+        }
 		
 		virtual double getTenorDiscountFactor(double flowTime, double tenor, const LTQC::Currency& ccy, const LT::Str& index) const;
+		virtual void getSortedTenorDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+												   std::vector<double>::const_iterator flowTimesEnd,
+												   const double tenor,
+												   const LTQC::Currency& ccy,
+												   const LT::Str& index,
+												   std::vector<double>::iterator discountFactorsBegin) const;
 
         virtual double getBaseDiscountFactor(const double flowTime) const
         {
@@ -355,6 +405,30 @@ namespace FlexYCF
             double tdf = m_dependentModel->getTenorDiscountFactor(flowTime,m_baseRateTenor);
             return tdf * StripperModel::getDiscountFactor(flowTime);
         }
+
+        virtual void getSortedDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                              std::vector<double>::const_iterator flowTimesEnd,
+                                              std::vector<double>::iterator discountFactorsBegin) const
+        {
+            if(!m_dependentModel)
+            {
+                initialize();
+            }
+            m_dependentModel->getSortedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+        }
+
+        virtual void getSortedTenorDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                                   std::vector<double>::const_iterator flowTimesEnd,
+                                                   const double tenor,
+                                                   std::vector<double>::iterator discountFactorsBegin) const
+        {
+            if(!m_dependentModel)
+            {
+                initialize();
+            }
+            m_dependentModel->getSortedTenorDiscountFactors(flowTimesBegin, flowTimesEnd, m_baseRateTenor, discountFactorsBegin);
+            multiplyByStrippedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+        }
         
 		virtual double getBaseTenorDiscountFactor(const double flowTime, const double tenor) const
         {
@@ -13,6 +13,7 @@
 #include "InflationInitialization.h"
 #include "FromInstrumentsInitialization.h"
 #include "CompositeInitialization.h"
+#include "PreviousBuildInitialization.h"
 
 using namespace LTQC;
 
@@ -37,6 +38,7 @@ namespace FlexYCF
 		registerInitialization<InflationInitialization>();
 		registerInitialization<FromInstrumentsInitialization>();
 		registerInitialization<CompositeInitialization>();
+		registerInitialization<PreviousBuildInitialization>();
 	}
 
 }
\ No newline at end of file
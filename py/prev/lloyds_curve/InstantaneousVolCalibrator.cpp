@@ -3,12 +3,20 @@
 #include "Models/InstantaneousVol.h"
 #include "Maths/LeastSquaresProblem.h"
 #include "Maths/LevenbergMarquardt.h"
+#include "ParallelLoop.h"
 
 using namespace LTQC;
 using namespace LTQuant;
 
 namespace FlexYCF
 {
+    InstantaneousVolCalibrator::InstantaneousVolCalibrator(const size_t numberOfThreads):
+        m_impliedVolQuotes(0),
+        m_numberOfThreads(numberOfThreads),
+        m_capletVolDiffsAreValid(false)
+    {
+    }
+
     double InstantaneousVolCalibrator::calibrate(const LTQuant::InstantaneousVolPtr& instantaneousVol, 
                                                  const ImpliedVolQuotes& impliedCapletVolQuotes,
                                                  const double epsilon,
@@ -19,6 +27,7 @@ namespace FlexYCF
     {
         m_instantaneousVol = instantaneousVol;
         m_impliedVolQuotes = &impliedCapletVolQuotes;
+        m_capletVolDiffsAreValid = false;
         
         // Fits the instantaneous volatility to the implied caplet volatilities
         LTQuant::LeastSquaresProblem leastSquaresProblem(m_impliedVolQuotes->size(),
@@ -37,16 +46,37 @@ namespace FlexYCF
     // up to its time to expiry minus the caplet vol
     double InstantaneousVolCalibrator::impliedCapletVolDiff(const size_t index)
     {
-        m_expiryTmp     = (*m_impliedVolQuotes)[index].getTimeToExpiry();
-        m_capletVolTmp  = (*m_impliedVolQuotes)[index].getVolatility();
+        if(m_numberOfThreads <= 1)
+        {
+            return computeImpliedCapletVolDiff(index);
+        }
+
+        // The differences of all the quotes are computed on the first request 
+        // after each update of the instantaneous vol
+        if(!m_capletVolDiffsAreValid)
+        {
+            m_capletVolDiffs.resize(m_impliedVolQuotes->size());
+            parallelLoop(m_capletVolDiffs.size(), 
+                         m_numberOfThreads,
+                         [this] (const size_t k) {m_capletVolDiffs[k] = computeImpliedCapletVolDiff(k);});
+            m_capletVolDiffsAreValid = true;
+        }
+        return m_capletVolDiffs[index];
+    }
+
+    double InstantaneousVolCalibrator::computeImpliedCapletVolDiff(const size_t index) const
+    {
+        const double expiry((*m_impliedVolQuotes)[index].getTimeToExpiry());
+        const double capletVol((*m_impliedVolQuotes)[index].getVolatility());
 
-        return (sqrt(m_instantaneousVol->getIntegralSigmaSigma(0.0, m_expiryTmp, m_expiryTmp, m_expiryTmp) / m_expiryTmp)
-            - m_capletVolTmp);
+        return (sqrt(m_instantaneousVol->getIntegralSigmaSigma(0.0, expiry, expiry, expiry) / expiry)
+            - capletVol);
     }
 
-    void InstantaneousVolCalibrator::update() const
+    void InstantaneousVolCalibrator::update()
     {
         m_instantaneousVol->onUpdate();
+        m_capletVolDiffsAreValid = false;
     }
     
 }
\ No newline at end of file
@@ -27,6 +27,11 @@ namespace FlexYCF
     class InstantaneousVolCalibrator
     {
     public:
+        /// Creates a calibrator evaluating the caplet vol differences on the
+        /// specified number of threads
+        /// Note: the instantaneous vol must then support concurrent integrals
+        explicit InstantaneousVolCalibrator(const size_t numberOfThreads = 1);
+
         /// Calibrates the instantaneous volatility to the implied
         /// caplet vol quotes.
         /// Returns the sum of squared residual errors.
@@ -40,12 +45,14 @@ namespace FlexYCF
 
     private:
         double impliedCapletVolDiff(const size_t index);
-        void update() const;
+        double computeImpliedCapletVolDiff(const size_t index) const;
+        void update();
 
         LTQuant::InstantaneousVolPtr m_instantaneousVol;
         const ImpliedVolQuotes * m_impliedVolQuotes;
-        double m_expiryTmp;
-        double m_capletVolTmp;
+        size_t m_numberOfThreads;
+        std::vector<double> m_capletVolDiffs;   // of all the quotes, computed together when several threads are used
+        bool m_capletVolDiffsAreValid;
     };
 }
 
@@ -9,8 +9,79 @@
 #include "stdafx.h"
 #include "InstrumentComponent.h"
 
+#include <boost/thread/tss.hpp>
+
 namespace FlexYCF
 {
-    GlobalComponentCache * InstrumentComponent::s_globalComponentCache = 0;
-	bool InstrumentComponent::s_useCache = true;
-}
\ No newline at end of file
+	namespace
+	{
+		//	The global component cache and the "use cache" flag
+		//	as seen by one thread
+		struct ComponentCacheState
+		{
+			ComponentCacheState():
+				globalComponentCache(0),
+				useCache(true)
+			{
+			}
+
+			GlobalComponentCache*	globalComponentCache;
+			bool					useCache;
+		};
+
+		//	Namespace scope so that it is constructed before any curve
+		//	build thread can be started
+		boost::thread_specific_ptr<ComponentCacheState> s_componentCacheState;
+
+		ComponentCacheState& threadComponentCacheState()
+		{
+			if(!s_componentCacheState.get())
+			{
+				s_componentCacheState.reset(new ComponentCacheState);
+			}
+			return *s_componentCacheState;
+		}
+	}
+
+	void InstrumentComponent::setGlobalComponentCache(GlobalComponentCache * globalComponentCache)
+	{
+		ComponentCacheState& state(threadComponentCacheState());
+		state.globalComponentCache = globalComponentCache;
+		state.useCache = (globalComponentCache != NULL);
+	}
+
+	GlobalComponentCache * InstrumentComponent::getGlobalComponentCache()
+	{
+		return threadComponentCacheState().globalComponentCache;
+	}
+
+	bool InstrumentComponent::getUseCacheFlag()
+	{
+		return threadComponentCacheState().useCache;
+	}
+
+	void InstrumentComponent::setUseCacheFlag(const bool useCache)
+	{
+		threadComponentCacheState().useCache = useCache;
+	}
+
+	void MultiCcyInstrumentComponent::setGlobalComponentCache(GlobalComponentCache * globalComponentCache)
+	{
+		InstrumentComponent::setGlobalComponentCache(globalComponentCache);
+	}
+
+	GlobalComponentCache * MultiCcyInstrumentComponent::getGlobalComponentCache()
+	{
+		return threadComponentCacheState().globalComponentCache;
+	}
+
+	bool MultiCcyInstrumentComponent::getUseCacheFlag()
+	{
+		return threadComponentCacheState().useCache;
+	}
+
+	void MultiCcyInstrumentComponent::setUseCacheFlag(const bool useCache)
+	{
+		threadComponentCacheState().useCache = useCache;
+	}
+}
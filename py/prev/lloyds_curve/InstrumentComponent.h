@@ -12,6 +12,7 @@
 #define __LIBRARY_PRICERS_FLEXYCF_INSTRUMENTCOMPONENT_H_INCLUDED
 
 #include "Gradient.h"
+#include "BuildArena.h"
 
 
 namespace FlexYCF
@@ -28,6 +29,18 @@ namespace FlexYCF
     public:
         virtual ~InstrumentComponent(){ }
 
+        /// Instrument components are allocated from the arena
+        /// of the curve build, if any (see BuildArena)
+        static void* operator new(const size_t size)
+        {
+            return BuildArena::allocate(size);
+        }
+
+        static void operator delete(void* const pointer)
+        {
+            BuildArena::deallocate(pointer);
+        }
+
         /// Returns the value of the instrument component
         /// in the specified model
         virtual double getValue(BaseModel const& baseModel) = 0;
@@ -62,31 +75,17 @@ namespace FlexYCF
         ///  update to its constituents.
         virtual void update() = 0;
 
-        /// Sets the global component cache
-        static void setGlobalComponentCache(GlobalComponentCache * globalComponentCache)
-        {
-            s_globalComponentCache = globalComponentCache;
-			if( s_globalComponentCache == NULL )
-			{
-				s_useCache = false;
-			}
-			else
-			{
-				s_useCache = true;
-			}
-        }
+        /// Sets the global component cache of the calling thread
+		///	Note: the cache and the "use cache" flag are held per thread so
+		///	that independent curves can be built concurrently, each build
+		///	binding its own cache on its own thread (see GlobalCacheScope)
+        static void setGlobalComponentCache(GlobalComponentCache * globalComponentCache);
 
-        /// Gets the global component cache
-        static GlobalComponentCache * getGlobalComponentCache() 
-        {
-            return s_globalComponentCache;
-        }
+        /// Gets the global component cache of the calling thread
+        static GlobalComponentCache * getGlobalComponentCache();
 
-		///	Indicates whether to use the cache or not
-		static bool getUseCacheFlag() 
-		{
-			return s_useCache;
-		}
+		///	Indicates whether to use the cache or not on the calling thread
+		static bool getUseCacheFlag();
 
         virtual std::ostream& print(std::ostream& out) const 
         { 
@@ -117,17 +116,36 @@ namespace FlexYCF
 			const bool m_previousFlag;
 		};
 
+		//	Nested class to bind the global component cache of a curve build
+		//	to the calling thread at a given scope level, ensuring the previous
+		//	cache and "use cache" flag are automatically set back when the
+		//	instance of this class goes out of scope.
+		//	Note: this is robust in presence of exceptions.
+		struct GlobalCacheScope: private DevCore::NonCopyable
+		{
+		public:
+			explicit GlobalCacheScope(GlobalComponentCache* const globalComponentCache):
+				m_previousCache(InstrumentComponent::getGlobalComponentCache()),
+				m_previousFlag(InstrumentComponent::getUseCacheFlag())
+			{
+				FlexYCF::InstrumentComponent::setGlobalComponentCache(globalComponentCache);
+			}
+
+			~GlobalCacheScope()
+			{
+				FlexYCF::InstrumentComponent::setGlobalComponentCache(m_previousCache);
+				FlexYCF::InstrumentComponent::setUseCacheFlag(m_previousFlag);
+			}
+
+		private:
+			GlobalComponentCache* const m_previousCache;
+			const bool m_previousFlag;
+		};
+
     private:
 		/// Sets the cache flag - now private to oblige clients to use the CacheScopeSwitcher
-		static void setUseCacheFlag(const bool useCache)
-		{
-			s_useCache = useCache;
-		}
+		static void setUseCacheFlag(const bool useCache);
 
-        // GlobalComponentCache should be model-specific
-        static GlobalComponentCache*	s_globalComponentCache;
-		static bool						s_useCache;
-        
     };  //  InstrumentComponent
 
     DECLARE_SMART_PTRS( InstrumentComponent )
@@ -216,23 +234,16 @@ namespace FlexYCF
         ///  update to its constituents.
         virtual void update() = 0;
 
-        /// Sets the global component cache
-        static void setGlobalComponentCache(GlobalComponentCache * globalComponentCache)
-        {
-            s_globalComponentCache = globalComponentCache;
-        }
+        /// Sets the global component cache of the calling thread
+		///	Note: the multi-currency components share the cache and the
+		///	"use cache" flag bound to the thread by InstrumentComponent
+        static void setGlobalComponentCache(GlobalComponentCache * globalComponentCache);
 
-        /// Gets the global component cache
-        static GlobalComponentCache * getGlobalComponentCache() 
-        {
-            return s_globalComponentCache;
-        }
+        /// Gets the global component cache of the calling thread
+        static GlobalComponentCache * getGlobalComponentCache();
 
-		///	Indicates whether to use the cache or not
-		static bool getUseCacheFlag() 
-		{
-			return s_useCache;
-		}
+		///	Indicates whether to use the cache or not on the calling thread
+		static bool getUseCacheFlag();
 
         virtual std::ostream& print(std::ostream& out) const 
         { 
@@ -265,14 +276,7 @@ namespace FlexYCF
 
     private:
 		/// Sets the cache flag - now private to oblige clients to use the CacheScopeSwitcher
-		static void setUseCacheFlag(const bool useCache)
-		{
-			s_useCache = useCache;
-		}
-
-        // GlobalComponentCache should be model-specific
-        static GlobalComponentCache*	s_globalComponentCache;
-		static bool						s_useCache;
+		static void setUseCacheFlag(const bool useCache);
         
     };  //  InstrumentComponent
 
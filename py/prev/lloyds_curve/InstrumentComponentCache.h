@@ -15,6 +15,7 @@
 #include "InstrumentComponent.h"
 #include "CachedInstrumentComponent.h"
 #include "GenericInstrumentComponent.h"
+#include "BuildProfile.h"
 
 
 namespace FlexYCF
@@ -34,22 +35,45 @@ namespace FlexYCF
     /// Note :The implementation making InstrumentComponentCache inherits from 
     /// Cache template class is faster than the one inheriting from 
     /// CalculationCache, or than having it as a member variable.
+    ///
+    /// The storage policy is CacheStorageMap by default. CacheStorageHash
+    /// can be used instead when the arguments class also contains an inner
+    /// functor 'Hash' consistent with 'Compare'.
     template < class Arguments,
                class TComponent	= GenericInstrumentComponent<Arguments>,
 			   template <typename> 
-			   class TSmartPtr	= std::tr1::shared_ptr 
+			   class TSmartPtr	= std::tr1::shared_ptr,
+			   template <typename, typename, class>
+			   class TStorage	= CacheStorageMap
 			 >
     class InstrumentComponentCache: public Cache< Arguments, 
                                                   TSmartPtr<TComponent>,
-                                                  typename Arguments::Compare >
+                                                  typename Arguments::Compare,
+                                                  TStorage< Arguments, TSmartPtr<TComponent>, typename Arguments::Compare > >
     {
+        typedef Cache< Arguments, 
+                       TSmartPtr<TComponent>, 
+                       typename Arguments::Compare,
+                       TStorage< Arguments, TSmartPtr<TComponent>, typename Arguments::Compare > > BaseCache;
+
     public:
         explicit InstrumentComponentCache(const bool cacheComponentsCalculations = false) :
-            Cache(cacheComponentsCalculations ?
+            BaseCache(cacheComponentsCalculations ?
                 std::tr1::bind( &CachedInstrumentComponent<Arguments, TComponent>::create, std::placeholders::_1) :
                 std::tr1::bind( &TComponent::create, std::placeholders::_1) )
         {
         }
+
+        /// Returns the component built from the specified arguments,
+        /// counting the cache hits and misses when profiling
+        TSmartPtr<TComponent> get(const Arguments& arguments)
+        {
+            if(BuildProfile::isEnabled())
+            {
+                BuildProfile::record(BaseCache::exists(arguments) ? BuildProfile::ComponentCacheHit : BuildProfile::ComponentCacheMiss);
+            }
+            return BaseCache::get(arguments);
+        }
   
     };  //  InstrumentComponentCache
 
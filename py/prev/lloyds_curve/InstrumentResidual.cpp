@@ -14,6 +14,7 @@
 #include "CalibrationInstrument.h"
 #include "BaseModel.h"
 #include "FlexYCFCloneLookup.h"
+#include "AdjointTape.h"
 
 //	LTQuantCore
 #include "QCException.h"
@@ -58,6 +59,10 @@ namespace FlexYCF
 
     void InstrumentResidual::computeGradient(Gradient& gradient) const
     {
+		//	In adjoint mode, the instrument records the adjoints of its cached
+		//	components on the tape, which then propagates them down to the curves
+		AdjointTape::Scope adjointTape;
+
 		if(LeastSquaresRepresentationType::PV == m_representationType)
 		{
 			m_instrument->accumulateGradient(*m_baseModel, getWeight(), gradient.begin(), gradient.end());
@@ -80,8 +85,11 @@ namespace FlexYCF
 		{
 			LTQC_THROW( LTQC::ModelQCException, "Invalid representation type" );
 		}
+
+		adjointTape.sweep();
     }
 
+	//	Note: no adjoint tape here, see AdjointTape
 	void InstrumentResidual::computeGradient(Gradient& gradient, 
 											 const CurveTypeConstPtr& curveType) const
 	{
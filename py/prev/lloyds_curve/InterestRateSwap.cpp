@@ -446,6 +446,12 @@ namespace FlexYCF
 		m_floatingLeg->fillRepFlows(assetDomain, model, -multiplier, indexRepFlows);
 	}
 
+	void InterestRateSwap::fillPortfolioCashFlows(PortfolioCashFlows& cashFlows, const double multiplier) const
+	{
+		m_fixedLeg->fillPortfolioCashFlows(cashFlows, multiplier * getRate());
+		m_floatingLeg->fillPortfolioCashFlows(cashFlows, -multiplier);
+	}
+
 	double InterestRateSwap::getDifferenceWithNewRate(const LTQuant::GenericData& instrumentListData) const
 	{
 		return doGetDifferenceWithNewRate(instrumentListData, getKey<InterestRateSwap>(), IDeA_KEY(SWAP, TENOR), IDeA_KEY(SWAP, RATE));
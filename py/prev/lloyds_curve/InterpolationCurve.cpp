@@ -42,6 +42,16 @@ namespace FlexYCF
         }
     }
 
+    void InterpolationCurve::interpolateSorted(std::vector<double>::const_iterator xBegin,
+                                               std::vector<double>::const_iterator xEnd,
+                                               std::vector<double>::iterator yBegin) const
+    {
+        for(; xBegin != xEnd; ++xBegin, ++yBegin)
+        {
+            *yBegin = interpolate(*xBegin);
+        }
+    }
+
     // Implementation note: needs to be public because
     //  Composite curves need to delegate
     void InterpolationCurve::onKnotPointAdded(const KnotPoint& /* knotPoint */)
@@ -37,6 +37,12 @@ namespace FlexYCF
         /// Interpolates the curve at point x
         virtual double interpolate(const double x) const = 0; 
 
+        /// Interpolates the curve at the abscissas from xBegin to xEnd,
+        /// sorted in ascending order, and writes the values from yBegin
+        virtual void interpolateSorted(std::vector<double>::const_iterator xBegin,
+                                       std::vector<double>::const_iterator xEnd,
+                                       std::vector<double>::iterator yBegin) const;
+
         /// Accumulates to the gradient at x from gradientBegin to gradientEnd
         /// using the specified multiplier.
         virtual void accumulateGradient(const double x, 
@@ -0,0 +1,269 @@
+/*****************************************************************************
+
+	JacobianFactorization
+
+	Implementation of the JacobianFactorization
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "JacobianFactorization.h"
+
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+namespace FlexYCF
+{
+	BuildSwitch JacobianFactorization::s_checkEnabled = BUILD_SWITCH_INIT(false);
+
+	JacobianFactorization::JacobianFactorization(const LTQC::Matrix& jacobian):
+		m_size(jacobian.empty() ? 0 : jacobian.getNumRows()),
+		m_lu(m_size * m_size),
+		m_pivots(m_size),
+		m_rowEnds(m_size, 0)
+	{
+		if(m_size > 0 && jacobian.getNumCols() != m_size)
+		{
+			LT_THROW_ERROR("Cannot factorize a non-square jacobian of size " << m_size << "x" << jacobian.getNumCols());
+		}
+
+		for(size_t i(0); i < m_size; ++i)
+		{
+			m_pivots[i] = i;
+			for(size_t j(0); j < m_size; ++j)
+			{
+				m_lu[i * m_size + j] = jacobian(i, j);
+				if(jacobian(i, j) != 0.0)
+				{
+					m_rowEnds[i] = j + 1;
+				}
+			}
+		}
+
+		factorize();
+		check(jacobian);
+	}
+
+	JacobianFactorization::JacobianFactorization(const SparseJacobian& jacobian, const size_t numberOfUnknowns):
+		m_size(jacobian.size()),
+		m_lu(m_size * m_size, 0.0),
+		m_pivots(m_size),
+		m_rowEnds(m_size, 0)
+	{
+		if(numberOfUnknowns != m_size)
+		{
+			LT_THROW_ERROR("Cannot factorize a non-square jacobian of size " << m_size << "x" << numberOfUnknowns);
+		}
+
+		//	The entries of each row are sorted by column
+		for(size_t i(0); i < m_size; ++i)
+		{
+			m_pivots[i] = i;
+			for(SparseGradient::const_iterator iter(jacobian[i].begin()); iter != jacobian[i].end(); ++iter)
+			{
+				m_lu[i * m_size + iter->first] = iter->second;
+			}
+			if(jacobian[i].numberOfNonZeros() > 0)
+			{
+				m_rowEnds[i] = (jacobian[i].end() - 1)->first + 1;
+			}
+		}
+
+		factorize();
+
+		if(s_checkEnabled.isOn())
+		{
+			LTQC::Matrix denseJacobian(m_size, m_size, 0.0);
+			for(size_t i(0); i < m_size; ++i)
+			{
+				for(SparseGradient::const_iterator iter(jacobian[i].begin()); iter != jacobian[i].end(); ++iter)
+				{
+					denseJacobian(i, iter->first) = iter->second;
+				}
+			}
+			check(denseJacobian);
+		}
+	}
+
+	void JacobianFactorization::factorize()
+	{
+		//	Gaussian elimination, swapping the rows to get the largest pivot
+		for(size_t k(0); k < m_size; ++k)
+		{
+			size_t pivotRow(k);
+			for(size_t i(k + 1); i < m_size; ++i)
+			{
+				if(fabs(m_lu[i * m_size + k]) > fabs(m_lu[pivotRow * m_size + k]))
+				{
+					pivotRow = i;
+				}
+			}
+
+			const double pivot(m_lu[pivotRow * m_size + k]);
+			if(pivot == 0.0)
+			{
+				LT_THROW_ERROR("Cannot factorize the jacobian: it is singular at column " << k);
+			}
+
+			if(pivotRow != k)
+			{
+				swap_ranges(m_lu.begin() + k * m_size, m_lu.begin() + (k + 1) * m_size, m_lu.begin() + pivotRow * m_size);
+				swap(m_pivots[k], m_pivots[pivotRow]);
+				swap(m_rowEnds[k], m_rowEnds[pivotRow]);
+			}
+
+			//	The entries of the pivot row past its end are zero
+			const size_t pivotRowEnd(m_rowEnds[k]);
+			for(size_t i(k + 1); i < m_size; ++i)
+			{
+				double& multiplier(m_lu[i * m_size + k]);
+				if(multiplier != 0.0)
+				{
+					multiplier /= pivot;
+					for(size_t j(k + 1); j < pivotRowEnd; ++j)
+					{
+						m_lu[i * m_size + j] -= multiplier * m_lu[k * m_size + j];
+					}
+					m_rowEnds[i] = max(m_rowEnds[i], pivotRowEnd);
+				}
+			}
+		}
+	}
+
+	void JacobianFactorization::check(const LTQC::Matrix& jacobian) const
+	{
+		if(s_checkEnabled.isOn())
+		{
+			const double difference(getMaxDifferenceWithInverse(jacobian));
+			if(difference > 1.0e-8)
+			{
+				LT_THROW_ERROR("The factorization of the jacobian differs from its inverse by " << difference);
+			}
+		}
+	}
+
+	LTQC::VectorDouble JacobianFactorization::solve(const LTQC::VectorDouble& rhs) const
+	{
+		if(rhs.size() != m_size)
+		{
+			LT_THROW_ERROR("Cannot solve a jacobian of size " << m_size << " against a vector of size " << rhs.size());
+		}
+
+		//	P J = L U: solve L y = P rhs, then U x = y
+		LTQC::VectorDouble x(m_size, 0.0);
+		for(size_t i(0); i < m_size; ++i)
+		{
+			double sum(rhs[m_pivots[i]]);
+			for(size_t j(0); j < i; ++j)
+			{
+				sum -= lu(i, j) * x[j];
+			}
+			x[i] = sum;
+		}
+		for(size_t i(m_size); i > 0; --i)
+		{
+			double sum(x[i - 1]);
+			for(size_t j(i); j < m_rowEnds[i - 1]; ++j)
+			{
+				sum -= lu(i - 1, j) * x[j];
+			}
+			x[i - 1] = sum / lu(i - 1, i - 1);
+		}
+		return x;
+	}
+
+	LTQC::VectorDouble JacobianFactorization::solveTransposed(const LTQC::VectorDouble& rhs) const
+	{
+		if(rhs.size() != m_size)
+		{
+			LT_THROW_ERROR("Cannot solve a jacobian of size " << m_size << " against a vector of size " << rhs.size());
+		}
+
+		//	J^T = U^T L^T P: solve U^T z = rhs, then L^T w = z, and x = P^T w
+		LTQC::VectorDouble w(m_size, 0.0);
+		for(size_t i(0); i < m_size; ++i)
+		{
+			double sum(rhs[i]);
+			for(size_t j(0); j < i; ++j)
+			{
+				sum -= lu(j, i) * w[j];
+			}
+			w[i] = sum / lu(i, i);
+		}
+		for(size_t i(m_size); i > 0; --i)
+		{
+			double sum(w[i - 1]);
+			for(size_t j(i); j < m_size; ++j)
+			{
+				sum -= lu(j, i - 1) * w[j];
+			}
+			w[i - 1] = sum;
+		}
+
+		LTQC::VectorDouble x(m_size, 0.0);
+		for(size_t i(0); i < m_size; ++i)
+		{
+			x[m_pivots[i]] = w[i];
+		}
+		return x;
+	}
+
+	LTQC::Matrix JacobianFactorization::getInverse() const
+	{
+		LTQC::Matrix inverse(m_size, m_size, 0.0);
+		LTQC::VectorDouble unit(m_size, 0.0);
+		for(size_t k(0); k < m_size; ++k)
+		{
+			unit[k] = 1.0;
+			const LTQC::VectorDouble column(solve(unit));
+			unit[k] = 0.0;
+			for(size_t i(0); i < m_size; ++i)
+			{
+				inverse(i, k) = column[i];
+			}
+		}
+		return inverse;
+	}
+
+	double JacobianFactorization::getMaxDifferenceWithInverse(const LTQC::Matrix& jacobian) const
+	{
+		LTQC::Matrix inverse(jacobian);
+		inverse.inverse();
+
+		//	relative to the largest entry of the inverse
+		double scale(1.0);
+		for(size_t i(0); i < m_size; ++i)
+		{
+			for(size_t j(0); j < m_size; ++j)
+			{
+				scale = max(scale, fabs(inverse(i, j)));
+			}
+		}
+
+		double difference(0.0);
+		for(size_t k(0); k < m_size; ++k)
+		{
+			LTQC::VectorDouble unit(m_size, 0.0);
+			unit[k] = 1.0;
+			const LTQC::VectorDouble column(solve(unit));
+			const LTQC::VectorDouble row(solveTransposed(unit));
+			for(size_t i(0); i < m_size; ++i)
+			{
+				difference = max(difference, fabs(column[i] - inverse(i, k)));
+				difference = max(difference, fabs(row[i] - inverse(k, i)));
+			}
+		}
+		return difference / scale;
+	}
+
+	void JacobianFactorization::setCheckEnabled(const bool enabled)
+	{
+		s_checkEnabled.set(enabled);
+	}
+}
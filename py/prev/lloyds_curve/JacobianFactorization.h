@@ -0,0 +1,97 @@
+/*****************************************************************************
+
+    JacobianFactorization
+
+	LU factorization of the jacobian of a calibrated model.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_JACOBIANFACTORIZATION_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_JACOBIANFACTORIZATION_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+#include "BuildSwitch.h"
+#include "Matrix.h"
+#include "Gradient.h"
+
+
+namespace FlexYCF
+{
+	/// JacobianFactorization holds the LU factorization, with partial
+	/// pivoting, of a square jacobian J.
+	///
+	/// Once factorized, the first-order refresh of the unknowns and the
+	/// analytical delta are triangular solves against J and its transpose,
+	/// which spares inverting the jacobian or copying its inverse.
+	///
+	/// The elimination only runs over the envelope of the rows, up to their
+	/// last non-zero entry, which the fill-in extends: the jacobian of a
+	/// curve is made of the gradients of instruments that only depend on the
+	/// knot-points up to their maturity, so that its rows are short.
+	class JacobianFactorization: private DevCore::NonCopyable
+	{
+	public:
+		/// Factorizes the specified square matrix, throwing if it is singular
+		explicit JacobianFactorization(const LTQC::Matrix& jacobian);
+
+		/// Factorizes the jacobian made of the specified sparse rows, each relative
+		/// to the specified number of unknowns, throwing if it is not square or singular
+		JacobianFactorization(const SparseJacobian& jacobian, const size_t numberOfUnknowns);
+
+		size_t size() const
+		{
+			return m_size;
+		}
+
+		/// Returns x such that J x = rhs
+		LTQC::VectorDouble solve(const LTQC::VectorDouble& rhs) const;
+
+		/// Returns x such that J^T x = rhs
+		LTQC::VectorDouble solveTransposed(const LTQC::VectorDouble& rhs) const;
+
+		/// Returns the inverse of J, column by column from the solves of the unit vectors.
+		/// Only for the callers that need the dense inverse: prefer solving
+		LTQC::Matrix getInverse() const;
+
+		/// Returns the largest difference between the solves against J and J^T
+		/// of the unit vectors and the columns and rows of the inverse of J
+		double getMaxDifferenceWithInverse(const LTQC::Matrix& jacobian) const;
+
+		/// Switches on or off the check of each new factorization against
+		/// the inverse of the jacobian, off by default (see BuildSwitch)
+		static void setCheckEnabled(const bool enabled);
+
+		static bool isCheckEnabled()
+		{
+			return s_checkEnabled.isOn();
+		}
+
+	private:
+		//	Factorizes m_lu in place, given the end of the non-zero entries of its rows
+		void factorize();
+
+		//	Checks the factorization against the inverse of the jacobian when the check is on
+		void check(const LTQC::Matrix& jacobian) const;
+
+		double lu(const size_t i, const size_t j) const
+		{
+			return m_lu[i * m_size + j];
+		}
+
+		size_t				m_size;
+		std::vector<double>	m_lu;			// row-major, L below the unit diagonal, U on and above
+		std::vector<size_t>	m_pivots;		// row of J permuted to each row of LU
+		std::vector<size_t>	m_rowEnds;		// one past the last non-zero column of each row of LU
+
+		static BuildSwitch s_checkEnabled;
+	};  //  JacobianFactorization
+
+	DECLARE_SMART_PTRS( JacobianFactorization )
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_JACOBIANFACTORIZATION_H_INCLUDED
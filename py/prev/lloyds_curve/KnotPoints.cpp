@@ -14,14 +14,30 @@
 
 namespace FlexYCF
 {
+    namespace
+    {
+        //  The search grid only pays off on curves with many knot-points
+        const size_t s_minimumGridSize(16);
+        const size_t s_gridCellsPerKnotPoint(2);
+    }
+
+    BuildSwitch KnotPoints::s_searchGridEnabled = BUILD_SWITCH_INIT(true);
+
+    KnotPoints::KnotPoints():
+        m_gridXMin(0.0),
+        m_gridInverseWidth(0.0)
+    {
+    }
 
     void KnotPoints::add(const KnotPoint& knotPoint)
     {
-        KnotPointContainer::iterator lower(lower_bound(m_knotPoints.begin(), m_knotPoints.end(), knotPoint, KnotPoint::xCompare()));
+        const size_t index(searchLowerBound(knotPoint.x, 0, m_xs.size()));
         
-        if(lower == m_knotPoints.end() || KnotPoint::xCompare()(knotPoint, *lower))
+        if(index == m_xs.size() || knotPoint.x < m_xs[index])
         {   // insert knot-Point at lower position
-            m_knotPoints.insert(lower, knotPoint);
+            m_knotPoints.insert(m_knotPoints.begin() + index, knotPoint);
+            m_xs.insert(m_xs.begin() + index, knotPoint.x);
+            updateSearchGrid();
         }
         else
         {   // a knot-point with the same x is already in the knot-points of the curve
@@ -29,6 +45,37 @@ namespace FlexYCF
 				<< knotPoint.x << " already exists in the curve." << std::endl );
         }
     }
+
+    void KnotPoints::setX(const size_t index, const double x)
+    {
+        m_knotPoints[index].x = x;
+        m_xs[index] = x;
+        updateSearchGrid();
+    }
+
+    void KnotPoints::setXsAndYs(const std::vector<std::pair<double, double> >& points)
+    {
+        if(points.size() != m_knotPoints.size())
+        {
+            LT_THROW_ERROR( "Cannot set the coordinates of " << m_knotPoints.size() << " knot-points from " << points.size() << " points." );
+        }
+        for(size_t index(1); index < points.size(); ++index)
+        {
+            if(!(points[index - 1].first < points[index].first))
+            {
+                LT_THROW_ERROR( "The x-coordinates of the knot-points must be strictly ascending: " 
+                    << points[index].first << " follows " << points[index - 1].first << "." );
+            }
+        }
+
+        for(size_t index(0); index < points.size(); ++index)
+        {
+            m_knotPoints[index].x = points[index].first;
+            m_knotPoints[index].y = points[index].second;
+            m_xs[index] = points[index].first;
+        }
+        updateSearchGrid();
+    }
    
     void KnotPoints::addUnknownKnotPointsYsToProblemInRange(const LTQuant::ProblemPtr& problem,
                                                             const double min,
@@ -99,6 +146,10 @@ namespace FlexYCF
         clone->m_knotPoints.reserve(m_knotPoints.size());
         for (KnotPointContainer::const_iterator it = m_knotPoints.begin(); it != m_knotPoints.end(); ++it)
             clone->m_knotPoints.push_back(KnotPoint(*it, lookup));
+        clone->m_xs = m_xs;
+        clone->m_gridLowerBounds = m_gridLowerBounds;
+        clone->m_gridXMin = m_gridXMin;
+        clone->m_gridInverseWidth = m_gridInverseWidth;
         return clone;
     }
 
@@ -110,6 +161,11 @@ namespace FlexYCF
         // special cases
     }*/
     
+    void KnotPoints::setSearchGridEnabled(const bool enabled)
+    {
+        s_searchGridEnabled.set(enabled);
+    }
+
     void KnotPoints::checkNonEmpty() const
     {
         if(m_knotPoints.empty())
@@ -118,6 +174,30 @@ namespace FlexYCF
         }
     }
 
+    void KnotPoints::updateSearchGrid()
+    {
+        m_gridLowerBounds.clear();
+
+        const size_t numberOfKnotPoints(m_xs.size());
+        // the x's may be out of order while they are being set
+        if(!s_searchGridEnabled.isOn() || numberOfKnotPoints < s_minimumGridSize || !(m_xs.back() > m_xs.front()))
+        {
+            return;
+        }
+
+        const size_t numberOfCells(s_gridCellsPerKnotPoint * numberOfKnotPoints);
+        const double width((m_xs.back() - m_xs.front()) / static_cast<double>(numberOfCells));
+        m_gridXMin = m_xs.front();
+        m_gridInverseWidth = 1.0 / width;
+
+        m_gridLowerBounds.reserve(numberOfCells + 1);
+        for(size_t cell(0); cell < numberOfCells; ++cell)
+        {
+            m_gridLowerBounds.push_back(searchLowerBound(m_gridXMin + static_cast<double>(cell) * width, 0, numberOfKnotPoints));
+        }
+        m_gridLowerBounds.push_back(numberOfKnotPoints);
+    }
+
 
     void upperToLowerBound(const double x,
                            const KnotPointConstIterator begin,
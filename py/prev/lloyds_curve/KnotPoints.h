@@ -12,6 +12,7 @@
 #pragma once
 
 #include "LTQuantInitial.h"
+#include "BuildSwitch.h"
 #include "KnotPoint.h"
 #include "CurveInitializationFunction.h"
 #include "ICloneLookup.h"
@@ -29,6 +30,13 @@ namespace FlexYCF
     /// knot-points.
     /// Note: for any double, at most one knot-point with this double as its 
     /// x-coordinate exists in the collection.
+    ///
+    /// The x-coordinates are also held in a contiguous array, which the
+    /// lower and upper bounds shared by all the interpolation curves search
+    /// without branches. On curves with many knot-points, a uniform grid over
+    /// [xMin, xMax] first narrows the search to the knot-points of the grid
+    /// cell of x. The x-coordinates must therefore be changed with setX or
+    /// setXsAndYs, not through a knot-point reference.
     class KnotPoints : public ICloneLookup
     {
         typedef std::vector<KnotPoint>   KnotPointContainer;
@@ -38,6 +46,8 @@ namespace FlexYCF
 		typedef std::tr1::function<double (const double)> InitFunction;
 		// Replace with CurveInitializationFunction (same type)?
 
+        KnotPoints();
+
         const_iterator begin() const
         {
             return m_knotPoints.begin();
@@ -58,6 +68,8 @@ namespace FlexYCF
             return m_knotPoints[index];
         }
 
+        /// Note: the x-coordinate of the knot-point must not be changed
+        /// through the reference returned, see setX
         KnotPoint& operator[](const size_t index)
         {
             return m_knotPoints[index];
@@ -65,7 +77,7 @@ namespace FlexYCF
 
         const_iterator lowerBound(const double x) const
         {
-            return lower_bound(m_knotPoints.begin(), m_knotPoints.end(), x, KnotPoint::xCompare());
+            return m_knotPoints.begin() + lowerBoundIndex(x);
         }
 
         const_iterator lowerBound(const KnotPoint& knotPoint) const
@@ -75,7 +87,7 @@ namespace FlexYCF
 
         const_iterator upperBound(const double x) const
         {
-            return upper_bound(m_knotPoints.begin(), m_knotPoints.end(), x, KnotPoint::xCompare()); 
+            return m_knotPoints.begin() + upperBoundIndex(x);
         }
 
         const_iterator upperBound(const KnotPoint& knotPoint) const
@@ -83,10 +95,34 @@ namespace FlexYCF
             return upperBound(knotPoint.x);
         }
 
+        /// Returns the index of the first knot-point whose x is not less than x
+        size_t lowerBoundIndex(const double x) const
+        {
+            size_t first, last;
+            getSearchRange(x, first, last);
+            return searchLowerBound(x, first, last);
+        }
+
+        /// Returns the index of the first knot-point whose x is greater than x
+        size_t upperBoundIndex(const double x) const
+        {
+            size_t first, last;
+            getSearchRange(x, first, last);
+            return searchUpperBound(x, first, last);
+        }
+
         /// Add a knot-point which x-coordinate is not already in the collection
         /// at the right place.
         /// An error will be thrown otherwise.
         void add(const KnotPoint& knotPoint);
+
+        /// Sets the x-coordinate of the knot-point at the specified index.
+        /// The knot-points must be in ascending order once all their x's are set.
+        void setX(const size_t index, const double x);
+
+        /// Sets the x- and y-coordinates of all the knot-points, in ascending
+        /// order of x, rebuilding the search grid once
+        void setXsAndYs(const std::vector<std::pair<double, double> >& points);
         
         /// Add unknown knot-points whose x is in [min, max) range
         void addUnknownKnotPointsYsToProblemInRange(const LTQuant::ProblemPtr& problem,
@@ -106,10 +142,82 @@ namespace FlexYCF
 
         virtual ICloneLookupPtr cloneWithLookup(CloneLookup& lookup) const;
 
+        /// Switches the grid narrowing the knot-point searches on or off for
+        /// the knot-points added or moved afterwards, on by default (see BuildSwitch)
+        static void setSearchGridEnabled(const bool enabled);
+
+        static bool isSearchGridEnabled()
+        {
+            return s_searchGridEnabled.isOn();
+        }
+
     private:
         void checkNonEmpty() const;
 
-        KnotPointContainer m_knotPoints;
+        //  Rebuilds the search grid from the x's, after they changed
+        void updateSearchGrid();
+
+        //  Returns the range [first, last) of the x's holding the bounds of x:
+        //  all the x's, or those of the grid cell of x widened by one cell on
+        //  each side against the rounding of the cell
+        void getSearchRange(const double x, size_t& first, size_t& last) const
+        {
+            first = 0;
+            last = m_xs.size();
+            if(!m_gridLowerBounds.empty())
+            {
+                const size_t numberOfCells(m_gridLowerBounds.size() - 1);
+                const double position((x - m_gridXMin) * m_gridInverseWidth);
+                if(position >= 0.0 && position < static_cast<double>(numberOfCells))
+                {
+                    const size_t cell(static_cast<size_t>(position));
+                    first = m_gridLowerBounds[cell > 0 ? cell - 1 : 0];
+                    last = m_gridLowerBounds[std::min(cell + 2, numberOfCells)];
+                }
+            }
+        }
+
+        //  Branch-free binary searches of the x's in [first, last): the halving
+        //  is a conditional move, so that the search is never mispredicted
+        size_t searchLowerBound(const double x, const size_t first, const size_t last) const
+        {
+            if(first == last)
+            {
+                return first;
+            }
+            const double* base(&m_xs[first]);
+            for(size_t count(last - first); count > 1; )
+            {
+                const size_t half(count / 2);
+                base = (base[half] < x ? base + half : base);
+                count -= half;
+            }
+            return static_cast<size_t>(base - &m_xs[0]) + (*base < x ? 1 : 0);
+        }
+
+        size_t searchUpperBound(const double x, const size_t first, const size_t last) const
+        {
+            if(first == last)
+            {
+                return first;
+            }
+            const double* base(&m_xs[first]);
+            for(size_t count(last - first); count > 1; )
+            {
+                const size_t half(count / 2);
+                base = (x < base[half] ? base : base + half);
+                count -= half;
+            }
+            return static_cast<size_t>(base - &m_xs[0]) + (x < *base ? 0 : 1);
+        }
+
+        KnotPointContainer  m_knotPoints;
+        std::vector<double> m_xs;               // the x-coordinates of the knot-points, in the same order
+        std::vector<size_t> m_gridLowerBounds;  // the lower bound of the left edge of each grid cell, then the number of knot-points
+        double              m_gridXMin;
+        double              m_gridInverseWidth; // the number of grid cells per unit of x
+
+        static BuildSwitch s_searchGridEnabled;
     };
 
     DECLARE_SMART_PTRS( KnotPoints )
@@ -12,6 +12,7 @@
 #include "CalibrationInstrument.h"
 #include "Maths/LeastSquaresProblem.h"
 #include "FlexYCFCloneLookup.h"
+#include "BuildProfile.h"
 
 using namespace LTQC;
 using namespace LTQuant;
@@ -81,6 +82,7 @@ namespace FlexYCF
 	double LeastSquaresResiduals::evaluate(const size_t index) const
     {
         checkIndex(index);
+		const BuildProfile::ScopedTimer evaluationTimer(BuildProfile::ResidualEvaluation);
 
         return (index < m_instrumentResiduals.size() ?
             m_instrumentResiduals.getResidual(index) :
@@ -90,6 +92,7 @@ namespace FlexYCF
     void LeastSquaresResiduals::computeGradient(const size_t index, Gradient& gradient) const
     {
         checkIndex(index);
+		const BuildProfile::ScopedTimer gradientTimer(BuildProfile::GradientComputation);
 
         if(index < m_instrumentResiduals.size())
         {
@@ -104,6 +107,7 @@ namespace FlexYCF
 	void LeastSquaresResiduals::computeGradient(const size_t index, Gradient& gradient, const CurveTypeConstPtr& curveType) const
 	{
 		checkIndex(index);
+		const BuildProfile::ScopedTimer gradientTimer(BuildProfile::GradientComputation);
 
 		if(index < m_instrumentResiduals.size())
 		{
@@ -116,6 +120,28 @@ namespace FlexYCF
 	}
 
 
+	void LeastSquaresResiduals::computeGradient(const size_t index, SparseGradient& gradient) const
+	{
+		if(m_gradientBuffer.size() != gradient.dimension())
+		{
+			fillWithZeros(m_gradientBuffer, gradient.dimension());
+		}
+
+		computeGradient(index, m_gradientBuffer);
+		gradient.assign(m_gradientBuffer.begin(), m_gradientBuffer.end());
+		gradient.clearFrom(m_gradientBuffer.begin());
+	}
+
+	void LeastSquaresResiduals::computeJacobian(const size_t numberOfUnknowns, SparseJacobian& jacobian) const
+	{
+		jacobian.resize(size());
+		for(size_t index(0); index < jacobian.size(); ++index)
+		{
+			jacobian[index].reset(numberOfUnknowns);
+			computeGradient(index, jacobian[index]);
+		}
+	}
+
     void LeastSquaresResiduals::update()
     {   
         m_baseModel->update();
@@ -92,6 +92,14 @@ namespace FlexYCF
 		/// relative to the variables of the specified curve type
 		void computeGradient(const size_t index, Gradient& gradient, const CurveTypeConstPtr& curveType) const;
 
+		/// Computes the non-zero entries of the gradient of the index-th
+		/// weighted residual, relative to gradient.dimension() unknowns
+		void computeGradient(const size_t index, SparseGradient& gradient) const;
+
+		/// Computes the jacobian of the residuals row by row, keeping only
+		/// the non-zero entries of each row
+		void computeJacobian(const size_t numberOfUnknowns, SparseJacobian& jacobian) const;
+
         /// Delegates the update to the model its holds
         /// and all its residuals, in this order.
         void update();
@@ -121,6 +129,10 @@ namespace FlexYCF
 
         InstrumentResiduals m_instrumentResiduals;
         ExtraResiduals		m_extraResiduals;
+
+		//	Dense buffer the sparse gradients are computed on, kept at
+		//	zero between two calls so that it is reset in O(#non-zeros)
+		mutable Gradient	m_gradientBuffer;
     };  //  LeastSquaresResiduals
 
     DECLARE_SMART_PTRS( LeastSquaresResiduals )
@@ -0,0 +1,408 @@
+/*****************************************************************************
+
+	MarketDataReplay
+
+	Implementation of the MarketDataReplay
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "MarketDataReplay.h"
+#include "CsvUtils.h"
+#include "FlexYCFZeroCurve.h"
+#include "GenericIRMarketData.h"
+#include "Timer.h"
+
+//	IDeA
+#include "DictYieldCurve.h"
+
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+using namespace std;
+
+namespace FlexYCF
+{
+    using namespace LTQuant;
+
+	namespace
+	{
+		//	Returns the time, in seconds since 1 January 1970, of a date-time such as
+		//	2020-10-28T07:00:00.123Z, 2020.10.28D07:00:00.123 or 28/10/2020 07:00:00.
+		//	A time without a date is rejected: the ticks of different days would
+		//	otherwise be replayed as one day
+		bool parseDateTime(const string& dateTime, double& time)
+		{
+			const size_t separator(dateTime.find_first_of("TD "));
+			if(separator == string::npos)
+			{
+				return false;
+			}
+
+			const string date(dateTime.substr(0, separator));
+			int year, month, day;
+			char trailing;
+			if(sscanf(date.c_str(), "%d/%d/%d%c", &day, &month, &year, &trailing) != 3
+				&& sscanf(date.c_str(), "%d-%d-%d%c", &year, &month, &day, &trailing) != 3
+				&& sscanf(date.c_str(), "%d.%d.%d%c", &year, &month, &day, &trailing) != 3)
+			{
+				return false;
+			}
+			if(year < 1900 || month < 1 || month > 12 || day < 1 || day > 31)
+			{
+				return false;
+			}
+
+			int hours, minutes;
+			double seconds;
+			if(sscanf(dateTime.c_str() + separator + 1, "%d:%d:%lf", &hours, &minutes, &seconds) != 3)
+			{
+				return false;
+			}
+			time = 86400.0 * getDaysSinceEpoch(year, month, day) + 3600.0 * hours + 60.0 * minutes + seconds;
+			return true;
+		}
+
+		//	Returns the RIC a file unpacked by postprocess.py is named after
+		string getRicFromFileName(const string& fileName)
+		{
+			const size_t directory(fileName.find_last_of("/\\"));
+			const string name(directory == string::npos ? fileName : fileName.substr(directory + 1));
+			return name.substr(0, name.find('.', 1));
+		}
+	}
+
+	ReplayStatistics::ReplayStatistics():
+		numberOfTicks(0),
+		numberOfUpdates(0),
+		numberOfRefreshes(0),
+		totalLatency(0.0),
+		maxLatency(0.0)
+	{
+	}
+
+	MarketDataReplay::MarketDataReplay(const double conflationInterval):
+		m_conflationInterval(conflationInterval),
+		m_sortedTicks(true)
+	{
+		if(m_conflationInterval <= 0.0)
+		{
+			LT_THROW_ERROR("The conflation interval must be positive");
+		}
+	}
+
+	set<string> MarketDataReplay::loadTickers(const string& fileName)
+	{
+		ifstream in(fileName.c_str());
+		if(!in)
+		{
+			LT_THROW_ERROR("Cannot open the tickers file '" << fileName << "'");
+		}
+
+		set<string> tickers;
+		string line;
+		while(getline(in, line))
+		{
+			const string ticker(trimCsvField(line));
+			if(!ticker.empty())
+			{
+				tickers.insert(ticker);
+			}
+		}
+		return tickers;
+	}
+
+	void MarketDataReplay::subscribe(const string& ric,
+									 const FlexYCFZeroCurvePtr& curve,
+									 const string& instrumentType,
+									 const string& description,
+									 const double quoteMultiplier)
+	{
+		if(!curve)
+		{
+			LT_THROW_ERROR("Cannot subscribe " << ric << " to a null curve");
+		}
+		if(m_subscriptionByRic.find(ric) != m_subscriptionByRic.end())
+		{
+			LT_THROW_ERROR(ric << " is already subscribed");
+		}
+
+		static const char* const instrumentTypes[] = { "Cash", "Futures", "FRA", "Swaps", "OIS" };
+		const size_t numberOfInstrumentTypes(sizeof(instrumentTypes) / sizeof(instrumentTypes[0]));
+		size_t type(0);
+		while(type < numberOfInstrumentTypes && !equalsCaseless(instrumentType, instrumentTypes[type]))
+		{
+			++type;
+		}
+		if(type == numberOfInstrumentTypes)
+		{
+			LT_THROW_ERROR("The instrument type '" << instrumentType << "' of " << ric << " is not supported");
+		}
+
+		Subscription subscription;
+		subscription.ric				= ric;
+		subscription.curve				= curve;
+		subscription.instrumentType		= static_cast<InstrumentType>(type);
+		subscription.description		= description;
+		subscription.quoteMultiplier	= quoteMultiplier;
+
+		m_subscriptionByRic[ric] = m_subscriptions.size();
+		m_subscriptions.push_back(subscription);
+	}
+
+	void MarketDataReplay::loadSubscriptions(const string& fileName,
+											 const map<string, FlexYCFZeroCurvePtr>& curves,
+											 const set<string>& tickers)
+	{
+		ifstream in(fileName.c_str());
+		string line;
+		if(!in || !getline(in, line))
+		{
+			LT_THROW_ERROR("Cannot read the subscriptions file '" << fileName << "'");
+		}
+
+		const vector<string> header(splitCsvLine(line));
+		static const char* const ricNames[]			= { "RIC" };
+		static const char* const curveNames[]		= { "Curve" };
+		static const char* const typeNames[]		= { "Instrument Type" };
+		static const char* const descriptionNames[]	= { "Description" };
+		static const char* const multiplierNames[]	= { "Multiplier" };
+		const size_t ricColumn(findCsvColumn(header, ricNames, 1));
+		const size_t curveColumn(findCsvColumn(header, curveNames, 1));
+		const size_t typeColumn(findCsvColumn(header, typeNames, 1));
+		const size_t descriptionColumn(findCsvColumn(header, descriptionNames, 1));
+		const size_t multiplierColumn(findCsvColumn(header, multiplierNames, 1));
+		if(ricColumn == string::npos || curveColumn == string::npos || typeColumn == string::npos || descriptionColumn == string::npos)
+		{
+			LT_THROW_ERROR("The subscriptions file '" << fileName << "' must have the columns RIC, Curve, Instrument Type and Description");
+		}
+		const size_t numberOfColumns(1 + max(max(ricColumn, curveColumn), max(typeColumn, descriptionColumn)));
+
+		while(getline(in, line))
+		{
+			const vector<string> fields(splitCsvLine(line));
+			if(fields.size() < numberOfColumns || tickers.find(fields[ricColumn]) == tickers.end())
+			{
+				continue;
+			}
+
+			const map<string, FlexYCFZeroCurvePtr>::const_iterator curve(curves.find(fields[curveColumn]));
+			if(curve == curves.end())
+			{
+				LT_THROW_ERROR("Cannot find the curve '" << fields[curveColumn] << "' of " << fields[ricColumn]);
+			}
+
+			double quoteMultiplier(1.0);
+			if(multiplierColumn != string::npos && multiplierColumn < fields.size() && !fields[multiplierColumn].empty()
+				&& !parseCsvDouble(fields, multiplierColumn, quoteMultiplier))
+			{
+				LT_THROW_ERROR("Invalid multiplier '" << fields[multiplierColumn] << "' for " << fields[ricColumn]);
+			}
+			subscribe(fields[ricColumn], curve->second, fields[typeColumn], fields[descriptionColumn], quoteMultiplier);
+		}
+	}
+
+	void MarketDataReplay::addTickFile(const string& fileName)
+	{
+		ifstream in(fileName.c_str());
+		string line;
+		if(!in || !getline(in, line))
+		{
+			LT_THROW_ERROR("Cannot read the tick file '" << fileName << "'");
+		}
+
+		const vector<string> header(splitCsvLine(line));
+		static const char* const ricNames[]		= { "#RIC", "RIC", "sym" };
+		static const char* const timeNames[]	= { "Date-Time", "datetime", "Time" };
+		static const char* const lastNames[]	= { "Last", "Close" };
+		static const char* const bidNames[]		= { "Close Bid", "Bid" };
+		static const char* const askNames[]		= { "Close Ask", "Ask" };
+		const size_t ricColumn(findCsvColumn(header, ricNames, 3));
+		const size_t timeColumn(findCsvColumn(header, timeNames, 3));
+		const size_t lastColumn(findCsvColumn(header, lastNames, 2));
+		const size_t bidColumn(findCsvColumn(header, bidNames, 2));
+		const size_t askColumn(findCsvColumn(header, askNames, 2));
+		if(timeColumn == string::npos || (lastColumn == string::npos && (bidColumn == string::npos || askColumn == string::npos)))
+		{
+			LT_THROW_ERROR("The tick file '" << fileName << "' must have a time column and either a last or a bid and an ask column");
+		}
+
+		//	Without a RIC column, the file holds the ticks of the RIC it is named after
+		const string fileRic(getRicFromFileName(fileName));
+		if(ricColumn == string::npos && m_subscriptionByRic.find(fileRic) == m_subscriptionByRic.end())
+		{
+			return;
+		}
+
+		size_t lineNumber(1);
+		while(getline(in, line))
+		{
+			++lineNumber;
+			const vector<string> fields(splitCsvLine(line));
+
+			const string& ric(ricColumn == string::npos ? fileRic : (ricColumn < fields.size() ? fields[ricColumn] : string()));
+			const map<string, size_t>::const_iterator subscription(m_subscriptionByRic.find(ric));
+			if(subscription == m_subscriptionByRic.end())
+			{
+				continue;
+			}
+
+			double bid, ask, last;
+			Tick tick;
+			if(parseCsvDouble(fields, bidColumn, bid) && parseCsvDouble(fields, askColumn, ask))
+			{
+				tick.quote = 0.5 * (bid + ask);
+			}
+			else if(parseCsvDouble(fields, lastColumn, last))
+			{
+				tick.quote = last;
+			}
+			else
+			{
+				//	No trade nor quote in the bar
+				continue;
+			}
+
+			if(timeColumn >= fields.size() || !parseDateTime(fields[timeColumn], tick.time))
+			{
+				LT_THROW_ERROR("Invalid date-time at line " << lineNumber << " of the tick file '" << fileName << "'");
+			}
+			tick.subscription = subscription->second;
+			tick.quote *= m_subscriptions[tick.subscription].quoteMultiplier;
+
+			m_sortedTicks = m_sortedTicks && (m_ticks.empty() || !(tick < m_ticks.back()));
+			m_ticks.push_back(tick);
+		}
+	}
+
+	ReplayStatistics MarketDataReplay::replay()
+	{
+		//	The ticks of a file are in time order: a stable sort keeps
+		//	the order of the ticks of a RIC with the same time
+		if(!m_sortedTicks)
+		{
+			stable_sort(m_ticks.begin(), m_ticks.end());
+			m_sortedTicks = true;
+		}
+
+		ReplayStatistics statistics;
+		statistics.numberOfTicks = m_ticks.size();
+
+		vector<double> publishedQuotes(m_subscriptions.size(), numeric_limits<double>::quiet_NaN());
+		map<size_t, double> lastQuotes;
+		double intervalEnd(0.0);
+		double lastTickTime(0.0);
+		double clock(-numeric_limits<double>::max());
+
+		for(vector<Tick>::const_iterator tick(m_ticks.begin()); tick != m_ticks.end(); ++tick)
+		{
+			if(!lastQuotes.empty() && tick->time >= intervalEnd)
+			{
+				publish(lastQuotes, publishedQuotes, intervalEnd, lastTickTime, clock, statistics);
+			}
+			if(lastQuotes.empty())
+			{
+				intervalEnd = (floor(tick->time / m_conflationInterval) + 1.0) * m_conflationInterval;
+			}
+			lastQuotes[tick->subscription] = tick->quote;
+			lastTickTime = tick->time;
+		}
+		if(!lastQuotes.empty())
+		{
+			publish(lastQuotes, publishedQuotes, intervalEnd, lastTickTime, clock, statistics);
+		}
+
+		return statistics;
+	}
+
+	void MarketDataReplay::setQuote(const Subscription& subscription, const double quote)
+	{
+		const GenericIRMarketDataPtr marketData(std::tr1::dynamic_pointer_cast<GenericIRMarketData>(subscription.curve->getMarketData()));
+		if(!marketData)
+		{
+			LT_THROW_ERROR("The curve of " << subscription.ric << " has no generic market data");
+		}
+
+		bool found(false);
+		switch(subscription.instrumentType)
+		{
+		case Cash:
+			found = marketData->setQuote(IDeA_KEY(YC_INSTRUMENTLIST, CASH), IDeA_KEY(CASH, TENOR), IDeA_KEY(CASH, RATE), subscription.description, quote);
+			break;
+		case Futures:
+			found = marketData->setQuote(IDeA_KEY(YC_INSTRUMENTLIST, FUTURES), IDeA_KEY(FUTURE, EXPIRY), IDeA_KEY(FUTURE, PRICE), subscription.description, quote);
+			break;
+		case FRA:
+			found = marketData->setQuote(IDeA_KEY(YC_INSTRUMENTLIST, FRA), IDeA_KEY(FRA, DESCRIPTION), IDeA_KEY(FRA, RATE), subscription.description, quote);
+			break;
+		case Swaps:
+			found = marketData->setQuote(IDeA_KEY(YC_INSTRUMENTLIST, SWAPS), IDeA_KEY(SWAP, TENOR), IDeA_KEY(SWAP, RATE), subscription.description, quote);
+			break;
+		case OIS:
+			found = marketData->setQuote(IDeA_KEY(YC_INSTRUMENTLIST, OIS), IDeA_KEY(OIS, TENOR), IDeA_KEY(OIS, RATE), subscription.description, quote);
+			break;
+		}
+
+		if(!found)
+		{
+			LT_THROW_ERROR("Cannot find the instrument '" << subscription.description << "' quoted by " << subscription.ric);
+		}
+	}
+
+	void MarketDataReplay::publish(map<size_t, double>& lastQuotes,
+								   vector<double>& publishedQuotes,
+								   const double intervalEnd,
+								   const double lastTickTime,
+								   double& clock,
+								   ReplayStatistics& statistics) const
+	{
+		LTQuant::Timer processingTimer;
+		processingTimer.start();
+
+		//	The curves are refreshed once each, in the order of their first moved quote
+		vector<FlexYCFZeroCurve*> movedCurves;
+		for(map<size_t, double>::const_iterator lastQuote(lastQuotes.begin()); lastQuote != lastQuotes.end(); ++lastQuote)
+		{
+			if(lastQuote->second != publishedQuotes[lastQuote->first])
+			{
+				const Subscription& subscription(m_subscriptions[lastQuote->first]);
+				setQuote(subscription, lastQuote->second);
+				publishedQuotes[lastQuote->first] = lastQuote->second;
+				++statistics.numberOfUpdates;
+
+				if(find(movedCurves.begin(), movedCurves.end(), subscription.curve.get()) == movedCurves.end())
+				{
+					movedCurves.push_back(subscription.curve.get());
+				}
+			}
+		}
+		lastQuotes.clear();
+
+		if(movedCurves.empty())
+		{
+			return;
+		}
+
+		for(vector<FlexYCFZeroCurve*>::const_iterator curve(movedCurves.begin()); curve != movedCurves.end(); ++curve)
+		{
+			(*curve)->refresh();
+		}
+		statistics.numberOfRefreshes += movedCurves.size();
+
+		processingTimer.stop();
+
+		//	The update starts at the end of its interval, or once the previous update
+		//	is done if the refreshes fall behind the ticks, and takes the processing time
+		clock = max(clock, intervalEnd) + 0.001 * processingTimer.getMilliseconds();
+		const double latency(1000.0 * (clock - lastTickTime));
+		statistics.totalLatency += latency;
+		statistics.maxLatency = max(statistics.maxLatency, latency);
+	}
+}
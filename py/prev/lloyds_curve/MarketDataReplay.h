@@ -0,0 +1,145 @@
+/*****************************************************************************
+
+    MarketDataReplay
+
+	Replays tick or bar files into the market data of FlexYCF curves,
+	refreshing the curves on each conflated update.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_MARKETDATAREPLAY_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_MARKETDATAREPLAY_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+
+#include <set>
+#include <map>
+
+
+namespace LTQuant
+{
+    FWD_DECLARE_SMART_PTRS( FlexYCFZeroCurve )
+}
+
+namespace FlexYCF
+{
+	/// The counts and timings of a replay
+	struct ReplayStatistics
+	{
+		ReplayStatistics();
+
+		size_t	numberOfTicks;			// of the subscribed RICs
+		size_t	numberOfUpdates;		// conflated quotes pushed to the market data
+		size_t	numberOfRefreshes;		// of curves
+		double	totalLatency;			// from the last tick of each update to the refreshed curves, in ms
+		double	maxLatency;				// in ms
+	};
+
+    /// MarketDataReplay streams the quotes of tick or bar files into the
+	/// market data of FlexYCF curves, to measure the tick-to-curve latency
+	/// offline.
+	///
+	/// Each subscribed RIC is mapped to an instrument of a curve. The ticks
+	/// of all the files are replayed in time order and conflated per
+	/// instrument: at the end of each conflation interval, the last quote of
+	/// each instrument that moved is pushed into the GenericIRMarketData of
+	/// its curve, then each curve with new quotes is refreshed once.
+	///
+	/// The latency of an update runs from the timestamp of its last tick
+	/// to the refreshed curves, on a simulated clock: the update starts at
+	/// the end of its interval, or when the previous one is done if the
+	/// refreshes fall behind, and takes the measured processing time.
+	///
+	/// The files are the CSV files unpacked from the Refinitiv bar files
+	/// (see mktdata/postprocess.py). Their timestamps must have a date.
+    class MarketDataReplay
+    {
+    public:
+		/// Creates a replay conflating the ticks over the specified interval, in seconds
+        explicit MarketDataReplay(const double conflationInterval = 1.0);
+
+		/// Returns the RICs listed in the specified file, one per line
+		static std::set<std::string> loadTickers(const std::string& fileName);
+
+		/// Maps the quotes of the RIC to the instrument of the curve with the specified
+		/// type (Cash, Futures, FRA, Swaps or OIS) and description, the quotes being
+		/// multiplied by the specified multiplier (e.g. 0.01 for rates quoted in percent)
+		void subscribe(const std::string& ric,
+					   const LTQuant::FlexYCFZeroCurvePtr& curve,
+					   const std::string& instrumentType,
+					   const std::string& description,
+					   const double quoteMultiplier);
+
+		/// Subscribes the RICs of the specified CSV file, with the columns RIC, Curve,
+		/// Instrument Type, Description and Multiplier, that are in the tickers.
+		/// The curves are looked up by name in the specified curves.
+		void loadSubscriptions(const std::string& fileName,
+							   const std::map<std::string, LTQuant::FlexYCFZeroCurvePtr>& curves,
+							   const std::set<std::string>& tickers);
+
+		/// Reads the ticks of the subscribed RICs from the specified CSV file.
+		/// The quote of a tick is the mid of its bid and ask, or its last price.
+		/// A tick whose time has no date is rejected
+		void addTickFile(const std::string& fileName);
+
+		/// Replays the ticks read, leaving them to be replayed again
+		ReplayStatistics replay();
+
+    private:
+		enum InstrumentType
+		{
+			Cash,
+			Futures,
+			FRA,
+			Swaps,
+			OIS
+		};
+
+		struct Subscription
+		{
+			std::string						ric;
+			LTQuant::FlexYCFZeroCurvePtr	curve;
+			InstrumentType					instrumentType;
+			std::string						description;
+			double							quoteMultiplier;
+		};
+
+		struct Tick
+		{
+			double	time;			// in seconds since 1 January 1970
+			size_t	subscription;
+			double	quote;
+
+			bool operator<(const Tick& other) const
+			{
+				return time < other.time;
+			}
+		};
+
+		//	Sets the quote of the instrument of the subscription in the market data of its curve
+		static void setQuote(const Subscription& subscription, const double quote);
+
+		//	Pushes the last quotes of the conflation interval that moved,
+		//	refreshes their curves and clears them. The clock is the time,
+		//	in seconds, the previous update was done at
+		void publish(std::map<size_t, double>& lastQuotes,
+					 std::vector<double>& publishedQuotes,
+					 const double intervalEnd,
+					 const double lastTickTime,
+					 double& clock,
+					 ReplayStatistics& statistics) const;
+
+		double							m_conflationInterval;
+		std::vector<Subscription>		m_subscriptions;
+		std::map<std::string, size_t>	m_subscriptionByRic;
+		std::vector<Tick>				m_ticks;
+		bool							m_sortedTicks;
+    };  //  MarketDataReplay
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_MARKETDATAREPLAY_H_INCLUDED
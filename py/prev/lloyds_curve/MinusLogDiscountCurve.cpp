@@ -41,6 +41,17 @@ namespace FlexYCF
         return m_spotRate * exp(-m_baseCurve->evaluate(flowTime));
     }
 
+    void MinusLogDiscountCurve::getDiscountFactors(vector<double>::const_iterator flowTimesBegin,
+                                                   vector<double>::const_iterator flowTimesEnd,
+                                                   vector<double>::iterator discountFactorsBegin) const
+    {
+        m_baseCurve->evaluateSorted(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+        for(; flowTimesBegin != flowTimesEnd; ++flowTimesBegin, ++discountFactorsBegin)
+        {
+            *discountFactorsBegin = m_spotRate * exp(-*discountFactorsBegin);
+        }
+    }
+
     void MinusLogDiscountCurve::accumulateDiscountFactorGradient(const double x, 
                                                                  double multiplier, 
                                                                  GradientIterator gradientBegin, 
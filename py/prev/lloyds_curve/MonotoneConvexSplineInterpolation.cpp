@@ -45,6 +45,12 @@ namespace FlexYCF
             m_L.resize(kpSize);
             m_M.clear();
             m_M.resize(kpSize);
+            m_coef1.clear();
+            m_coef1.resize(kpSize);
+            m_coef2.clear();
+            m_coef2.resize(kpSize);
+            m_coef3.clear();
+            m_coef3.resize(kpSize);
 
 			update();
 
@@ -189,6 +195,8 @@ namespace FlexYCF
         {
             enforceInterpolantPositivity();
         }
+
+        computeCoefficients();
 	}
 
     void MonotoneConvexSplineInterpolation::computeKLM(const size_t idx)
@@ -199,6 +207,24 @@ namespace FlexYCF
     }
 
 
+    void MonotoneConvexSplineInterpolation::computeCoefficients()
+    {
+        // Coefficients of the remainder integral, once the f_i's are final
+        for(size_t index(1); index < m_coef1.size(); ++index)
+        {
+            m_coef1[index] = m_f[index - 1] - m_df[index];
+            m_coef3[index] = m_coef1[index] + m_f[index] - m_df[index];
+            m_coef2[index] = m_coef1[index] + m_coef3[index];
+        }
+
+        // Positions of the gradients relative to the knot-points
+        m_unknownsBefore.resize(size() + 1);
+        m_unknownsBefore[0] = 0;
+        for(const_iterator iter(begin()); iter != end(); ++iter)
+        {
+            m_unknownsBefore[iter - begin() + 1] = m_unknownsBefore[iter - begin()] + (isUnknownKnotPoint(*iter) ? 1 : 0);
+        }
+    }
     
     // This doesn't work with the gradient at the moment at the truncation function is not differentiable at certain points.
     void MonotoneConvexSplineInterpolation::enforceInterpolantPositivity()
@@ -296,8 +322,27 @@ namespace FlexYCF
 
     double MonotoneConvexSplineInterpolation::evaluate(const double x) const
     {
-        const_iterator upper(upperBound(x));
-        
+        return evaluate(upperBound(x), x);
+    }
+
+    void MonotoneConvexSplineInterpolation::evaluateSorted(vector<double>::const_iterator xBegin,
+                                                           vector<double>::const_iterator xEnd,
+                                                           vector<double>::iterator yBegin) const
+    {
+        const_iterator upper(begin());
+        for(; xBegin != xEnd; ++xBegin, ++yBegin)
+        {
+            const double x(*xBegin);
+            while(upper != end() && !(x < upper->x))
+            {
+                ++upper;
+            }
+            *yBegin = evaluate(upper, x);
+        }
+    }
+
+    double MonotoneConvexSplineInterpolation::evaluate(const_iterator upper, const double x) const
+    {
         // If before the first knot-point, extend flat
         if(upper == begin())
         {
@@ -323,13 +368,9 @@ namespace FlexYCF
             const double delta_t(upper->x - previous->x);
             const double x_t((x - previous->x) / delta_t);
         
-            // coefficient of the polynomial in x(t) in the remainder integral from t[i-1] to t (x in the function)
-            const double coef1(m_f[index - 1] - m_df[index]);       // could be precomputed - this is also g[i-1]
-            // const double g_i(m_f[index] - m_df[index]);             // g[index] just for debug... in particular we g[i]>0 and g[i-1]>0, we might have negative forwards
-            const double coef3(coef1 + m_f[index] - m_df[index]);   // could be precomputed
-            const double coef2(coef1 + coef3);
-
-            const double remainderIntegral(delta_t * x_t * (coef1 + x_t * (-coef2 + x_t * coef3)));
+            // coefficients of the polynomial in x(t) in the remainder integral from t[i-1] to t (x in the function),
+            // precomputed on update
+            const double remainderIntegral(delta_t * x_t * (m_coef1[index] + x_t * (-m_coef2[index] + x_t * m_coef3[index])));
 
             //return m_knotPoints[index].y * x_t + m_knotPoints[index - 1].y * (1.0 - x_t) + remainderIntegral;
             // Replaced by:
@@ -364,7 +405,7 @@ namespace FlexYCF
             const double xDiff(upper->x - lower->x);
 
             GradientIterator gradientIterator(gradientBegin);
-            gradientIterator += count_if(begin(), lower, isUnknownKnotPoint);
+            gradientIterator += m_unknownsBefore[lower - begin()];
             if(isUnknownKnotPoint(*lower))
             {
                 *gradientIterator += multiplier * (upper->x - x) / xDiff;
@@ -434,7 +475,7 @@ namespace FlexYCF
             }
             else
             {
-                gradientIterator += count_if(begin(), upper - 2, isUnknownKnotPoint);
+                gradientIterator += m_unknownsBefore[index - 2];
 
                 if(isUnknownKnotPoint(*(upper - 2)))
                 {
@@ -33,6 +33,12 @@ namespace FlexYCF
 												   const double positivityCoef = 2.0);
         virtual double evaluate(const double x) const;
 
+        /// Evaluates the curve at the points sorted in ascending order,
+        /// moving forward through the intervals instead of searching each
+        virtual void evaluateSorted(std::vector<double>::const_iterator xBegin,
+                                    std::vector<double>::const_iterator xEnd,
+                                    std::vector<double>::iterator yBegin) const;
+
         /// Computes the gradient relative to the unknowns
         /// and adds multiplier times the gradient to the points between the iterators supplied
         virtual void accumulateGradient(const double x, double multiplier, GradientIterator gradientBegin, GradientIterator gradientEnd) const; 
@@ -73,12 +79,27 @@ namespace FlexYCF
         std::vector<std::vector<double> > m_gL;  
         std::vector<std::vector<double> > m_gR;
 
+        // Coefficients of the polynomial of the remainder integral on each interval [t[i-1], t[i][,
+        // computed on update: m_coef1[i] = g[i-1], m_coef3[i] = g[i-1] + g[i], m_coef2[i] = m_coef1[i] + m_coef3[i]
+        std::vector<double> m_coef1;
+        std::vector<double> m_coef2;
+        std::vector<double> m_coef3;
+
+        // m_unknownsBefore[i] is the number of unknown knot-points before the i-th one,
+        // i.e. the position of the gradient relative to the i-th knot-point if it is unknown
+        std::vector<size_t> m_unknownsBefore;
+
         bool m_enforcePositivity;
         // the coefficent such that we require  0 < f_iMinus1 < posCoef * discFwd_i and 0 < f_i < posCoef * discFwd_i
         double m_positivityCoef;   // 3.0 is sufficient, but H&W suggest 2.0 "to remain a reasonable distance away from 0"
         
             
         void computeKLM(const size_t idx);
+
+        void computeCoefficients();
+
+        // Evaluates the curve at x, upper being the first knot-point after x
+        double evaluate(const_iterator upper, const double x) const;
         
         // This is to enforce positivity of the interpolant (see Hagan & West pp 25, 26)
         void enforceInterpolantPositivity();
@@ -135,6 +135,39 @@ namespace FlexYCF
                   );
     }
 
+    void MultiTenorModel::getSortedDiscountFactors(vector<double>::const_iterator flowTimesBegin,
+                                                   vector<double>::const_iterator flowTimesEnd,
+                                                   vector<double>::iterator discountFactorsBegin) const
+    {
+        vector<double> discountSpreads(distance(flowTimesBegin, flowTimesEnd));
+        m_baseRateCurve->evaluateSorted(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+        m_discountSpreadCurve->evaluateSorted(flowTimesBegin, flowTimesEnd, discountSpreads.begin());
+
+        for(vector<double>::const_iterator discountSpread(discountSpreads.begin()); flowTimesBegin != flowTimesEnd; ++flowTimesBegin, ++discountFactorsBegin, ++discountSpread)
+        {
+            *discountFactorsBegin = exp( -( *discountFactorsBegin
+                                          + *discountSpread
+                                          + StructureSurfaceHolder::holdee().getLogFvf(*flowTimesBegin) )
+                                       );
+        }
+    }
+
+    void MultiTenorModel::getSortedTenorDiscountFactors(vector<double>::const_iterator flowTimesBegin,
+                                                        vector<double>::const_iterator flowTimesEnd,
+                                                        const double tenor,
+                                                        vector<double>::iterator discountFactorsBegin) const
+    {
+        m_baseRateCurve->evaluateSorted(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+
+        for(; flowTimesBegin != flowTimesEnd; ++flowTimesBegin, ++discountFactorsBegin)
+        {
+            *discountFactorsBegin = exp( -( *discountFactorsBegin
+                                          + m_tenorSpreadSurface.interpolateCurve(tenor, *flowTimesBegin)
+                                          + StructureSurfaceHolder::holdee().getLogFvf(*flowTimesBegin) )
+                                       );
+        }
+    }
+
     // For a point Ri on the base rate curve, the partial derivative dP(t) / dRi can we decomposed as:
     //  dP(t) / dR(t)  x  dR(t) / dRi.  From there, dP(t)/dR(t) = - P(t)  because P(t) = exp{-[R(t) + DiscSpread(t)]}, and can be computed
     //  directly from the model. dR(t) / dRi is computed by a virtual function in the curve class that delegates calculation
@@ -408,6 +441,11 @@ namespace FlexYCF
         m_tenorSpreadSurface.finalize();    
     }
 
+	void MultiTenorModel::setCalibrating(const bool calibrating)
+	{
+		m_tenorSpreadSurface.enableCurveCaches(calibrating);
+	}
+
 	void MultiTenorModel::initializeKnotPoints()
 	{
 		// Default initialization to ease testing
@@ -66,6 +66,16 @@ namespace FlexYCF
         virtual double getTenorDiscountFactor(const double flowTime, 
                                               const double tenor) const;
 
+        /// Evaluates the base rate and spread curves once
+        /// for all the sorted flow times
+        virtual void getSortedDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                              std::vector<double>::const_iterator flowTimesEnd,
+                                              std::vector<double>::iterator discountFactorsBegin) const;
+        virtual void getSortedTenorDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                                   std::vector<double>::const_iterator flowTimesEnd,
+                                                   const double tenor,
+                                                   std::vector<double>::iterator discountFactorsBegin) const;
+
         virtual void accumulateDiscountFactorGradient(const double flowTime, 
                                                       double multiplier,
                                                       GradientIterator gradientBegin,
@@ -109,6 +119,9 @@ namespace FlexYCF
 		virtual void update();
         virtual void finalize();
 
+		/// The cached tenor spread curves are only cached during calibration
+		virtual void setCalibrating(const bool calibrating);
+
 		virtual void initializeKnotPoints();
 		virtual void initializeKnotPoints(const CurveTypeConstPtr& curveType,
 										  const double initialSpotRate);
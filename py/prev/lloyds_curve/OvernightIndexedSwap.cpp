@@ -493,6 +493,12 @@ namespace FlexYCF
 		m_floatingLeg->fillRepFlows(assetDomain, model, -multiplier, indexRepFlows);
 	}
 
+	void OvernightIndexedSwap::fillPortfolioCashFlows(PortfolioCashFlows& cashFlows, const double multiplier) const
+	{
+		m_fixedLeg->fillPortfolioCashFlows(cashFlows, multiplier * getRate());
+		m_floatingLeg->fillPortfolioCashFlows(cashFlows, -multiplier);
+	}
+
 	double OvernightIndexedSwap::getDifferenceWithNewRate(const LTQuant::GenericData& instrumentListData) const
 	{
 		return doGetDifferenceWithNewRate(instrumentListData, getKey<OvernightIndexedSwap>(), IDeA_KEY(OIS, TENOR), IDeA_KEY(OIS, RATE));
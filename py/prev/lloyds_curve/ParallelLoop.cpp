@@ -0,0 +1,123 @@
+/*****************************************************************************
+
+	ParallelLoop
+
+	Implementation of the parallelLoop function
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "ParallelLoop.h"
+
+#include <sstream>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/detail/atomic_count.hpp>
+
+using namespace std;
+
+namespace FlexYCF
+{
+	namespace
+	{
+		//	The state shared by the threads running the loop
+		class LoopSchedule
+		{
+		public:
+			LoopSchedule(const size_t size, const std::tr1::function<void (const size_t)>& body):
+				m_size(size),
+				m_body(body),
+				m_numberOfTakenIndices(0)
+			{
+			}
+
+			//	Worker thread loop: runs the iterations not taken yet
+			void run()
+			{
+				for(size_t index(takeIndex()); index < m_size; index = takeIndex())
+				{
+					try
+					{
+						m_body(index);
+					}
+					catch(const std::exception& e)
+					{
+						addError(index, e.what());
+					}
+					catch(...)
+					{
+						addError(index, "unknown error");
+					}
+				}
+			}
+
+			const string getErrors() const
+			{
+				return m_errors.str();
+			}
+
+		private:
+			size_t takeIndex()
+			{
+				return static_cast<size_t>(++m_numberOfTakenIndices) - 1;
+			}
+
+			void addError(const size_t index, const string& error)
+			{
+				boost::mutex::scoped_lock lock(m_mutex);
+				m_errors << index << ": " << error << endl;
+			}
+
+			const size_t									m_size;
+			const std::tr1::function<void (const size_t)>&	m_body;
+			boost::detail::atomic_count						m_numberOfTakenIndices;
+			ostringstream									m_errors;
+			boost::mutex									m_mutex;
+		};
+	}
+
+	void parallelLoop(const size_t size,
+					  const size_t numberOfThreads,
+					  const std::tr1::function<void (const size_t)>& body)
+	{
+		if(numberOfThreads <= 1 || size <= 1)
+		{
+			for(size_t index(0); index < size; ++index)
+			{
+				body(index);
+			}
+			return;
+		}
+
+		LoopSchedule schedule(size, body);
+
+		//	The calling thread takes part in the loop
+		boost::thread_group threads;
+		try
+		{
+			for(size_t k(1); k < min(numberOfThreads, size); ++k)
+			{
+				threads.create_thread(boost::bind(&LoopSchedule::run, &schedule));
+			}
+		}
+		catch(...)
+		{
+			//	The threads already started use the schedule, on this stack
+			threads.join_all();
+			throw;
+		}
+		schedule.run();
+		threads.join_all();
+
+		const string errors(schedule.getErrors());
+		if(!errors.empty())
+		{
+			LT_THROW_ERROR("Iterations of the parallel loop failed:" << endl << errors);
+		}
+	}
+}
@@ -0,0 +1,37 @@
+/*****************************************************************************
+
+    ParallelLoop
+
+	Runs the iterations of an index loop on several threads.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_PARALLELLOOP_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_PARALLELLOOP_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+
+#include <functional>
+
+
+namespace FlexYCF
+{
+	/// Calls the body for each index from 0 to size - 1, on up to the specified
+	/// number of threads, the calling thread included. The threads take the
+	/// indices in turn, so the iterations must be independent.
+	///
+	/// The loop is run on the calling thread only if one thread is requested
+	/// or if there is a single iteration. If any iteration throws, the other
+	/// iterations still run and an error listing all the failures is thrown
+	/// once the threads are joined.
+	void parallelLoop(const size_t size,
+					  const size_t numberOfThreads,
+					  const std::tr1::function<void (const size_t)>& body);
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_PARALLELLOOP_H_INCLUDED
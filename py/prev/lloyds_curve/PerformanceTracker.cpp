@@ -7,6 +7,34 @@ using namespace LTQC;
 
 namespace FlexYCF
 {
+    namespace
+    {
+        //    Quotes the fields holding a comma, a quote or a line break, doubling their quotes
+        string escapeCsv(const string& field)
+        {
+            if(field.find_first_of(",\"\r\n") == string::npos)
+            {
+                return field;
+            }
+            string escaped("\"");
+            for(string::const_iterator iter(field.begin()); iter != field.end(); ++iter)
+            {
+                if(*iter == '"')
+                {
+                    escaped += '"';
+                }
+                escaped += *iter;
+            }
+            return escaped + "\"";
+        }
+
+        //    Prints a counter with the columns of the keys, as a single value
+        void printCsvCounter(ostream& out, const char* const key, const double value)
+        {
+            out << key << ",1," << value << ",0," << value << "," << value << endl;
+        }
+    }
+
     bool PerformanceTracker::exists(const string& key) const
     {
         Container::const_iterator lower(lowerBound(key));
@@ -107,6 +135,42 @@ namespace FlexYCF
         outputFile.close();
     }
 
+    ostream& PerformanceTracker::printCsv(ostream& out) const
+    {
+        const streamsize precision(out.precision(10));
+        out << "key,count,mean,stddev,min,max" << endl;
+        for(Container::const_iterator iter(m_tracker.begin()); iter != m_tracker.end(); ++iter)
+        {
+            const vector<double>& values(iter->second);
+            out << escapeCsv(iter->first) << "," << values.size();
+            if(values.empty())
+            {
+                out << ",,,," << endl;
+                continue;
+            }
+            out << "," << mean(values)
+                << "," << (values.size() > 1 ? meanAndStdDev(iter->first).second : 0.0)
+                << "," << *min_element(values.begin(), values.end())
+                << "," << *max_element(values.begin(), values.end()) << endl;
+        }
+
+        printCsvCounter(out, "solver.variables", static_cast<double>(m_numberOfVariables));
+        printCsvCounter(out, "solver.functions", static_cast<double>(m_numberOfFunctions));
+        printCsvCounter(out, "solver.iterations", static_cast<double>(m_numberOfIterations));
+        printCsvCounter(out, "solver.functionEvaluations", static_cast<double>(m_numberOfFunctionEvaluations));
+        printCsvCounter(out, "solver.jacobianCalculations", static_cast<double>(m_numberOfJacobianCalculations));
+
+        out.precision(precision);
+        return out;
+    }
+
+    void PerformanceTracker::saveCsv(const string& filename) const
+    {
+        ofstream outputFile(filename.c_str());
+        printCsv(outputFile);
+        outputFile.close();
+    }
+
     PerformanceTracker::Container::iterator PerformanceTracker::lowerBound(const string& key)
     {
         return lower_bound(m_tracker.begin(), m_tracker.end(), key, KeyCompare());
@@ -24,6 +24,15 @@ namespace FlexYCF
         typedef std::vector<KeyValuePair>            Container;
 
     public:
+        PerformanceTracker():
+            m_numberOfVariables(0),
+            m_numberOfFunctions(0),
+            m_numberOfIterations(0),
+            m_numberOfFunctionEvaluations(0),
+            m_numberOfJacobianCalculations(0)
+        {
+        }
+
         bool exists(const std::string& key) const;
         void insert(const std::string& key);
         std::vector<double>& operator[](const std::string& key);
@@ -36,6 +45,13 @@ namespace FlexYCF
         std::ostream& print(std::ostream& out) const;
         void save(const std::string& filename) const;
 
+        /// Prints one comma-separated line per key (count, mean, std. dev,
+        /// min and max) followed by the solver counters, each as a single
+        /// value with the same columns, so that the
+        /// figures can be compared across runs and releases
+        std::ostream& printCsv(std::ostream& out) const;
+        void saveCsv(const std::string& filename) const;
+
         void setNumberOfIterations(const long numIterations);
         void setNumberOfFunctionEvaluations(const long numEvaluations);
         void setNumberOfJacobianCalculations(const long numGradCalcs);
@@ -0,0 +1,79 @@
+/*****************************************************************************
+
+	PortfolioCashFlows
+
+	Implementation of the PortfolioCashFlows
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "PortfolioCashFlows.h"
+
+using namespace std;
+
+namespace FlexYCF
+{
+	void PortfolioCashFlows::addFixedCashFlow(const double amount, const LT::date paymentDate)
+	{
+		CashFlow cashFlow;
+		cashFlow.amount = amount;
+		cashFlow.paymentDate = paymentDate;
+		cashFlow.indexCurve = NoIndexCurve;
+		cashFlow.startDate = paymentDate;
+		cashFlow.endDate = paymentDate;
+		m_cashFlows.push_back(cashFlow);
+	}
+
+	void PortfolioCashFlows::addFloatingCashFlow(const double amount,
+												 const LT::date startDate,
+												 const LT::date endDate,
+												 const double tenor,
+												 const LTQC::Currency& currency,
+												 const LT::Str& index,
+												 const LT::date paymentDate)
+	{
+		CashFlow cashFlow;
+		cashFlow.amount = amount;
+		cashFlow.paymentDate = paymentDate;
+		cashFlow.indexCurve = getIndexCurve(tenor, currency, index);
+		cashFlow.startDate = startDate;
+		cashFlow.endDate = endDate;
+		m_cashFlows.push_back(cashFlow);
+	}
+
+	size_t PortfolioCashFlows::closeTrade()
+	{
+		m_tradeEnds.push_back(m_cashFlows.size());
+		return m_tradeEnds.size() - 1;
+	}
+
+	void PortfolioCashFlows::discardOpenTrade()
+	{
+		m_cashFlows.resize(m_tradeEnds.empty() ? 0 : m_tradeEnds.back());
+	}
+
+	size_t PortfolioCashFlows::getIndexCurve(const double tenor, const LTQC::Currency& currency, const LT::Str& index)
+	{
+		//	a book only has a handful of index curves
+		for(size_t curve(0); curve < m_indexCurves.size(); ++curve)
+		{
+			if(m_indexCurves[curve].tenor == tenor
+				&& m_indexCurves[curve].currency.compareCaseless(currency) == 0
+				&& m_indexCurves[curve].index.compareCaseless(index) == 0)
+			{
+				return curve;
+			}
+		}
+
+		IndexCurve indexCurve;
+		indexCurve.tenor = tenor;
+		indexCurve.currency = currency;
+		indexCurve.index = index;
+		m_indexCurves.push_back(indexCurve);
+		return m_indexCurves.size() - 1;
+	}
+}
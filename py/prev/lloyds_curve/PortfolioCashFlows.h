@@ -0,0 +1,118 @@
+/*****************************************************************************
+
+    PortfolioCashFlows
+
+	The cash flows of a book of trades, as linear functions of the
+	discount factors of a model.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_PORTFOLIOCASHFLOWS_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_PORTFOLIOCASHFLOWS_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+#include "Currency.h"
+
+
+namespace FlexYCF
+{
+	/// PortfolioCashFlows holds the cash flows of the trades of a book, added
+	/// trade after trade by their legs (see fillPortfolioCashFlows).
+	///
+	/// A cash flow is worth its amount times the discount factor at its
+	/// payment date. The amount of a floating cash flow is further multiplied
+	/// by P(start) / P(end) - 1, where P is the Tenor discount factor of its
+	/// index curve: this covers both the IBOR forward rates and the compounded
+	/// overnight rates. The cash flows hold dates, not flow times, so that the
+	/// same book can be valued against models with different value dates.
+	class PortfolioCashFlows
+	{
+	public:
+		/// The Tenor discount factor curve a floating cash flow is indexed on
+		struct IndexCurve
+		{
+			double			tenor;
+			LTQC::Currency	currency;
+			LT::Str			index;
+		};
+
+		struct CashFlow
+		{
+			double		amount;
+			LT::date	paymentDate;
+			size_t		indexCurve;		// NoIndexCurve for a fixed cash flow
+			LT::date	startDate;
+			LT::date	endDate;
+		};
+
+		static const size_t NoIndexCurve = static_cast<size_t>(-1);
+
+		/// Adds a cash flow of the specified amount paid at the payment date
+		void addFixedCashFlow(const double amount, const LT::date paymentDate);
+
+		/// Adds a cash flow of the specified amount times the rate of the index
+		/// curve between the start and end dates, paid at the payment date
+		void addFloatingCashFlow(const double amount,
+								 const LT::date startDate,
+								 const LT::date endDate,
+								 const double tenor,
+								 const LTQC::Currency& currency,
+								 const LT::Str& index,
+								 const LT::date paymentDate);
+
+		/// Makes the cash flows added since the previous trade a new trade
+		/// and returns its index
+		size_t closeTrade();
+
+		/// Removes the cash flows added since the previous trade, e.g. when
+		/// one of the legs of the trade failed to add its cash flows
+		void discardOpenTrade();
+
+		/// Returns the number of cash flows
+		size_t size() const
+		{
+			return m_cashFlows.size();
+		}
+
+		const CashFlow& operator[](const size_t index) const
+		{
+			return m_cashFlows[index];
+		}
+
+		size_t getNumberOfTrades() const
+		{
+			return m_tradeEnds.size();
+		}
+
+		/// Returns the index of the first cash flow of the trade
+		size_t getTradeBegin(const size_t trade) const
+		{
+			return (trade == 0 ? 0 : m_tradeEnds[trade - 1]);
+		}
+
+		/// Returns the index of one past the last cash flow of the trade
+		size_t getTradeEnd(const size_t trade) const
+		{
+			return m_tradeEnds[trade];
+		}
+
+		const std::vector<IndexCurve>& getIndexCurves() const
+		{
+			return m_indexCurves;
+		}
+
+	private:
+		size_t getIndexCurve(const double tenor, const LTQC::Currency& currency, const LT::Str& index);
+
+		std::vector<CashFlow>	m_cashFlows;
+		std::vector<size_t>		m_tradeEnds;
+		std::vector<IndexCurve>	m_indexCurves;
+	};  //  PortfolioCashFlows
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_PORTFOLIOCASHFLOWS_H_INCLUDED
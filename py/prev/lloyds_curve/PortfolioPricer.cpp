@@ -0,0 +1,192 @@
+/*****************************************************************************
+
+	PortfolioPricer
+
+	Implementation of the PortfolioPricer
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "PortfolioPricer.h"
+#include "BaseModel.h"
+#include "InterestRateSwap.h"
+#include "OvernightIndexedSwap.h"
+#include "TenorBasisSwap.h"
+#include "ParallelLoop.h"
+#include "DateUtils.h"
+
+#include <algorithm>
+#include <boost/thread/thread.hpp>
+
+using namespace std;
+
+namespace FlexYCF
+{
+	namespace
+	{
+		//	The number of trades a thread reduces at a time
+		const size_t s_tradesPerBlock(256);
+
+		//	Sorts the dates and removes the duplicates
+		void sortUnique(vector<LT::date>& dates)
+		{
+			sort(dates.begin(), dates.end());
+			dates.erase(unique(dates.begin(), dates.end()), dates.end());
+		}
+
+		size_t findDate(const vector<LT::date>& sortedDates, const LT::date date)
+		{
+			return lower_bound(sortedDates.begin(), sortedDates.end(), date) - sortedDates.begin();
+		}
+	}
+
+	PortfolioPricer::PortfolioPricer(const size_t numberOfThreads):
+		m_numberOfThreads(numberOfThreads == 0 ? max(1u, boost::thread::hardware_concurrency()) : numberOfThreads),
+		m_datesIndexed(false)
+	{
+	}
+
+	template<class Swap>
+	size_t PortfolioPricer::addSwap(const Swap& swap, const double notional)
+	{
+		//	the failed trades may still add index curves
+		m_datesIndexed = false;
+		try
+		{
+			swap.fillPortfolioCashFlows(m_cashFlows, notional);
+		}
+		catch(...)
+		{
+			//	keep the book consistent: no cash flow of the failed trade
+			m_cashFlows.discardOpenTrade();
+			throw;
+		}
+		return m_cashFlows.closeTrade();
+	}
+
+	size_t PortfolioPricer::add(const InterestRateSwap& swap, const double notional)
+	{
+		return addSwap(swap, notional);
+	}
+
+	size_t PortfolioPricer::add(const OvernightIndexedSwap& swap, const double notional)
+	{
+		return addSwap(swap, notional);
+	}
+
+	size_t PortfolioPricer::add(const TenorBasisSwap& swap, const double notional)
+	{
+		return addSwap(swap, notional);
+	}
+
+	void PortfolioPricer::computePresentValues(const BaseModel& model, vector<double>& presentValues)
+	{
+		if(!m_datesIndexed)
+		{
+			indexDates();
+		}
+
+		const LT::date valueDate(model.getValueDate());
+		const vector<PortfolioCashFlows::IndexCurve>& indexCurves(m_cashFlows.getIndexCurves());
+
+		//	Flow times as DiscountFactorArguments computes them
+		vector<double> flowTimes(m_paymentDates.size());
+		for(size_t k(0); k < m_paymentDates.size(); ++k)
+		{
+			flowTimes[k] = (m_paymentDates[k] == valueDate ? 0.0 : ModuleDate::getYearsBetween(valueDate, m_paymentDates[k]));
+		}
+		vector<double> discountFactors(flowTimes.size());
+		model.getSortedDiscountFactors(flowTimes.begin(), flowTimes.end(), discountFactors.begin());
+
+		//	Flow times as TenorDiscountFactorArguments computes them
+		vector< vector<double> > tenorDiscountFactors(indexCurves.size());
+		for(size_t curve(0); curve < indexCurves.size(); ++curve)
+		{
+			const vector<LT::date>& indexDates(m_indexDates[curve]);
+			vector<double> indexTimes(indexDates.size());
+			for(size_t k(0); k < indexDates.size(); ++k)
+			{
+				indexTimes[k] = (valueDate >= indexDates[k] ? 0.0 : ModuleDate::getYearsBetween(valueDate, indexDates[k]));
+			}
+
+			tenorDiscountFactors[curve].resize(indexTimes.size());
+			if(!indexCurves[curve].currency.empty() && !indexCurves[curve].index.empty())
+			{
+				model.getSortedTenorDiscountFactors(indexTimes.begin(), indexTimes.end(), indexCurves[curve].tenor,
+													indexCurves[curve].currency, indexCurves[curve].index, tenorDiscountFactors[curve].begin());
+			}
+			else
+			{
+				model.getSortedTenorDiscountFactors(indexTimes.begin(), indexTimes.end(), indexCurves[curve].tenor, tenorDiscountFactors[curve].begin());
+			}
+		}
+
+		//	Reduce the cash flows to the trades, one block of trades per iteration
+		const size_t numberOfTrades(m_cashFlows.getNumberOfTrades());
+		presentValues.assign(numberOfTrades, 0.0);
+		parallelLoop((numberOfTrades + s_tradesPerBlock - 1) / s_tradesPerBlock, m_numberOfThreads, [&] (const size_t block)
+		{
+			const size_t tradesEnd(min(numberOfTrades, (block + 1) * s_tradesPerBlock));
+			for(size_t trade(block * s_tradesPerBlock); trade < tradesEnd; ++trade)
+			{
+				double presentValue(0.0);
+				for(size_t k(m_cashFlows.getTradeBegin(trade)); k < m_cashFlows.getTradeEnd(trade); ++k)
+				{
+					const PortfolioCashFlows::CashFlow& cashFlow(m_cashFlows[k]);
+					double value(cashFlow.amount * discountFactors[m_paymentDateIndices[k]]);
+					if(cashFlow.indexCurve != PortfolioCashFlows::NoIndexCurve)
+					{
+						const vector<double>& indexDiscountFactors(tenorDiscountFactors[cashFlow.indexCurve]);
+						value *= indexDiscountFactors[m_startDateIndices[k]] / indexDiscountFactors[m_endDateIndices[k]] - 1.0;
+					}
+					presentValue += value;
+				}
+				presentValues[trade] = presentValue;
+			}
+		});
+	}
+
+	void PortfolioPricer::indexDates()
+	{
+		const size_t numberOfCashFlows(m_cashFlows.size());
+
+		m_paymentDates.clear();
+		m_indexDates.assign(m_cashFlows.getIndexCurves().size(), vector<LT::date>());
+		for(size_t k(0); k < numberOfCashFlows; ++k)
+		{
+			const PortfolioCashFlows::CashFlow& cashFlow(m_cashFlows[k]);
+			m_paymentDates.push_back(cashFlow.paymentDate);
+			if(cashFlow.indexCurve != PortfolioCashFlows::NoIndexCurve)
+			{
+				m_indexDates[cashFlow.indexCurve].push_back(cashFlow.startDate);
+				m_indexDates[cashFlow.indexCurve].push_back(cashFlow.endDate);
+			}
+		}
+
+		sortUnique(m_paymentDates);
+		for(size_t curve(0); curve < m_indexDates.size(); ++curve)
+		{
+			sortUnique(m_indexDates[curve]);
+		}
+
+		m_paymentDateIndices.resize(numberOfCashFlows);
+		m_startDateIndices.assign(numberOfCashFlows, 0);
+		m_endDateIndices.assign(numberOfCashFlows, 0);
+		for(size_t k(0); k < numberOfCashFlows; ++k)
+		{
+			const PortfolioCashFlows::CashFlow& cashFlow(m_cashFlows[k]);
+			m_paymentDateIndices[k] = findDate(m_paymentDates, cashFlow.paymentDate);
+			if(cashFlow.indexCurve != PortfolioCashFlows::NoIndexCurve)
+			{
+				m_startDateIndices[k] = findDate(m_indexDates[cashFlow.indexCurve], cashFlow.startDate);
+				m_endDateIndices[k] = findDate(m_indexDates[cashFlow.indexCurve], cashFlow.endDate);
+			}
+		}
+
+		m_datesIndexed = true;
+	}
+}
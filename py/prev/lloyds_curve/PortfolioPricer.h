@@ -0,0 +1,88 @@
+/*****************************************************************************
+
+    PortfolioPricer
+
+	Values a book of swaps against a solved model in batched curve calls.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_PORTFOLIOPRICER_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_PORTFOLIOPRICER_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+#include "PortfolioCashFlows.h"
+
+
+namespace FlexYCF
+{
+	class BaseModel;
+	class InterestRateSwap;
+	class OvernightIndexedSwap;
+	class TenorBasisSwap;
+
+    /// PortfolioPricer computes the present values of a book of swaps
+	/// against a solved model.
+	///
+	/// The swaps are added once: their legs add their cash flows to the book
+	/// without creating any instrument component. The first valuation then
+	/// gathers the payment dates and the index dates of each index curve,
+	/// sorted and without duplicates. Each valuation evaluates the discount
+	/// factors at the payment dates, then the Tenor discount factors of each
+	/// index curve, in one batched model call each, and reduces the cash
+	/// flows to the present values of the trades on several threads.
+	///
+	/// Note: the swaps are valued as computeModelPrice does, times their
+	/// notional. Floating legs of arithmetic overnight or funding rates
+	/// are not supported.
+    class PortfolioPricer
+    {
+    public:
+		/// Creates a pricer reducing the present values on the specified
+		/// number of threads. Zero stands for the number of hardware threads.
+        explicit PortfolioPricer(const size_t numberOfThreads = 0);
+
+		/// Adds a trade on the swap, returns the index of the trade
+		size_t add(const InterestRateSwap& swap, const double notional = 1.0);
+		size_t add(const OvernightIndexedSwap& swap, const double notional = 1.0);
+		size_t add(const TenorBasisSwap& swap, const double notional = 1.0);
+
+		/// Returns the number of trades
+		size_t size() const
+		{
+			return m_cashFlows.getNumberOfTrades();
+		}
+
+		/// Computes the present values of the trades against the model,
+		/// in the order the trades were added
+		void computePresentValues(const BaseModel& model, std::vector<double>& presentValues);
+
+		size_t getNumberOfThreads() const
+		{
+			return m_numberOfThreads;
+		}
+
+    private:
+		template<class Swap>
+		size_t addSwap(const Swap& swap, const double notional);
+
+		//	Gathers the sorted dates and the positions of the dates of each cash flow
+		void indexDates();
+
+		size_t								m_numberOfThreads;
+		PortfolioCashFlows					m_cashFlows;
+		bool								m_datesIndexed;
+
+		std::vector<LT::date>				m_paymentDates;			// sorted, without duplicates
+		std::vector< std::vector<LT::date> >	m_indexDates;			// per index curve, sorted, without duplicates
+		std::vector<size_t>					m_paymentDateIndices;	// per cash flow
+		std::vector<size_t>					m_startDateIndices;		// per cash flow, unused for fixed cash flows
+		std::vector<size_t>					m_endDateIndices;		// per cash flow, unused for fixed cash flows
+    };  //  PortfolioPricer
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_PORTFOLIOPRICER_H_INCLUDED
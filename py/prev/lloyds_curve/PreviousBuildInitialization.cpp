@@ -0,0 +1,152 @@
+/*****************************************************************************
+    
+	PreviousBuildInitialization
+
+	Implementation of the PreviousBuildInitialization
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "PreviousBuildInitialization.h"
+#include "BaseModel.h"
+#include "SpineDataCache.h"
+#include "SpineDataSnapshot.h"
+#include "DateUtils.h"
+
+#include "Data/GenericData.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace LTQC;
+
+namespace FlexYCF
+{
+	namespace
+	{
+		typedef vector<pair<double, double> > SpinePoints;
+
+		//	Returns the y-value of the spine points at x, interpolated
+		//	linearly and extrapolated flat
+		double interpolate(const SpinePoints& points, const double x)
+		{
+			if(x <= points.front().first)
+			{
+				return points.front().second;
+			}
+			if(x >= points.back().first)
+			{
+				return points.back().second;
+			}
+			const SpinePoints::const_iterator upper(lower_bound(points.begin(), points.end(), make_pair(x, 0.0)));
+			const SpinePoints::const_iterator lower(upper - 1);
+			return lower->second + (upper->second - lower->second) * (x - lower->first) / (upper->first - lower->first);
+		}
+
+		//	Returns true if the spine points are those of minus a log discount factor
+		//	(or of a log spread to one), i.e. anchored at zero at their value date
+		bool isLogDiscountFactor(const SpinePoints& points)
+		{
+			for(SpinePoints::const_iterator point(points.begin()); point != points.end() && point->first <= 0.0; ++point)
+			{
+				if(point->first == 0.0)
+				{
+					return point->second == 0.0;
+				}
+			}
+			return false;
+		}
+	}
+
+	PreviousBuildInitialization::PreviousBuildInitialization(const SpineDataSnapshotConstPtr& spineDataSnapshot, const string& key):
+		m_spineDataSnapshot(spineDataSnapshot),
+		m_key(key)
+	{
+	}
+
+	string PreviousBuildInitialization::getName()
+	{
+		return "PreviousBuild";
+	}
+
+	BaseInitializationPtr PreviousBuildInitialization::create(const LTQuant::GenericDataPtr& initializationParamsTable)
+	{
+		const string emptyString;
+		string fileName, currency, index;
+
+		if(initializationParamsTable)
+		{
+			initializationParamsTable->permissive_get<std::string>("Snapshot File", 0, fileName, emptyString);
+			initializationParamsTable->permissive_get<std::string>("Currency", 0, currency, emptyString);
+			initializationParamsTable->permissive_get<std::string>("Index", 0, index, emptyString);
+		}
+		if(fileName.empty())
+		{
+			LT_THROW_ERROR("The " << getName() << " initialization requires a 'Snapshot File'");
+		}
+
+		const SpineDataSnapshotConstPtr spineDataSnapshot(new SpineDataSnapshot(fileName));
+		string key;
+		if(!currency.empty() || !index.empty())
+		{
+			key = SpineDataSnapshot::getKey(currency, index);
+		}
+		else
+		{
+			const vector<string> keys(spineDataSnapshot->getKeys());
+			if(keys.size() != 1)
+			{
+				LT_THROW_ERROR("The spine data snapshot '" << fileName << "' contains " << keys.size() << " curves: specify the 'Currency' and 'Index' of the curve");
+			}
+			key = keys.front();
+		}
+
+		return BaseInitializationPtr(new PreviousBuildInitialization(spineDataSnapshot, key));
+	}
+
+	void PreviousBuildInitialization::doInitialize(BaseModel* const model) const
+	{
+		model->initializeKnotPoints();
+
+		SpineDataCache previous;
+		SpineDataCachePtr current(new SpineDataCache);
+		model->getSpineInternalData(current);
+		if(!m_spineDataSnapshot->read(m_key, previous) || previous.xy_.size() != current->xy_.size())
+		{
+			LT_LOG << "The previous build of " << m_key << " is not in the spine data snapshot, initializing from constant" << endl;
+			return;
+		}
+
+		//	The times of the previous knot-points are from the previous value date
+		const double timeShift(ModuleDate::getYearsBetween(previous.valueDate_, model->getValueDate()));
+
+		for(size_t k(0); k < current->xy_.size(); ++k)
+		{
+			const SpinePoints& previousPoints(previous.xy_[k]);
+			if(previousPoints.empty())
+			{
+				continue;
+			}
+
+			//	-log P(t', T) = -log P(t, T) + log P(t, t'): the log discount
+			//	factors are rebased to the new value date t'
+			const double origin(isLogDiscountFactor(previousPoints) ? interpolate(previousPoints, timeShift) : 0.0);
+			for(SpinePoints::iterator point(current->xy_[k].begin()); point != current->xy_[k].end(); ++point)
+			{
+				//	The knot-points at or before the value date are anchors of the curve
+				if(point->first > 0.0)
+				{
+					point->second = interpolate(previousPoints, point->first + timeShift) - origin;
+				}
+			}
+		}
+
+		model->assignSpineInternalData(current);
+		model->update();
+		LT_LOG << "Initialized " << m_key << " from the previous build, " << timeShift << " years before" << endl;
+	}
+}
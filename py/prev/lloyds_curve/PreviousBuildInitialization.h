@@ -0,0 +1,65 @@
+/*****************************************************************************
+
+    PreviousBuildInitialization
+
+	Initializes knot-points from the spine data of the previous build
+    
+    @Originator
+    
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_PREVIOUSBUILDINITIALIZATION_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_PREVIOUSBUILDINITIALIZATION_H_INCLUDED
+
+#include "LTQuantInitial.h"
+
+//	FlexYCF
+#include "BaseInitialization.h"
+
+
+namespace LTQuant
+{
+	FWD_DECLARE_SMART_GENERIC_DATA_PTRS
+}
+
+namespace FlexYCF
+{
+	FWD_DECLARE_SMART_PTRS( SpineDataSnapshot )
+
+	/// Warm-starts the calibration from the solved curve of the previous
+	/// build, saved in a spine data snapshot (see FlexYCFZeroCurve::saveSpineDataSnapshot).
+	///
+	/// The knot-points are first placed as by the constant initialization, 
+	/// then the y-value of each knot-point after the value date is taken 
+	/// from the previous spine curve at the same date: the previous knot-points
+	/// are shifted by the time between the two value dates and interpolated
+	/// linearly, so that knot-points whose dates moved still get a close guess.
+	/// The spine curves of minus the log discount factors (and of the log
+	/// spreads), anchored at zero at the value date, are also rebased to the
+	/// new value date: y(x) = y_prev(x + shift) - y_prev(shift).
+	/// The curve is left as by the constant initialization if the snapshot
+	/// does not contain it or if its model has a different number of spine curves.
+	///
+	/// Parameters:
+	///		Snapshot File	the spine data snapshot of the previous build
+	///		Currency, Index	the curve of the snapshot, optional if the snapshot
+	///						contains only one curve
+	class PreviousBuildInitialization : public BaseInitialization
+	{
+	public:
+		PreviousBuildInitialization(const SpineDataSnapshotConstPtr& spineDataSnapshot, const std::string& key);
+
+		static std::string getName();
+		static BaseInitializationPtr create(const LTQuant::GenericDataPtr& initializationParamsTable);
+
+	private:
+		virtual void doInitialize(BaseModel* const model) const;
+
+		SpineDataSnapshotConstPtr	m_spineDataSnapshot;
+		std::string					m_key;
+	};
+
+	DECLARE_SMART_PTRS( PreviousBuildInitialization )
+}
+#endif //__LIBRARY_PRICERS_FLEXYCF_PREVIOUSBUILDINITIALIZATION_H_INCLUDED
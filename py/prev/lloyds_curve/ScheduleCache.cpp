@@ -0,0 +1,228 @@
+/*****************************************************************************
+
+	ScheduleCache
+
+	Implementation of the ScheduleCache
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "ScheduleCache.h"
+
+#include "RollConv.h"
+#include "dates/DateBuilderGenerator.h"
+
+#include <map>
+#include <boost/thread/mutex.hpp>
+
+using namespace std;
+using namespace LTQC;
+
+namespace FlexYCF
+{
+	namespace
+	{
+		typedef map<ScheduleArguments, LegScheduleConstPtr, ScheduleArguments::Compare> LegSchedules;
+
+		LegSchedules	s_schedules;
+		LT::date		s_valueDate;	// of the cached schedules
+		boost::mutex	s_mutex;
+	}
+
+	ScheduleArguments::ScheduleArguments(const LT::date startDate_,
+										 const LT::date endDate_,
+										 const string& tenorDescription_,
+										 const string& calendar_,
+										 const StubType& stubType_,
+										 const RollConvMethod& rollConvention_,
+										 const RollRuleMethod& rollRuleConvention_):
+		startDate(startDate_),
+		endDate(endDate_),
+		tenorDescription(tenorDescription_),
+		calendar(calendar_),
+		stubType(stubType_),
+		rollConvention(rollConvention_),
+		rollRuleConvention(rollRuleConvention_),
+		hasPaymentDates(false)
+	{
+	}
+
+	ScheduleArguments::ScheduleArguments(const LT::date startDate_,
+										 const LT::date endDate_,
+										 const string& tenorDescription_,
+										 const string& calendar_,
+										 const StubType& stubType_,
+										 const RollConvMethod& rollConvention_,
+										 const RollRuleMethod& rollRuleConvention_,
+										 const LT::Str& payDelay_,
+										 const LT::Str& payCalendar_,
+										 const LT::Str& payRollConvention_):
+		startDate(startDate_),
+		endDate(endDate_),
+		tenorDescription(tenorDescription_),
+		calendar(calendar_),
+		stubType(stubType_),
+		rollConvention(rollConvention_),
+		rollRuleConvention(rollRuleConvention_),
+		hasPaymentDates(true),
+		payDelay(payDelay_),
+		payCalendar(payCalendar_),
+		payRollConvention(payRollConvention_)
+	{
+	}
+
+	bool ScheduleArguments::Compare::operator()(const ScheduleArguments& lhs, const ScheduleArguments& rhs) const
+	{
+		if(lhs.endDate != rhs.endDate)
+		{
+			return lhs.endDate < rhs.endDate;
+		}
+		if(lhs.startDate != rhs.startDate)
+		{
+			return lhs.startDate < rhs.startDate;
+		}
+		if(lhs.tenorDescription != rhs.tenorDescription)
+		{
+			return lhs.tenorDescription < rhs.tenorDescription;
+		}
+		if(lhs.calendar != rhs.calendar)
+		{
+			return lhs.calendar < rhs.calendar;
+		}
+		if(lhs.stubType.asString() != rhs.stubType.asString())
+		{
+			return lhs.stubType.asString() < rhs.stubType.asString();
+		}
+		if(lhs.rollConvention.asString() != rhs.rollConvention.asString())
+		{
+			return lhs.rollConvention.asString() < rhs.rollConvention.asString();
+		}
+		if(lhs.rollRuleConvention.asString() != rhs.rollRuleConvention.asString())
+		{
+			return lhs.rollRuleConvention.asString() < rhs.rollRuleConvention.asString();
+		}
+		if(lhs.hasPaymentDates != rhs.hasPaymentDates)
+		{
+			return rhs.hasPaymentDates;
+		}
+		if(lhs.payDelay != rhs.payDelay)
+		{
+			return lhs.payDelay.string() < rhs.payDelay.string();
+		}
+		if(lhs.payCalendar != rhs.payCalendar)
+		{
+			return lhs.payCalendar.string() < rhs.payCalendar.string();
+		}
+		return lhs.payRollConvention.string() < rhs.payRollConvention.string();
+	}
+
+	BuildSwitch ScheduleCache::s_enabled = BUILD_SWITCH_INIT(true);
+	size_t ScheduleCache::s_maxSize = 100000;
+
+	LegScheduleConstPtr ScheduleCache::get(const ScheduleArguments& arguments, const LT::date valueDate)
+	{
+		if(!s_enabled.isOn())
+		{
+			return generate(arguments);
+		}
+
+		{
+			boost::mutex::scoped_lock lock(s_mutex);
+			if(s_valueDate < valueDate)
+			{
+				s_schedules.clear();
+				s_valueDate = valueDate;
+			}
+
+			const LegSchedules::const_iterator schedule(valueDate == s_valueDate ? s_schedules.find(arguments) : s_schedules.end());
+			if(schedule != s_schedules.end())
+			{
+				return schedule->second;
+			}
+		}
+
+		//	Generate outside the lock: if another thread cached the same
+		//	schedule in the meantime, its schedule is kept
+		const LegScheduleConstPtr schedule(generate(arguments));
+
+		boost::mutex::scoped_lock lock(s_mutex);
+		if(valueDate != s_valueDate)
+		{
+			//	an earlier value date, or the date rolled in the meantime
+			return schedule;
+		}
+		if(s_schedules.size() >= s_maxSize)
+		{
+			s_schedules.clear();
+		}
+		return s_schedules.insert(LegSchedules::value_type(arguments, schedule)).first->second;
+	}
+
+	size_t ScheduleCache::size()
+	{
+		boost::mutex::scoped_lock lock(s_mutex);
+		return s_schedules.size();
+	}
+
+	void ScheduleCache::clear()
+	{
+		boost::mutex::scoped_lock lock(s_mutex);
+		s_schedules.clear();
+	}
+
+	void ScheduleCache::setMaxSize(const size_t maxSize)
+	{
+		boost::mutex::scoped_lock lock(s_mutex);
+		s_maxSize = maxSize;
+	}
+
+	void ScheduleCache::setEnabled(const bool enabled)
+	{
+		s_enabled.set(enabled);
+	}
+
+	LegScheduleConstPtr ScheduleCache::generate(const ScheduleArguments& arguments)
+	{
+		// ON & 1D are NOT handled by ScheduleGenerator,
+		//  so they are interpreted as 1M for now.
+		const Tenor tenor(arguments.tenorDescription == "ON" || arguments.tenorDescription == "1D" ? "1M" : arguments.tenorDescription);
+
+		const LegSchedulePtr schedule(new LegSchedule);
+		if(arguments.hasPaymentDates)
+		{
+			DateBuilderGenerator generator(DateBuilder(arguments.startDate,
+													   arguments.endDate,
+													   tenor,
+													   arguments.calendar,
+													   arguments.stubType,
+													   Date(),
+													   arguments.rollConvention,
+													   arguments.rollRuleConvention,
+													   LT::Str("1w"),
+													   RollConv(RollConvMethod::None),
+													   arguments.payDelay,
+													   arguments.payCalendar,
+													   arguments.payRollConvention));
+			generator.fillEvents(schedule->scheduleDates, schedule->paymentDates, arguments.startDate, arguments.endDate);
+		}
+		else
+		{
+			DateBuilderGenerator generator(DateBuilder(arguments.startDate,
+													   arguments.endDate,
+													   tenor,
+													   arguments.calendar,
+													   arguments.stubType,
+													   Date(),
+													   arguments.rollConvention,
+													   arguments.rollRuleConvention,
+													   LT::Str("1w"),
+													   RollConv(RollConvMethod::None)));
+			generator.fillEvents(schedule->scheduleDates, arguments.startDate, arguments.endDate);
+		}
+		return schedule;
+	}
+}
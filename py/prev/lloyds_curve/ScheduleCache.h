@@ -0,0 +1,123 @@
+/*****************************************************************************
+
+    ScheduleCache
+
+	A process-wide cache of the schedules generated for the legs of the
+	calibration instruments of the current value date.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_SCHEDULECACHE_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_SCHEDULECACHE_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+#include "BuildSwitch.h"
+#include "ModuleDate/InternalInterface/ScheduleGenerator.h"
+#include "IDeA\src\market\MarketConvention.h"
+#include "StubUtils.h"
+
+
+namespace FlexYCF
+{
+	/// The arguments a leg schedule is generated from
+	struct ScheduleArguments
+	{
+		/// The arguments of a schedule without payment dates
+		ScheduleArguments(const LT::date startDate,
+						  const LT::date endDate,
+						  const std::string& tenorDescription,
+						  const std::string& calendar,
+						  const LTQC::StubType& stubType,
+						  const LTQC::RollConvMethod& rollConvention,
+						  const LTQC::RollRuleMethod& rollRuleConvention);
+
+		/// The arguments of a schedule with payment dates
+		ScheduleArguments(const LT::date startDate,
+						  const LT::date endDate,
+						  const std::string& tenorDescription,
+						  const std::string& calendar,
+						  const LTQC::StubType& stubType,
+						  const LTQC::RollConvMethod& rollConvention,
+						  const LTQC::RollRuleMethod& rollRuleConvention,
+						  const LT::Str& payDelay,
+						  const LT::Str& payCalendar,
+						  const LT::Str& payRollConvention);
+
+		struct Compare
+		{
+			bool operator()(const ScheduleArguments& lhs, const ScheduleArguments& rhs) const;
+		};
+
+		LT::date				startDate;
+		LT::date				endDate;
+		std::string				tenorDescription;
+		std::string				calendar;
+		LTQC::StubType			stubType;
+		LTQC::RollConvMethod	rollConvention;
+		LTQC::RollRuleMethod	rollRuleConvention;
+		bool					hasPaymentDates;
+		LT::Str					payDelay;
+		LT::Str					payCalendar;
+		LT::Str					payRollConvention;
+	};
+
+	/// A generated schedule: its accrual periods and, if requested, its
+	/// payment dates, each held in one contiguous block
+	struct LegSchedule
+	{
+		ModuleDate::Schedule::ScheduleEvents	scheduleDates;
+		std::vector<LTQC::Date>					paymentDates;
+	};
+
+	DECLARE_SMART_PTRS( LegSchedule )
+
+	/// ScheduleCache holds the schedules generated for the fixed and
+	/// floating legs, so that the legs of the instruments sharing their
+	/// dates and conventions, and the legs of the next builds, do not
+	/// generate them again.
+	///
+	/// The cached schedules are immutable and shared by all the threads.
+	/// The cache holds the schedules of the builds of the latest value date
+	/// only: it is cleared when a build of a later value date requests a
+	/// schedule, and the schedules of earlier value dates are generated
+	/// without being cached. It is also cleared when it reaches its maximum
+	/// size. It is safe to use from several threads.
+	class ScheduleCache
+	{
+	public:
+		/// Returns the schedule generated from the specified arguments
+		/// for a build of the specified value date, generating it on the
+		/// first request
+		static LegScheduleConstPtr get(const ScheduleArguments& arguments, const LT::date valueDate);
+
+		/// Returns the number of cached schedules
+		static size_t size();
+
+		/// Removes the cached schedules
+		static void clear();
+
+		/// Sets the maximum number of cached schedules, 100000 by default
+		static void setMaxSize(const size_t maxSize);
+
+		/// Switches the caching of the schedules on or off, on by default (see BuildSwitch)
+		static void setEnabled(const bool enabled);
+
+		static bool isEnabled()
+		{
+			return s_enabled.isOn();
+		}
+
+	private:
+		static LegScheduleConstPtr generate(const ScheduleArguments& arguments);
+
+		static BuildSwitch		s_enabled;
+		static size_t	s_maxSize;
+	};  //  ScheduleCache
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_SCHEDULECACHE_H_INCLUDED
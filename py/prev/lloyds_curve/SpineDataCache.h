@@ -10,6 +10,7 @@
 #include <map>
 #include "Library/PublicInc/Date.h"
 #include "LTQuantInitial.h"
+#include "Matrix.h"
 
 namespace FlexYCF
 {
@@ -25,8 +26,10 @@ namespace FlexYCF
 		BaseModelPtr model_;
 		knot_points_container xy_;
 		std::vector<Date> dates_;
+		LT::date valueDate_;
 		std::vector<std::string> instruments_;
 		std::vector<double> df_;
+		LTQC::Matrix jacobian_;
 		std::vector<SpineDataCachePtr> childern_;
 	};
 	DECLARE_SMART_PTRS(SpineDataCache)
@@ -0,0 +1,348 @@
+/*****************************************************************************
+
+	SpineDataSnapshot
+
+	Implementation of the SpineDataSnapshot
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "SpineDataSnapshot.h"
+#include "SpineDataCache.h"
+
+#include <fstream>
+#include <cstring>
+#include <boost/cstdint.hpp>
+
+using namespace std;
+
+namespace FlexYCF
+{
+	namespace
+	{
+		const char				s_magic[8]		= { 'F', 'Y', 'C', 'F', 'S', 'P', 'I', 'N' };
+		const boost::uint32_t	s_byteOrderMark	= 0x01020304;
+
+		template<class T>
+		void write(ofstream& out, const T value)
+		{
+			out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		void writeSize(ofstream& out, const size_t size)
+		{
+			write(out, static_cast<boost::uint32_t>(size));
+		}
+
+		void writeNode(ofstream& out, const SpineDataCache& node)
+		{
+			write(out, static_cast<boost::int32_t>(node.valueDate_.getAsLong()));
+
+			writeSize(out, node.xy_.size());
+			for(knot_points_container::const_iterator curve(node.xy_.begin()); curve != node.xy_.end(); ++curve)
+			{
+				writeSize(out, curve->size());
+				for(vector<pair<double, double> >::const_iterator point(curve->begin()); point != curve->end(); ++point)
+				{
+					write(out, point->first);
+					write(out, point->second);
+				}
+			}
+
+			writeSize(out, node.instruments_.size());
+			for(vector<string>::const_iterator instrument(node.instruments_.begin()); instrument != node.instruments_.end(); ++instrument)
+			{
+				writeSize(out, instrument->size());
+				out.write(instrument->data(), instrument->size());
+			}
+
+			const size_t rows(node.jacobian_.empty() ? 0 : node.jacobian_.getNumRows());
+			const size_t cols(node.jacobian_.empty() ? 0 : node.jacobian_.getNumCols());
+			writeSize(out, rows);
+			writeSize(out, cols);
+			for(size_t i(0); i < rows; ++i)
+			{
+				for(size_t j(0); j < cols; ++j)
+				{
+					write(out, node.jacobian_(i, j));
+				}
+			}
+
+			writeSize(out, node.df_.size());
+			for(vector<double>::const_iterator df(node.df_.begin()); df != node.df_.end(); ++df)
+			{
+				write(out, *df);
+			}
+		}
+
+		//	Reads the values of the snapshot from the mapped memory,
+		//	throwing rather than reading past the end of the file
+		class SnapshotReader
+		{
+		public:
+			SnapshotReader(const char* const begin, const char* const end):
+				m_next(begin),
+				m_end(end)
+			{
+			}
+
+			template<class T>
+			T read()
+			{
+				T value;
+				memcpy(&value, advance(sizeof(T)), sizeof(T));
+				return value;
+			}
+
+			size_t readSize()
+			{
+				return static_cast<size_t>(read<boost::uint32_t>());
+			}
+
+			//	Reads a number of elements, checking they fit in the rest of the file
+			size_t readCount(const size_t elementSize)
+			{
+				const size_t count(readSize());
+				if(count > static_cast<size_t>(m_end - m_next) / elementSize)
+				{
+					LT_THROW_ERROR("The spine data snapshot is truncated");
+				}
+				return count;
+			}
+
+			string readString(const size_t length)
+			{
+				const char* const characters(advance(length));
+				return string(characters, characters + length);
+			}
+
+			void skip(const size_t size)
+			{
+				advance(size);
+			}
+
+			size_t getOffset(const char* const begin) const
+			{
+				return static_cast<size_t>(m_next - begin);
+			}
+
+		private:
+			const char* advance(const size_t size)
+			{
+				if(size > static_cast<size_t>(m_end - m_next))
+				{
+					LT_THROW_ERROR("The spine data snapshot is truncated");
+				}
+				const char* const current(m_next);
+				m_next += size;
+				return current;
+			}
+
+			const char*			m_next;
+			const char* const	m_end;
+		};
+
+		//	Reads the size of the jacobian, checking its values fit in the rest of the file
+		void readJacobianSize(SnapshotReader& reader, size_t& rows, size_t& cols)
+		{
+			rows = reader.readCount(sizeof(double));
+			cols = (rows == 0 ? reader.readSize() : reader.readCount(rows * sizeof(double)));
+		}
+
+		void readNode(SnapshotReader& reader, SpineDataCache& node)
+		{
+			node.valueDate_ = LT::date(static_cast<long>(reader.read<boost::int32_t>()));
+
+			node.xy_.resize(reader.readCount(sizeof(boost::uint32_t)));
+			for(knot_points_container::iterator curve(node.xy_.begin()); curve != node.xy_.end(); ++curve)
+			{
+				curve->resize(reader.readCount(2 * sizeof(double)));
+				for(vector<pair<double, double> >::iterator point(curve->begin()); point != curve->end(); ++point)
+				{
+					point->first	= reader.read<double>();
+					point->second	= reader.read<double>();
+				}
+			}
+
+			node.instruments_.resize(reader.readCount(sizeof(boost::uint32_t)));
+			for(vector<string>::iterator instrument(node.instruments_.begin()); instrument != node.instruments_.end(); ++instrument)
+			{
+				*instrument = reader.readString(reader.readSize());
+			}
+
+			size_t rows, cols;
+			readJacobianSize(reader, rows, cols);
+			node.jacobian_ = (rows * cols == 0 ? LTQC::Matrix() : LTQC::Matrix(rows, cols, 0.0));
+			for(size_t i(0); i < rows; ++i)
+			{
+				for(size_t j(0); j < cols; ++j)
+				{
+					node.jacobian_(i, j) = reader.read<double>();
+				}
+			}
+
+			node.df_.resize(reader.readCount(sizeof(double)));
+			for(vector<double>::iterator df(node.df_.begin()); df != node.df_.end(); ++df)
+			{
+				*df = reader.read<double>();
+			}
+		}
+
+		//	Moves the reader past the spine data of a curve, without reading them
+		void skipNode(SnapshotReader& reader)
+		{
+			reader.skip(sizeof(boost::int32_t));
+
+			const size_t numberOfCurves(reader.readCount(sizeof(boost::uint32_t)));
+			for(size_t k(0); k < numberOfCurves; ++k)
+			{
+				reader.skip(reader.readCount(2 * sizeof(double)) * 2 * sizeof(double));
+			}
+
+			const size_t numberOfInstruments(reader.readCount(sizeof(boost::uint32_t)));
+			for(size_t k(0); k < numberOfInstruments; ++k)
+			{
+				reader.skip(reader.readSize());
+			}
+
+			size_t rows, cols;
+			readJacobianSize(reader, rows, cols);
+			reader.skip(rows * cols * sizeof(double));
+
+			reader.skip(reader.readCount(sizeof(double)) * sizeof(double));
+		}
+
+		//	Returns true if the spine data come from curves with the same value date, instruments and knot points
+		bool haveSameStructure(const SpineDataCache& lhs, const SpineDataCache& rhs)
+		{
+			if(lhs.valueDate_ != rhs.valueDate_ || lhs.instruments_ != rhs.instruments_ || lhs.xy_.size() != rhs.xy_.size())
+			{
+				return false;
+			}
+			for(size_t k(0); k < lhs.xy_.size(); ++k)
+			{
+				if(lhs.xy_[k].size() != rhs.xy_[k].size())
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+
+	string SpineDataSnapshot::getKey(const string& currency, const string& index)
+	{
+		return currency + "|" + index;
+	}
+
+	void SpineDataSnapshot::save(const SpineDataByCurve& spineData, const string& fileName)
+	{
+		ofstream out(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+		if(!out)
+		{
+			LT_THROW_ERROR("Cannot open the spine data snapshot file '" << fileName << "'");
+		}
+
+		out.write(s_magic, sizeof(s_magic));
+		write(out, static_cast<boost::uint32_t>(Version));
+		write(out, s_byteOrderMark);
+		writeSize(out, spineData.size());
+		for(SpineDataByCurve::const_iterator iter(spineData.begin()); iter != spineData.end(); ++iter)
+		{
+			writeSize(out, iter->first.size());
+			out.write(iter->first.data(), iter->first.size());
+			writeNode(out, *iter->second);
+		}
+
+		if(!out)
+		{
+			LT_THROW_ERROR("Cannot write the spine data snapshot file '" << fileName << "'");
+		}
+	}
+
+	SpineDataSnapshot::SpineDataSnapshot(const string& fileName):
+		m_version(0)
+	{
+		try
+		{
+			boost::interprocess::file_mapping(fileName.c_str(), boost::interprocess::read_only).swap(m_file);
+			boost::interprocess::mapped_region(m_file, boost::interprocess::read_only).swap(m_region);
+		}
+		catch(const boost::interprocess::interprocess_exception& exception)
+		{
+			LT_THROW_ERROR("Cannot map the spine data snapshot file '" << fileName << "': " << exception.what());
+		}
+
+		const char* const begin(static_cast<const char*>(m_region.get_address()));
+		SnapshotReader reader(begin, begin + m_region.get_size());
+		if(reader.readString(sizeof(s_magic)) != string(s_magic, s_magic + sizeof(s_magic)))
+		{
+			LT_THROW_ERROR("'" << fileName << "' is not a spine data snapshot file");
+		}
+		m_version = reader.read<boost::uint32_t>();
+		if(m_version != Version)
+		{
+			LT_THROW_ERROR("The spine data snapshot version " << m_version << " is not supported");
+		}
+		if(reader.read<boost::uint32_t>() != s_byteOrderMark)
+		{
+			LT_THROW_ERROR("The spine data snapshot was written with a different byte order");
+		}
+
+		//	Index the curves, checking the file is complete
+		const size_t numberOfCurves(reader.readCount(sizeof(boost::uint32_t)));
+		for(size_t k(0); k < numberOfCurves; ++k)
+		{
+			const string key(reader.readString(reader.readSize()));
+			m_offsets[key] = reader.getOffset(begin);
+			skipNode(reader);
+		}
+	}
+
+	bool SpineDataSnapshot::contains(const string& key) const
+	{
+		return m_offsets.find(key) != m_offsets.end();
+	}
+
+	vector<string> SpineDataSnapshot::getKeys() const
+	{
+		vector<string> keys;
+		for(map<string, size_t>::const_iterator offset(m_offsets.begin()); offset != m_offsets.end(); ++offset)
+		{
+			keys.push_back(offset->first);
+		}
+		return keys;
+	}
+
+	bool SpineDataSnapshot::read(const string& key, SpineDataCache& spineData) const
+	{
+		const map<string, size_t>::const_iterator offset(m_offsets.find(key));
+		if(offset == m_offsets.end())
+		{
+			return false;
+		}
+
+		const char* const begin(static_cast<const char*>(m_region.get_address()));
+		SnapshotReader reader(begin + offset->second, begin + m_region.get_size());
+		readNode(reader, spineData);
+		return true;
+	}
+
+	bool SpineDataSnapshot::restore(const string& key, SpineDataCache& spineData) const
+	{
+		SpineDataCache snapshot;
+		if(!read(key, snapshot) || !haveSameStructure(snapshot, spineData))
+		{
+			return false;
+		}
+
+		spineData.xy_.swap(snapshot.xy_);
+		spineData.jacobian_ = snapshot.jacobian_;
+		spineData.df_.swap(snapshot.df_);
+		return true;
+	}
+}
@@ -0,0 +1,96 @@
+/*****************************************************************************
+
+    SpineDataSnapshot
+
+	Versioned binary file format for the spine data of a solved curve set.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_SPINEDATASNAPSHOT_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_SPINEDATASNAPSHOT_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+
+namespace FlexYCF
+{
+	FWD_DECLARE_SMART_PTRS( SpineDataCache )
+
+	/// Spine data of solved curves, by curve key (see SpineDataSnapshot::getKey)
+	typedef std::map<std::string, SpineDataCachePtr> SpineDataByCurve;
+
+	/// SpineDataSnapshot persists the spine data of a set of solved curves:
+	/// for each curve, the knot points of the spine curves of its model, the
+	/// descriptions of its full instruments and the jacobian of its model.
+	/// The file is memory-mapped to be read, so that a process can restore
+	/// the solved curves without calibrating them again
+	/// (see FlexYCFZeroCurve::setSpineDataSnapshot).
+	///
+	/// Format (native byte order, checked on reading):
+	///		header:		"FYCFSPIN", version, byte order mark		8 + 4 + 4 bytes
+	///					number of curves							4 bytes
+	///		per curve:	key length, characters						4 + n bytes
+	///					value date									4 bytes
+	///					number of spine curves						4 bytes
+	///					per spine curve: points, (x, y) pairs		4 + 16n bytes
+	///					number of instruments						4 bytes
+	///					per instrument: length, characters			4 + n bytes
+	///					jacobian rows and columns, row-major values	4 + 4 + 8rc bytes
+	///					number of discount factors, values			4 + 8n bytes
+	class SpineDataSnapshot: private DevCore::NonCopyable
+	{
+	public:
+		/// Version of the format written by save
+		static const unsigned int Version = 1;
+
+		/// Returns the key of the curve of the specified currency and index
+		static std::string getKey(const std::string& currency, const std::string& index);
+
+		/// Writes the spine data of the curves to the specified file
+		/// Note: the dependent curves of the spine data are not written
+		static void save(const SpineDataByCurve& spineData, const std::string& fileName);
+
+		/// Maps the specified file in memory, checks its header and
+		/// indexes the curves it contains
+		explicit SpineDataSnapshot(const std::string& fileName);
+
+		/// Returns true if the snapshot contains the specified curve
+		bool contains(const std::string& key) const;
+
+		/// Returns the keys of the curves of the snapshot
+		std::vector<std::string> getKeys() const;
+
+		/// Reads the spine data of the specified curve, whatever its structure.
+		/// Returns false if the snapshot does not contain the curve
+		bool read(const std::string& key, SpineDataCache& spineData) const;
+
+		/// Copies the spine data of the specified curve into the spine data
+		/// filled by the model of the curve to restore. Returns false, leaving
+		/// the spine data unchanged, if the snapshot does not contain the curve
+		/// or if the curve has a different value date, instruments or knot points.
+		bool restore(const std::string& key, SpineDataCache& spineData) const;
+
+		unsigned int getVersion() const
+		{
+			return m_version;
+		}
+
+	private:
+		boost::interprocess::file_mapping	m_file;
+		boost::interprocess::mapped_region	m_region;
+		unsigned int						m_version;
+		std::map<std::string, size_t>		m_offsets;	// of the spine data of each curve in the file
+	};  //  SpineDataSnapshot
+
+	DECLARE_SMART_PTRS( SpineDataSnapshot )
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_SPINEDATASNAPSHOT_H_INCLUDED
@@ -39,6 +39,17 @@ namespace FlexYCF
         return exp(-flowTime * m_baseCurve->evaluate(flowTime));
     }
 
+    void SpotRateCurve::getDiscountFactors(vector<double>::const_iterator flowTimesBegin,
+                                           vector<double>::const_iterator flowTimesEnd,
+                                           vector<double>::iterator discountFactorsBegin) const
+    {
+        m_baseCurve->evaluateSorted(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+        for(; flowTimesBegin != flowTimesEnd; ++flowTimesBegin, ++discountFactorsBegin)
+        {
+            *discountFactorsBegin = exp(-*flowTimesBegin * *discountFactorsBegin);
+        }
+    }
+
     /// If K is an unknown variable of r(t), as P(t) = exp(-t * r(t)), we have:
     ///     dP(t) / dK = dP(t)/dr(t) * dr(t)/dK = -t * P(t) * dr(t)/dK
     /// so that: 
@@ -42,6 +42,9 @@ namespace FlexYCF
                                                   const LeastSquaresResidualsPtr& leastSquaresResiduals);
 
         virtual double getDiscountFactor(const double flowTime) const;
+        virtual void getDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                        std::vector<double>::const_iterator flowTimesEnd,
+                                        std::vector<double>::iterator discountFactorsBegin) const;
         virtual void accumulateDiscountFactorGradient(const double x, 
 													  double multiplier,
 													  GradientIterator gradientBegin,
@@ -39,6 +39,38 @@ namespace FlexYCF
 //        return 0.0;
     }
 
+    // The upper bound of each point is searched from the upper bound of the
+    //  previous point onwards, so the whole range costs one pass over the
+    //  knot-points and the inner loop is free of the binary search branches
+    void StraightLineInterpolation::evaluateSorted(vector<double>::const_iterator xBegin,
+                                                   vector<double>::const_iterator xEnd,
+                                                   vector<double>::iterator yBegin) const
+    {
+        const_iterator upper(begin());
+        for(; xBegin != xEnd; ++xBegin, ++yBegin)
+        {
+            const double x(*xBegin);
+            while(upper != end() && !(x < upper->x))
+            {
+                ++upper;
+            }
+
+            if(upper == begin())
+            {
+                *yBegin = begin()->y;
+            }
+            else if(upper == end())
+            {
+                *yBegin = (end() - 1)->y;
+            }
+            else
+            {
+                const const_iterator lower(upper - 1);
+                *yBegin = lower->y + (upper->y - lower->y) * (x - lower->x) / (upper->x - lower->x);
+            }
+        }
+    }
+
     void StraightLineInterpolation::accumulateGradient(const double x, double multiplier, GradientIterator gradientBegin, GradientIterator gradientEnd) const
     {
         GradientIterator gradientIterator(gradientBegin);
@@ -32,6 +32,12 @@ namespace FlexYCF
 
         virtual double evaluate(const double x) const;
 
+        /// Evaluates the curve at sorted points, merge-scanning them
+        /// against the knot-points instead of searching each one
+        virtual void evaluateSorted(std::vector<double>::const_iterator xBegin,
+                                    std::vector<double>::const_iterator xEnd,
+                                    std::vector<double>::iterator yBegin) const;
+
         /// Computes the gradient relative to the unknowns
         /// and adds multiplier times the gradient to the points between the iterators supplied
         virtual void accumulateGradient(const double x, double multiplier, GradientIterator gradientBegin, GradientIterator gradientEnd) const; 
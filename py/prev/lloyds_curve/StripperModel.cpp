@@ -133,6 +133,37 @@ namespace FlexYCF
         return structure_ * m_curveFormulation->getDiscountFactor(flowTime);
     }
 
+    void StripperModel::getSortedDiscountFactors(vector<double>::const_iterator flowTimesBegin,
+                                                 vector<double>::const_iterator flowTimesEnd,
+                                                 vector<double>::iterator discountFactorsBegin) const
+    {
+        m_curveFormulation->getDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+        for(; flowTimesBegin != flowTimesEnd; ++flowTimesBegin, ++discountFactorsBegin)
+        {
+            *discountFactorsBegin *= StructureSurfaceHolder::holdee().getDiscountFactor(*flowTimesBegin);
+        }
+    }
+
+    void StripperModel::getSortedTenorDiscountFactors(vector<double>::const_iterator flowTimesBegin,
+                                                      vector<double>::const_iterator flowTimesEnd,
+                                                      const double /* tenor */,
+                                                      vector<double>::iterator discountFactorsBegin) const
+    {
+        StripperModel::getSortedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactorsBegin);
+    }
+
+    void StripperModel::multiplyByStrippedDiscountFactors(vector<double>::const_iterator flowTimesBegin,
+                                                          vector<double>::const_iterator flowTimesEnd,
+                                                          vector<double>::iterator valuesBegin) const
+    {
+        vector<double> discountFactors(distance(flowTimesBegin, flowTimesEnd));
+        StripperModel::getSortedDiscountFactors(flowTimesBegin, flowTimesEnd, discountFactors.begin());
+        for(vector<double>::const_iterator iter(discountFactors.begin()); iter != discountFactors.end(); ++iter, ++valuesBegin)
+        {
+            *valuesBegin *= *iter;
+        }
+    }
+
     void StripperModel::accumulateDiscountFactorGradient(const double flowTime, 
                                                          double multiplier,
                                                          GradientIterator gradientBegin,
@@ -51,6 +51,14 @@ namespace FlexYCF
         virtual double getDiscountFactor(const double flowTime) const;
         virtual double getTenorDiscountFactor(const double flowTime, const double tenor) const;
 
+        virtual void getSortedDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                              std::vector<double>::const_iterator flowTimesEnd,
+                                              std::vector<double>::iterator discountFactorsBegin) const;
+        virtual void getSortedTenorDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                                   std::vector<double>::const_iterator flowTimesEnd,
+                                                   const double tenor,
+                                                   std::vector<double>::iterator discountFactorsBegin) const;
+
         virtual void accumulateDiscountFactorGradient(const double flowTime,
                                                       double multiplier, 
                                                       GradientIterator gradientBegin, 
@@ -94,6 +102,12 @@ namespace FlexYCF
     protected:
         StripperModel(StripperModel const& original, CloneLookup& lookup);
 
+        /// Multiplies the values from valuesBegin by the discount factors of
+        /// the stripped curve at the sorted flow times, as spread models do
+        void multiplyByStrippedDiscountFactors(std::vector<double>::const_iterator flowTimesBegin,
+                                               std::vector<double>::const_iterator flowTimesEnd,
+                                               std::vector<double>::iterator valuesBegin) const;
+
     private:
         // once the knot points are placed this function is called
         // to set the number of extra residuals
@@ -1028,6 +1028,13 @@ namespace FlexYCF
 		//	No index rep flows for a fixed leg
 	}
 
+	void TenorBasisSwap::fillPortfolioCashFlows(PortfolioCashFlows& cashFlows, const double multiplier) const
+	{
+		m_longFloatingLeg->fillPortfolioCashFlows(cashFlows, multiplier);
+		m_shortFloatingLeg->fillPortfolioCashFlows(cashFlows, -multiplier);
+		m_spreadFixedLeg->fillPortfolioCashFlows(cashFlows, -multiplier * getRate());
+	}
+
 	double TenorBasisSwap::getDifferenceWithNewRate(const LTQuant::GenericData& instrumentListData) const
 	{    
         const IDeA::DictionaryKey& instrumentKey = getKey<TenorBasisSwap>();
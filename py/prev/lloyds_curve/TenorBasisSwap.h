@@ -281,6 +281,8 @@ namespace FlexYCF
                                   const BaseModel& model,
 							      const double multiplier, 
 							      IDeA::RepFlowsData<IDeA::Index>& indexRepFlows);
+		/// Adds the cash flows of the swap, multiplied by the multiplier, to the cash flows of a book
+		void fillPortfolioCashFlows(PortfolioCashFlows& cashFlows, const double multiplier) const;
 		virtual double getDifferenceWithNewRate(const LTQuant::GenericData& instrumentListData) const;
 		virtual std::ostream& print(std::ostream& out) const;         // Useful for testing
 
@@ -14,6 +14,8 @@
 #include "LTQuantInitial.h"
 #include "Currency.h"
 
+#include <boost/functional/hash.hpp>
+
 namespace QDDate
 
 {
@@ -81,6 +83,18 @@ namespace FlexYCF
 
         };
 
+        /// Hash functor consistent with Compare, used by CacheStorageHash
+        struct Hash
+        {
+            size_t operator()(const TenorDiscountFactorArguments& tenorDiscountFactorArgs) const
+            {
+                size_t seed(0);
+                boost::hash_combine(seed, tenorDiscountFactorArgs.m_flowTime);
+                boost::hash_combine(seed, tenorDiscountFactorArgs.m_tenor);
+                return seed;
+            }
+        };
+
         bool operator==(const TenorDiscountFactorArguments& other) const
         {
             return m_flowTime == other.m_flowTime && 
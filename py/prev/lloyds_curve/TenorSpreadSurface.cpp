@@ -53,7 +53,8 @@ namespace FlexYCF
 
     // TO DO: pass the correct table and least squares residuals
     TenorSpreadSurface::TenorSpreadSurface(const CurveTypeConstPtr& baseRate):
-        m_baseRate(baseRate)
+        m_baseRate(baseRate),
+        m_curveCachesEnabled(false)
     { 
         // If the base rate is a tenor, create a zero spread curve over the base rate set
         //  with only the (0.0, 0.0) point and flat-right interpolation
@@ -66,7 +67,8 @@ namespace FlexYCF
 
 	TenorSpreadSurface::TenorSpreadSurface(const CurveTypeConstPtr& baseRate,
 										   const LTQuant::GenericData& masterTable):
-		m_baseRate(baseRate)
+		m_baseRate(baseRate),
+		m_curveCachesEnabled(false)
 	{
 		if(m_baseRate->isTenor())
 		{
@@ -89,6 +91,12 @@ namespace FlexYCF
 		}
 
 		m_tssInterpolation = TssInterpolationFactory::createTssInterpolation(tssInterpName, m_baseRate, m_spreadCurves, tssInterpParamsTable);
+
+		//	The cached spread curves are known once the spread curves are created, on finalize
+		if(modelParamsTable)
+		{
+			IDeA::permissive_extract<LTQuant::GenericDataPtr>(*modelParamsTable, IDeA_KEY(FLEXYC_MODELPARAMETERS, CACHEPARAMETERS), m_cacheParametersTable);
+		}
 	}
 
     /**
@@ -104,8 +112,16 @@ namespace FlexYCF
         m_totalNumberOfUnknownKnotPoints(original.m_totalNumberOfUnknownKnotPoints),
         m_flowTimes(original.m_flowTimes),
         m_smallTenorCurveGradient(original.m_smallTenorCurveGradient),
-        m_cachedCurveTypes(original.m_cachedCurveTypes)
+        m_cachedCurveTypes(original.m_cachedCurveTypes),
+        m_cacheParametersTable(original.m_cacheParametersTable),
+        m_curveCachesEnabled(false)
     {
+        // The clone starts with empty, disabled caches
+        for(vector<SpreadCurveCache>::const_iterator iter(original.m_spreadCurveCaches.begin()); iter != original.m_spreadCurveCaches.end(); ++iter)
+        {
+            m_spreadCurveCaches.push_back(SpreadCurveCache(iter->tenor));
+        }
+
         // Copy across the spread curves cloning as we go
         for (TypedCurves::const_iterator it = original.m_spreadCurves.begin(); it != original.m_spreadCurves.end(); ++it)
         {
@@ -120,65 +136,44 @@ namespace FlexYCF
             m_tssInterpolation = original.m_tssInterpolation->clone(m_baseRate, m_spreadCurves, original.m_tssInterpolation->TSSInterpParameters(), lookup);
     }
 
-    // TO REVIEW
-	/*
-    TenorSpreadSurface::TenorSpreadSurface(const CurveTypeConstPtr baseRate,
-                                           const LTQuant::GenericDataPtr masterTable):
-        m_baseRate(baseRate)
+    TenorSpreadSurface::SpreadCurveCache::SpreadCurveCache(const double tenor_):
+        tenor(tenor_),
+        gradientSize(0)
     {
-        initCurveCacheInfo(masterTable);
-
-        // If the base rate is a tenor, create a zero spread curve over the base rate set
-        //  with only the (0.0, 0.0) point and flat-right interpolation
-        if(m_baseRate->isTenor())
-        {   
-            // TypedCurve zeroSpreadCurve(baseRate, true);
-            TypedCurvePtr zeroSpreadCurve(new TypedCurve(baseRate, true));
-
-            zeroSpreadCurve = std::tr1::dynamic_pointer_cast<TypedCurve>(
-                ICurveFactory::createInstance(LTQuant::GenericDataPtr(), LeastSquaresResidualsPtr()));
-        }
     }
 
-    void TenorSpreadSurface::initCurveCacheInfo(const LTQuant::GenericDataPtr masterTable)
+    // Caches the spread curves whose "<tenor> Curve" flag is set in the cache parameters,
+    //  once all the spread curves are created
+    void TenorSpreadSurface::initCurveCacheInfo(const LTQuant::GenericDataPtr& cacheParametersTable)
     {
-        const bool cacheTableExists(masterTable->doesTagExist("Cache Parameters") != NULL);
-        GenericDataPtr cacheParametersTable;
-        
-        if(cacheTableExists)
+        m_cachedCurveTypes.clear();
+        m_spreadCurveCaches.clear();
+
+        if(!cacheParametersTable)
         {
-            cacheParametersTable = masterTable->get<LTQuant::GenericDataPtr>("Cache Parameters", 0);
+            return;
         }
 
-        vector<CurveTypeConstPtr> cachableTenorSpreadCurves; // we don't want to be able to cache ANY typed curve
-        
-        cachableTenorSpreadCurves.push_back(CurveType::ON());
-        cachableTenorSpreadCurves.push_back(CurveType::_1M());
-        cachableTenorSpreadCurves.push_back(CurveType::_3M());
-        cachableTenorSpreadCurves.push_back(CurveType::_6M());
-        cachableTenorSpreadCurves.push_back(CurveType::_1Y());
-
 		std::string tenorSpreadCurveCacheTag;
+        long cacheCurve(0);
 
-        // for each cachable curve type...
-        for(vector<CurveTypeConstPtr>::const_iterator iter(cachableTenorSpreadCurves.begin());
-            iter != cachableTenorSpreadCurves.end(); ++iter)
+        for(TypedCurves::const_iterator iter(m_spreadCurves.begin()); iter != m_spreadCurves.end(); ++iter)
         {
-            tenorSpreadCurveCacheTag =  (*iter)->getDescription() + " Curve";
+            tenorSpreadCurveCacheTag = iter->first->getDescription() + " Curve";
+            cacheCurve = 0;
+            cacheParametersTable->permissive_get<long>(tenorSpreadCurveCacheTag, 0, cacheCurve, 0);
 
-            // ... remember to cache the corresponding typed curve calculation (if added later) when:
-            if(m_baseRate != *iter                                              // it makes sense
-                && cacheTableExists                                             // to avoid crashing
-                && cacheParametersTable->doesTagExist(tenorSpreadCurveCacheTag) // it's specified by the user
-                && cacheParametersTable->get<long>(tenorSpreadCurveCacheTag , 0) != 0)
+            // the spread curve over the base rate is flat at zero: no need to cache it
+            if(iter->first != m_baseRate && cacheCurve != 0)
             {
-                m_cachedCurveTypes.push_back(*iter);
+                m_cachedCurveTypes.push_back(iter->first);
+                m_spreadCurveCaches.push_back(SpreadCurveCache(iter->first->getYearFraction()));
             }
         }
 
         sort(m_cachedCurveTypes.begin(), m_cachedCurveTypes.end());
     }
-	*/
+
     bool TenorSpreadSurface::useCurveCache(const CurveTypeConstPtr tenor) const
     {
         CurveTypeContainer::const_iterator lower(lower_bound(m_cachedCurveTypes.begin(),
@@ -188,6 +183,37 @@ namespace FlexYCF
         return(lower != m_cachedCurveTypes.end() && (*lower == tenor));
     }
 
+    TenorSpreadSurface::SpreadCurveCache* TenorSpreadSurface::getSpreadCurveCache(const double tenor) const
+    {
+        if(!m_curveCachesEnabled)
+        {
+            return 0;
+        }
+        for(vector<SpreadCurveCache>::iterator iter(m_spreadCurveCaches.begin()); iter != m_spreadCurveCaches.end(); ++iter)
+        {
+            if(iter->tenor == tenor)
+            {
+                return &(*iter);
+            }
+        }
+        return 0;
+    }
+
+    void TenorSpreadSurface::enableCurveCaches(const bool enabled)
+    {
+        m_curveCachesEnabled = enabled;
+        clearSpreadCurveCaches();
+    }
+
+    void TenorSpreadSurface::clearSpreadCurveCaches()
+    {
+        for(vector<SpreadCurveCache>::iterator iter(m_spreadCurveCaches.begin()); iter != m_spreadCurveCaches.end(); ++iter)
+        {
+            iter->values.clear();
+            iter->gradients.clear();
+        }
+    }
+
     TenorSpreadSurface::const_iterator TenorSpreadSurface::begin() const
     {
         return m_spreadCurves.begin();
@@ -211,12 +237,25 @@ namespace FlexYCF
     // Interpolate along an existing tenor
     double TenorSpreadSurface::interpolateCurve(const double tenor, const double flowTime) const
     {
-		return m_tssInterpolation->interpolate(tenor, flowTime);
+		return interpolate(tenor, flowTime);
     }
 
     double TenorSpreadSurface::interpolate(const double tenor, const double flowTime) const
     {
-		return m_tssInterpolation->interpolate(tenor, flowTime);
+		SpreadCurveCache* const cache(getSpreadCurveCache(tenor));
+		if(!cache)
+		{
+			return m_tssInterpolation->interpolate(tenor, flowTime);
+		}
+
+		const boost::unordered_map<double, double>::const_iterator value(cache->values.find(flowTime));
+		if(value != cache->values.end())
+		{
+			return value->second;
+		}
+		const double result(m_tssInterpolation->interpolate(tenor, flowTime));
+		cache->values.insert(make_pair(flowTime, result));
+		return result;
 		/* Straight Line Interpolation:
         if(m_spreadCurves.size() < 2)
         {
@@ -256,7 +295,7 @@ namespace FlexYCF
                                                      GradientIterator gradientEnd,
 													 const CurveTypeConstPtr& curveType) const
     {
-		m_tssInterpolation->accumulateGradient(tenor->getYearFraction(), flowTime, multiplier, gradientBegin, gradientEnd, curveType);
+		accumulateCurveGradient(tenor->getYearFraction(), flowTime, multiplier, gradientBegin, gradientEnd, curveType);
     }
     
     void TenorSpreadSurface::accumulateCurveGradient(const double tenor,  
@@ -266,7 +305,33 @@ namespace FlexYCF
                                                      GradientIterator gradientEnd,
 													 const CurveTypeConstPtr& curveType) const
     {
-		m_tssInterpolation->accumulateGradient(tenor, flowTime, multiplier, gradientBegin, gradientEnd, curveType);
+		SpreadCurveCache* const cache(curveType == CurveType::AllTenors() ? getSpreadCurveCache(tenor) : 0);
+		if(!cache)
+		{
+			m_tssInterpolation->accumulateGradient(tenor, flowTime, multiplier, gradientBegin, gradientEnd, curveType);
+			return;
+		}
+
+		const size_t gradientSize(gradientEnd - gradientBegin);
+		if(cache->gradientSize != gradientSize)
+		{
+			cache->gradients.clear();
+			cache->gradientSize = gradientSize;
+		}
+
+		//	The gradient is cached for a unit multiplier, keeping its non-zero partial derivatives only
+		boost::unordered_map<double, SparseGradient>::const_iterator gradient(cache->gradients.find(flowTime));
+		if(gradient == cache->gradients.end())
+		{
+			Gradient unitGradient(gradientSize, 0.0);
+			m_tssInterpolation->accumulateGradient(tenor, flowTime, 1.0, unitGradient.begin(), unitGradient.end(), curveType);
+
+			SparseGradient sparseGradient;
+			sparseGradient.assign(unitGradient.begin(), unitGradient.end());
+			gradient = cache->gradients.insert(make_pair(flowTime, sparseGradient)).first;
+		}
+
+		gradient->second.accumulateTo(multiplier, gradientBegin);
     }
     
     void TenorSpreadSurface::accumulateGradient(const double tenor, 
@@ -386,6 +451,7 @@ namespace FlexYCF
 
     void TenorSpreadSurface::update()
     {
+        clearSpreadCurveCaches();
         m_totalNumberOfUnknownKnotPoints = 0;
         
         for(TypedCurves::iterator iter(m_spreadCurves.begin()); iter != m_spreadCurves.end(); ++iter)
@@ -408,6 +474,8 @@ namespace FlexYCF
 
 		m_tssInterpolation->finalize();
 		//	buildBucketedCurves();
+
+		initCurveCacheInfo(m_cacheParametersTable);
     }
 
     void TenorSpreadSurface::addUnknownsToProblem(const LTQuant::ProblemPtr& problem)
@@ -451,6 +519,8 @@ namespace FlexYCF
 													  const LTQC::VectorDouble::const_iterator shiftsEnd)
 	{
 		// TO DO: check that shiftsEnd - shiftsBegin == # of variables on the surface
+		clearSpreadCurveCaches();
+
 		size_t nbVariablesSoFar, tmp(0);
 		for(TypedCurves::iterator iter(m_spreadCurves.begin()); iter != m_spreadCurves.end(); ++iter)
 		{
@@ -467,6 +537,8 @@ namespace FlexYCF
 	void TenorSpreadSurface::initializeKnotPoints(const CurveTypeConstPtr& tenor,
 			 									  const double initialSpotRate)
 	{
+		clearSpreadCurveCaches();
+
 		if(tenor == CurveType::AllTenors())
 		{
 			// initialize all the curves with the same spot rate
@@ -512,6 +584,7 @@ namespace FlexYCF
 	}
 
 	void TenorSpreadSurface::assignCurveInternalData(knot_points_container::const_iterator it) {
+		clearSpreadCurveCaches();
 		for (auto p = begin(); p != end(); ++p)
 			p->second->assignCurveInternalData(it++);
 	}
@@ -23,6 +23,13 @@
 #include "VectorDouble.h"
 #include "Macros.h"
 
+#include <boost/functional/hash.hpp>
+#if ( _MSC_VER >= 1500 )					// we will be on Boost_1_38 with VS 2008
+	#include "Boost\unordered_map.hpp"
+#else
+	#include "Boost_1_38_Hack\unordered_map.hpp"
+#endif
+
 namespace LTQuant
 {
     FWD_DECLARE_SMART_PTRS( Problem )
@@ -54,6 +61,12 @@ namespace FlexYCF
     /// this spread curve.
     /// 
     /// Remark: TenorSpreadSurface interface has a lot in common with the TypedCurve's one
+    ///
+    /// The values and gradients of the spread curves listed in the "Cache Parameters"
+    /// table of the model parameters (e.g. "3M Curve" set to 1) are cached by flow time
+    /// between two updates of the surface, i.e. during each solver iteration.
+    /// The caches are only enabled while the model is calibrated, on a single
+    /// thread: once calibrated, the surface is read without caching.
     class TenorSpreadSurface
     {
 	public:
@@ -122,6 +135,10 @@ namespace FlexYCF
         void update();
         void finalize();
 
+        /// Enables or disables the caches of the cached spread curves,
+        /// disabled by default. The caches are emptied either way
+        void enableCurveCaches(const bool enabled);
+
         /// Adds the unknowns of the tenor spread surface to the problem
         void addUnknownsToProblem(const LTQuant::ProblemPtr& problem);
 
@@ -170,8 +187,24 @@ namespace FlexYCF
                                 const std::string& checkedFunctionName,
                                 const std::string& errorMsg) const;
 
-        // void initCurveCacheInfo(const LTQuant::GenericDataPtr /*cacheParametersTable*/ data);
+        void initCurveCacheInfo(const LTQuant::GenericDataPtr& cacheParametersTable);
         bool useCurveCache(const CurveTypeConstPtr tenor) const;
+
+        // Nested struct holding the values and unit gradients of a cached spread curve, by flow time
+        struct SpreadCurveCache
+        {
+            explicit SpreadCurveCache(const double tenor_);
+
+            double                                              tenor;
+            boost::unordered_map<double, double>                values;
+            boost::unordered_map<double, SparseGradient>        gradients;
+            size_t                                              gradientSize;   // of the gradients cached
+        };
+
+        // Returns the cache of the spread curve of the specified tenor, 0 if it is not cached
+        // or if the caches are disabled
+        SpreadCurveCache* getSpreadCurveCache(const double tenor) const;
+        void clearSpreadCurveCaches();
         TenorSpreadSurface(TenorSpreadSurface const&); // deliberately disabled as won't clone properly
 
         // Nested comparator struct to ease interpolation between tenor curves
@@ -195,6 +228,9 @@ namespace FlexYCF
         std::vector<double>		m_smallTenorCurveGradient;
 
         CurveTypeContainer		m_cachedCurveTypes;
+        LTQuant::GenericDataPtr m_cacheParametersTable;
+        bool                    m_curveCachesEnabled;
+        mutable std::vector<SpreadCurveCache> m_spreadCurveCaches;     // cleared on each update
     };  //  SpreadSurface
 
     DECLARE_SMART_PTRS( TenorSpreadSurface )
@@ -18,16 +18,127 @@
 #include "BSplineDefiningFunctionsFactory.h"
 #include "Data\GenericData.h"
 #include "KnotPoints.h"
+#include "FlexYCFCloneLookup.h"
 #include "Math\QRdecomposition.h"
 #include "Math\Matrix.h"
 #include "Math\VectorDouble.h"
-#include "FlexYCFCloneLookup.h"
 
 using namespace std;
 using namespace LTQC;
 
 namespace FlexYCF
 {
+	BuildSwitch TensionSpline::s_checkEnabled = BUILD_SWITCH_INIT(false);
+
+	namespace
+	{
+		//	A row i of a matrix that is non-zero on its sub-diagonal, its diagonal
+		//	and its first three super-diagonals only:
+		//	sub = A(i, i-1) and upper[k] = A(i, i+k), 0 <= k <= 3
+		struct BandedRow
+		{
+			double sub;
+			double upper[4];
+		};
+
+		//	Solves A x = b in O(n) by LU decomposition with partial pivoting,
+		//	where A has a single sub-diagonal and up to two super-diagonals.
+		//	Pivoting swaps adjacent rows only and fills the third super-diagonal.
+		//	Note: the rows and the right-hand side are overwritten
+		void solveBandedSystem(vector<BandedRow>& rows, vector<double>& rhs, vector<double>& solution)
+		{
+			const size_t size(rows.size());
+
+			for(size_t j(0); j + 1 < size; ++j)
+			{
+				BandedRow& pivotRow(rows[j]);
+				BandedRow& nextRow(rows[j+1]);
+
+				if(fabs(nextRow.sub) > fabs(pivotRow.upper[0]))
+				{
+					const BandedRow previousPivotRow(pivotRow);
+					pivotRow.upper[0] = nextRow.sub;
+					pivotRow.upper[1] = nextRow.upper[0];
+					pivotRow.upper[2] = nextRow.upper[1];
+					pivotRow.upper[3] = nextRow.upper[2];
+					nextRow.sub		  = previousPivotRow.upper[0];
+					nextRow.upper[0]  = previousPivotRow.upper[1];
+					nextRow.upper[1]  = previousPivotRow.upper[2];
+					nextRow.upper[2]  = previousPivotRow.upper[3];
+					nextRow.upper[3]  = 0.0;
+					swap(rhs[j], rhs[j+1]);
+				}
+
+				if(pivotRow.upper[0] == 0.0)
+				{
+					LT_THROW_ERROR("Singular system while initializing the coefficients of TensionSpline");
+				}
+
+				const double factor(nextRow.sub / pivotRow.upper[0]);
+				for(size_t k(0); k < 3; ++k)
+				{
+					nextRow.upper[k] -= factor * pivotRow.upper[k+1];
+				}
+				nextRow.sub = 0.0;
+				rhs[j+1] -= factor * rhs[j];
+			}
+
+			if(size > 0 && rows[size-1].upper[0] == 0.0)
+			{
+				LT_THROW_ERROR("Singular system while initializing the coefficients of TensionSpline");
+			}
+
+			//	Back-substitution on the upper triangular matrix
+			solution.resize(size);
+			for(size_t i(size); i-- > 0; )
+			{
+				double value(rhs[i]);
+				for(size_t k(1); k < 4 && i + k < size; ++k)
+				{
+					value -= rows[i].upper[k] * solution[i+k];
+				}
+				solution[i] = value / rows[i].upper[0];
+			}
+		}
+
+		//	The largest number of coefficients checked against the dense solve
+		const size_t s_maxCheckedSize(64);
+
+		//	Returns the largest difference between the solution and the QR solve
+		//	of the system, A being rebuilt dense from its rows
+		double getMaxDifferenceWithQR(const vector<BandedRow>& rows, const vector<double>& rhs, const vector<double>& solution)
+		{
+			const size_t size(rows.size());
+			LTQC::Matrix A(size, size, 0.);
+			LTQC::VectorDouble b(size), x(size);
+			for(size_t row(0); row < size; ++row)
+			{
+				if(row > 0)
+				{
+					A(row, row - 1) = rows[row].sub;
+				}
+				for(size_t k(0); k < 3 && row + k < size; ++k)
+				{
+					A(row, row + k) = rows[row].upper[k];
+				}
+				b[row] = rhs[row];
+			}
+			qr_solve(A, b, x);
+
+			double difference(0.0);
+			for(size_t k(0); k < size; ++k)
+			{
+				difference = max(difference, fabs(x[k] - solution[k]));
+			}
+			return difference;
+		}
+	}
+
+	void TensionSpline::setCheckEnabled(const bool enabled)
+	{
+		s_checkEnabled.set(enabled);
+	}
+
     string TensionSpline::getName()
     {
         return "TensionSpline";
@@ -349,47 +460,37 @@ namespace FlexYCF
 		//	A is a n x n matrix, with 0 everywhere but on a four element-wide diagonal
 		//	coefs is a n-dim vector that contains the coefficients of the tension spline to initialize
 		//	mod_y is a n-dim vector that contains the y-values of the knot-points, modified for knots 1, n-1 and n
+		// Only the band of A is stored, so that the system is solved in linear time
 		LT_LOG << " - Initialization of " << m_coefficients.size() << " Tension Spline coefficients -!" << endl;
 
 		// 1. Resize A, coefs and mod_y:
 		const size_t size(m_coefficients.size());
-		LTQC::Matrix A(size, size, 0.);
-		LTQC::VectorDouble coefs(size), mod_y(size);
+		vector<BandedRow> A(size);
+		vector<double> coefs(size), mod_y(size);
 		
 		LT_LOG << "A: " << std::endl;
 		
 		// 2. Fill A and mod_y
 		// A should be mostly 0, except on a 4-elements wide diagonal where it has "getCoefWeight" values
 		// except for boundaries because 'coef(0)' and 'coef(M+1)' are set by the boundary conditions
-		size_t colMax;
 		double x;
 		int index;
 		for(size_t row(0); row < size; ++row)
 		{
-			colMax = min(size, row + 3);	// so that row - 1 <= col <= row + 2 in the loop below
 			index = static_cast<int>(row+1);
 			x = getKnotFromIndex(index);
 			
-			for(size_t col(max(0, static_cast<int>(row) - 1)); col < colMax; ++col)
-			{	
-				if(col == row - 1)
-					A(row,col) = getCoefWeight_1(index, x);
-				else if (col == row)
-					A(row,col) = getCoefWeight(index, x);
-				else if(col == row + 1)
-					A(row,col) = getCoefWeight_p1(index, x);
-				else if(col == row + 2)
-					A(row,col) = getCoefWeight_p2(index, x);
-				else
-					throw std::exception("invalid subscript while initializing the coefficients of TensionSpline");
-			
-				LT_LOG << A(row,col) << "\t";
-			}
+			BandedRow& bandedRow(A[row]);
+			bandedRow.sub		= (row > 0 ? getCoefWeight_1(index, x) : 0.0);
+			bandedRow.upper[0]	= getCoefWeight(index, x);
+			bandedRow.upper[1]	= (row + 1 < size ? getCoefWeight_p1(index, x) : 0.0);
+			bandedRow.upper[2]	= (row + 2 < size ? getCoefWeight_p2(index, x) : 0.0);
+			bandedRow.upper[3]	= 0.0;
+
+			LT_LOG << bandedRow.sub << "\t" << bandedRow.upper[0] << "\t" << bandedRow.upper[1] << "\t" << bandedRow.upper[2] << std::endl;
 			
 			// init the modified y's to the knot-point y's
 			mod_y[row] = getKnotPoint(row).y;
-			
-			LT_LOG << std::endl;
 		}
 
 		// modify 'y(1)', 'y(M-1)' and 'y(M)':
@@ -402,8 +503,21 @@ namespace FlexYCF
 				mod_y[size-2] -= getCoefficient(index+1) * getCoefWeight_p2(index-1, getKnotFromIndex(index-1));
 		}
 
-		// 3. solve using QR decomposition
-		qr_solve(A, mod_y, coefs);
+		// 3. solve using a banded LU decomposition
+		//	Note: the solver overwrites A and the modified y's, kept for the checks below
+		const vector<double> initial_mod_y(mod_y);
+		const bool checkSolve(s_checkEnabled.isOn() && size <= s_maxCheckedSize);
+		const vector<BandedRow> initialA(checkSolve ? A : vector<BandedRow>());
+		solveBandedSystem(A, mod_y, coefs);
+
+		if(checkSolve)
+		{
+			const double difference(getMaxDifferenceWithQR(initialA, initial_mod_y, coefs));
+			if(difference > 1.0e-8)
+			{
+				LT_THROW_ERROR("The banded solve of the TensionSpline coefficients differs from the QR solve by " << difference);
+			}
+		}
 		
 
 		// 4. initialize the unknown coefs of the tension spline
@@ -414,7 +528,7 @@ namespace FlexYCF
 		LT_LOG << "mod y\ty\tf(x)\tcoef" << endl;
 		for(int k(0); k < static_cast<int>(size); ++k)
 		{
-			LT_LOG <<  mod_y[k] << "\t" << getKnotPoint(k).y << "\t" << interpolate(getKnotPoint(k).x) << "\t" << m_coefficients[k] << endl;
+			LT_LOG <<  initial_mod_y[k] << "\t" << getKnotPoint(k).y << "\t" << interpolate(getKnotPoint(k).x) << "\t" << m_coefficients[k] << endl;
 		}
 	}
 
@@ -450,11 +564,10 @@ namespace FlexYCF
             return static_cast<int>(m_coefficients.size()); // does not take into account the first three extra knots
         }
 
-        size_t index;
-        for(index = 2; index < m_knotSequence.size() && t >= m_knotSequence[index]; ++index)
-            ;
+        //  first knot strictly after t, skipping the first two extra knots
+        const vector<double>::const_iterator upperBound(upper_bound(m_knotSequence.begin() + 2, m_knotSequence.end(), t));
 
-        return static_cast<int>(index) - 3;
+        return static_cast<int>(upperBound - m_knotSequence.begin()) - 3;
     }
  
     /// new function
@@ -11,6 +11,7 @@
 #define __LIBRARY_PRICERS_FLEXYCF_NEWTENSIONSPLINE_H_INCLUDED
 #pragma once
 
+#include "BuildSwitch.h"
 #include "InterpolationCurve.h"
 #include "Dictionary.h"
 
@@ -84,6 +85,16 @@ namespace FlexYCF
 
         virtual ICloneLookupPtr cloneWithLookup(CloneLookup& lookup) const;
 
+		/// Switches on or off the check of the banded solve of the coefficients
+		/// against a dense QR solve, off by default (see BuildSwitch).
+		/// Only the small knot sets are checked
+		static void setCheckEnabled(const bool enabled);
+
+		static bool isCheckEnabled()
+		{
+			return s_checkEnabled.isOn();
+		}
+
      private:
         // virtual void onKnotPointInitialized(const KnotPoint& knotPoint);
         void calculateGradient(const double x, Gradient& gradient) const; 
@@ -147,6 +158,8 @@ namespace FlexYCF
         /// simplify the loading of tension parameters from a table
         Dictionary<int, double> m_tensionDictionary;    
 
+		static BuildSwitch s_checkEnabled;
+
     private:
         TensionSpline(TensionSpline const&); // deliberately disabled as won't clone properly
     };
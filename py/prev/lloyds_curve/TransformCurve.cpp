@@ -144,6 +144,17 @@ namespace FlexYCF
         return m_transformFunction->doTransform(rawY);
     }
 
+    void TransformCurve::evaluateSorted(std::vector<double>::const_iterator xBegin,
+                                        std::vector<double>::const_iterator xEnd,
+                                        std::vector<double>::iterator yBegin) const
+    {
+        BaseCurve::evaluateSorted(xBegin, xEnd, yBegin);
+        for(const std::vector<double>::iterator yEnd(yBegin + std::distance(xBegin, xEnd)); yBegin != yEnd; ++yBegin)
+        {
+            *yBegin = m_transformFunction->doTransform(*yBegin);
+        }
+    }
+
     void TransformCurve::accumulateGradient(const double x, 
                                             double multiplier,
                                             GradientIterator gradientBegin,
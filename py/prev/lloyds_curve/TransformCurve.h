@@ -53,6 +53,9 @@ namespace FlexYCF
                                         const LeastSquaresResidualsPtr leastSquaresResiduals);
 
         virtual double evaluate(const double x) const;
+        virtual void evaluateSorted(std::vector<double>::const_iterator xBegin,
+                                    std::vector<double>::const_iterator xEnd,
+                                    std::vector<double>::iterator yBegin) const;
         virtual void accumulateGradient(const double x, double multiplier, GradientIterator gradientBegin, GradientIterator gradientEnd) const; 
 
         virtual ICloneLookupPtr cloneWithLookup(CloneLookup& lookup) const;
@@ -80,6 +80,13 @@ namespace FlexYCF
         return m_interpolationMethod->evaluate(x);
     }
 
+    void UkpCurve::interpolateSorted(std::vector<double>::const_iterator xBegin,
+                                     std::vector<double>::const_iterator xEnd,
+                                     std::vector<double>::iterator yBegin) const
+    {
+        m_interpolationMethod->evaluateSorted(xBegin, xEnd, yBegin);
+    }
+
 
     void UkpCurve::accumulateGradient(const double x, double multiplier, GradientIterator gradientBegin, GradientIterator gradientEnd) const
     {
@@ -54,6 +54,10 @@ namespace FlexYCF
 
         virtual double interpolate(const double x) const;
 
+        virtual void interpolateSorted(std::vector<double>::const_iterator xBegin,
+                                       std::vector<double>::const_iterator xEnd,
+                                       std::vector<double>::iterator yBegin) const;
+
         virtual void accumulateGradient(const double x, 
                                         double multiplier,
                                         GradientIterator gradientBegin,
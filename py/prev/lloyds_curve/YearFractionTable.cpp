@@ -0,0 +1,136 @@
+/*****************************************************************************
+
+	YearFractionTable
+
+	Implementation of the YearFractionTable
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+*****************************************************************************/
+#include "stdafx.h"
+
+//	FlexYCF
+#include "YearFractionTable.h"
+
+#include <map>
+#include <cctype>
+#include <boost/thread/mutex.hpp>
+
+using namespace std;
+
+namespace FlexYCF
+{
+	namespace
+	{
+		typedef map<string, YearFractionTableConstPtr> YearFractionTables;
+
+		YearFractionTables	s_tables;
+		boost::mutex		s_mutex;
+
+		//	The horizon of the tables, which covers the dates of the
+		//	calibration instruments and of the cash-flows priced off the curves
+		const LT::date s_origin(1980, 1, 1);
+		const LT::date s_end(2100, 1, 1);
+
+		//	The names, in upper case and without spaces, of the day counters
+		//	that count the actual days of the period over a fixed basis, or
+		//	over the days of each year (ACT/ACT ISDA), which are additive
+		const char* const s_additiveDayCounters[] =
+		{
+			"ACT/360", "ACTUAL/360", "A360",
+			"ACT/364", "ACTUAL/364", "A364",
+			"ACT/365", "ACTUAL/365", "A365",
+			"ACT/365F", "ACTUAL/365F", "A365F", "ACT/365FIXED", "ACTUAL/365FIXED",
+			"ACT/365.25", "ACTUAL/365.25",
+			"ACT/ACTISDA", "ACTUAL/ACTUALISDA"
+		};
+	}
+
+	YearFractionTableConstPtr YearFractionTable::get(const ModuleDate::DayCounterConstPtr& dayCounter)
+	{
+		const string name(dayCounter->getName());
+		if(!isAdditive(name))
+		{
+			return YearFractionTableConstPtr();
+		}
+
+		{
+			boost::mutex::scoped_lock lock(s_mutex);
+			const YearFractionTables::const_iterator table(s_tables.find(name));
+			if(table != s_tables.end())
+			{
+				return table->second;
+			}
+		}
+
+		//	Build outside the lock: if another thread registered the same
+		//	day counter in the meantime, its table is kept
+		const YearFractionTableConstPtr table(new YearFractionTable(dayCounter));
+
+		boost::mutex::scoped_lock lock(s_mutex);
+		return s_tables.insert(YearFractionTables::value_type(name, table)).first->second;
+	}
+
+	bool YearFractionTable::isAdditive(const string& dayCounterName)
+	{
+		string name;
+		for(string::const_iterator character(dayCounterName.begin()); character != dayCounterName.end(); ++character)
+		{
+			if(!isspace(static_cast<unsigned char>(*character)))
+			{
+				name.push_back(static_cast<char>(toupper(static_cast<unsigned char>(*character))));
+			}
+		}
+
+		const char* const* const end(s_additiveDayCounters + sizeof(s_additiveDayCounters) / sizeof(s_additiveDayCounters[0]));
+		for(const char* const* additiveDayCounter(s_additiveDayCounters); additiveDayCounter != end; ++additiveDayCounter)
+		{
+			if(name == *additiveDayCounter)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	double YearFractionTable::getDaysOverBasis(const ModuleDate::DayCounterConstPtr& dayCounter,
+											   const LT::date startDate,
+											   const LT::date endDate)
+	{
+		return getDaysOverBasis(get(dayCounter).get(), dayCounter, startDate, endDate);
+	}
+
+	void YearFractionTable::getDaysOverBasis(const ModuleDate::DayCounterConstPtr& dayCounter,
+											 const ModuleDate::Schedule::ScheduleEvents& periods,
+											 vector<double>& coverages)
+	{
+		getDaysOverBasis(get(dayCounter).get(), dayCounter, periods, coverages);
+	}
+
+	void YearFractionTable::getDaysOverBasis(const YearFractionTable* const table,
+											 const ModuleDate::DayCounterConstPtr& dayCounter,
+											 const ModuleDate::Schedule::ScheduleEvents& periods,
+											 vector<double>& coverages)
+	{
+		coverages.clear();
+		coverages.reserve(periods.size());
+		for(ModuleDate::Schedule::ScheduleEvents::const_iterator period(periods.begin()); period != periods.end(); ++period)
+		{
+			coverages.push_back(getDaysOverBasis(table, dayCounter, period->begin(), period->end()));
+		}
+	}
+
+	YearFractionTable::YearFractionTable(const ModuleDate::DayCounterConstPtr& dayCounter):
+		m_name(dayCounter->getName()),
+		m_origin(s_origin),
+		m_end(s_end)
+	{
+		const long numberOfDays((m_end - m_origin).days());
+		m_cumulatedYearFractions.reserve(numberOfDays + 1);
+		for(long day(0); day <= numberOfDays; ++day)
+		{
+			m_cumulatedYearFractions.push_back(dayCounter->getDaysOverBasis(m_origin, m_origin + day));
+		}
+	}
+}
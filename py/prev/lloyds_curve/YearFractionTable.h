@@ -0,0 +1,114 @@
+/*****************************************************************************
+
+    YearFractionTable
+
+	Dense tables of the cumulated year fractions of the day counters, from
+	which the coverage of any period is the difference of two entries.
+
+    @Originator
+
+    Copyright (C) Lloyds TSB Group plc 2007-08 All Rights Reserved
+
+*****************************************************************************/
+#ifndef __LIBRARY_PRICERS_FLEXYCF_YEARFRACTIONTABLE_H_INCLUDED
+#define __LIBRARY_PRICERS_FLEXYCF_YEARFRACTIONTABLE_H_INCLUDED
+#pragma once
+
+#include "LTQuantInitial.h"
+#include "ModuleDate/InternalInterface/DayCounter.h"
+#include "ModuleDate/InternalInterface/ScheduleGenerator.h"
+
+
+namespace FlexYCF
+{
+	FWD_DECLARE_SMART_PTRS( YearFractionTable )
+
+	/// YearFractionTable holds, for each day of a fixed horizon, the year
+	/// fraction of a day counter from the origin of the horizon to that day.
+	/// The coverage of a period within the horizon is then the difference
+	/// of two entries, instead of a call to the day counter.
+	///
+	/// This only holds for the additive day counters, where the year fraction
+	/// of a period is the sum of the year fractions of its sub-periods. Only
+	/// the day counters of an explicit list (the ACT/360, ACT/365 and ACT/365F
+	/// family, see isAdditive) get a table. The others, whose coverage depends
+	/// on the period itself (30/360, ACT/ACT ICMA, ...) or on a calendar
+	/// (BUS/252), have their coverages computed by the day counter. As the
+	/// listed day counters depend on nothing but their name, the tables are
+	/// keyed by name.
+	///
+	/// The tables are immutable and shared by all the threads: each day
+	/// counter's table is built on its first request, under a lock.
+	class YearFractionTable
+	{
+	public:
+		/// Returns the table of the day counter, or null if its coverages
+		/// cannot be tabulated
+		static YearFractionTableConstPtr get(const ModuleDate::DayCounterConstPtr& dayCounter);
+
+		/// Returns true if the day counter of the specified name is additive
+		static bool isAdditive(const std::string& dayCounterName);
+
+		/// Returns the coverage of the period, from the table of the day counter
+		/// when it has one and the period is in its horizon
+		static double getDaysOverBasis(const ModuleDate::DayCounterConstPtr& dayCounter,
+									   const LT::date startDate,
+									   const LT::date endDate);
+
+		/// Fills the coverages of the periods of the schedule, from the table
+		/// of the day counter when it has one
+		static void getDaysOverBasis(const ModuleDate::DayCounterConstPtr& dayCounter,
+									 const ModuleDate::Schedule::ScheduleEvents& periods,
+									 std::vector<double>& coverages);
+
+		/// As above, from the specified table of the day counter, if any,
+		/// to look up many coverages without getting the table each time
+		static double getDaysOverBasis(const YearFractionTable* const table,
+									   const ModuleDate::DayCounterConstPtr& dayCounter,
+									   const LT::date startDate,
+									   const LT::date endDate)
+		{
+			return table && table->covers(startDate, endDate)
+				? table->getDaysOverBasis(startDate, endDate)
+				: dayCounter->getDaysOverBasis(startDate, endDate);
+		}
+
+		static void getDaysOverBasis(const YearFractionTable* const table,
+									 const ModuleDate::DayCounterConstPtr& dayCounter,
+									 const ModuleDate::Schedule::ScheduleEvents& periods,
+									 std::vector<double>& coverages);
+
+		/// Returns true if the period is in the horizon of the table
+		bool covers(const LT::date startDate, const LT::date endDate) const
+		{
+			return startDate >= m_origin && endDate >= m_origin
+				&& startDate <= m_end && endDate <= m_end;
+		}
+
+		/// Returns the coverage of a period in the horizon of the table
+		double getDaysOverBasis(const LT::date startDate, const LT::date endDate) const
+		{
+			return m_cumulatedYearFractions[(endDate - m_origin).days()] 
+				 - m_cumulatedYearFractions[(startDate - m_origin).days()];
+		}
+
+		/// Returns the name of the day counter of the table
+		const std::string& getName() const
+		{
+			return m_name;
+		}
+
+	private:
+		explicit YearFractionTable(const ModuleDate::DayCounterConstPtr& dayCounter);
+
+		std::string						m_name;
+		LT::date						m_origin;
+		LT::date						m_end;
+		std::vector<double>				m_cumulatedYearFractions;
+	};	//	YearFractionTable
+
+	DECLARE_SMART_PTRS( YearFractionTable )
+
+}   //  FlexYCF
+
+#endif //__LIBRARY_PRICERS_FLEXYCF_YEARFRACTIONTABLE_H_INCLUDED